@@ -9,9 +9,12 @@ RESOURCES += resources/icons.qrc
 # Input
 HEADERS += src/DataStructures/GSnp.h \
     src/DataStructures/GReference.h \
+    src/DataStructures/GReferenceDictionary.h \
     src/DataStructures/GGenomicDataSet.h \
+    src/DataStructures/GGenotypeMatrix.h \
     src/DataStructures/GGenomicDataRegion.h \
     src/DataStructures/GGene.h \
+    src/DataStructures/GFeatureName.h \
     src/DataStructures/GFileInfo.h \
     src/DataStructures/GFileFormatData.h \
     src/DataStructures/GColorScheme.h \
@@ -24,6 +27,7 @@ HEADERS += src/DataStructures/GSnp.h \
     src/SessionManager/DataManager/GMismatchCalculator.h \
     src/SessionManager/DataManager/GGenomicDataPadder.h \
     src/SessionManager/DataManager/GDataManager.h \
+    src/SessionManager/DataManager/GRegionCache.h \
     src/SessionManager/FileManager/GOpenFilesWidget.h \
     src/SessionManager/FileManager/GFilenameDialog.h \
     src/SessionManager/FileManager/GFileManager.h \
@@ -38,10 +42,17 @@ HEADERS += src/DataStructures/GSnp.h \
     src/Utilities/flickcharm.h \
     src/Viewer/AssemblyView/GVisibleSnpItem.h \
     src/Viewer/AssemblyView/GVisibleGeneItem.h \
+    src/Viewer/AssemblyView/GVisibleGenotypeItem.h \
     src/Viewer/AssemblyView/GVisibleCursorItem.h \
     src/Viewer/AssemblyView/GVisibleAlignmentItem.h \
     src/Viewer/AssemblyView/GVisibleAlignmentGroupHeader.h \
     src/Viewer/AssemblyView/GVisibleAlignmentGroup.h \
+    src/Viewer/AssemblyView/GVisiblePackedAlignments.h \
+    src/Viewer/AssemblyView/GVisibleSequenceItem.h \
+    src/Viewer/AssemblyView/GVisibleRulerItem.h \
+    src/Viewer/AssemblyView/GGlyphAtlas.h \
+    src/Viewer/AssemblyView/GTileCache.h \
+    src/Viewer/AssemblyView/GFrameScheduler.h \
     src/Viewer/AssemblyView/GAssemblyView.h \
     src/Viewer/AssemblyView/GAssemblyToolbar.h \
     src/Viewer/AssemblyView/GAssemblySettingsManager.h \
@@ -60,6 +71,7 @@ SOURCES += src/DataStructures/GFileInfo.cpp \
     src/SessionManager/DataManager/GMismatchCalculator.cpp \
     src/SessionManager/DataManager/GGenomicDataPadder.cpp \
     src/SessionManager/DataManager/GDataManager.cpp \
+    src/SessionManager/DataManager/GRegionCache.cpp \
     src/SessionManager/FileManager/GOpenFilesWidget.cpp \
     src/SessionManager/FileManager/GFilenameDialog.cpp \
     src/SessionManager/FileManager/GFileManager.cpp \
@@ -73,10 +85,17 @@ SOURCES += src/DataStructures/GFileInfo.cpp \
     src/Utilities/flickcharm.cpp \
     src/Viewer/AssemblyView/GVisibleSnpItem.cpp \
     src/Viewer/AssemblyView/GVisibleGeneItem.cpp \
+    src/Viewer/AssemblyView/GVisibleGenotypeItem.cpp \
     src/Viewer/AssemblyView/GVisibleCursorItem.cpp \
     src/Viewer/AssemblyView/GVisibleAlignmentItem.cpp \
     src/Viewer/AssemblyView/GVisibleAlignmentGroupHeader.cpp \
     src/Viewer/AssemblyView/GVisibleAlignmentGroup.cpp \
+    src/Viewer/AssemblyView/GVisiblePackedAlignments.cpp \
+    src/Viewer/AssemblyView/GVisibleSequenceItem.cpp \
+    src/Viewer/AssemblyView/GVisibleRulerItem.cpp \
+    src/Viewer/AssemblyView/GGlyphAtlas.cpp \
+    src/Viewer/AssemblyView/GTileCache.cpp \
+    src/Viewer/AssemblyView/GFrameScheduler.cpp \
     src/Viewer/AssemblyView/GAssemblyView.cpp \
     src/Viewer/AssemblyView/GAssemblyToolbar.cpp \
     src/Viewer/AssemblyView/GAssemblySettingsManager.cpp \
@@ -63,6 +63,7 @@ struct GAlignment {
     bool    IsReverseComplement;
     QString ReadGroup;
     GAlignmentOptions Flags;
+    QString SourceFilename;     // file alignment was loaded from
 
     // assembly data
     QList<qint32>        Mismatches;
@@ -156,6 +157,15 @@ bool AlleleAt(GAllele& allele, const GAlignment& alignment, qint32 genomicPositi
     return false;
 }
 
+// returns key identifying alignment across separate loads (same record from same file)
+inline
+const QString AlignmentKey(const GAlignment& alignment) {
+    return QString("%1:%2:%3:%4").arg(alignment.SourceFilename)
+                                 .arg(alignment.Name)
+                                 .arg(alignment.Position)
+                                 .arg((int)alignment.Flags);
+}
+
 } // end namespace Gambit
 
 // declares global operator|() functions for AlignmentFlags
@@ -0,0 +1,55 @@
+// ***************************************************************************
+// GFeatureName.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a named feature (gene, SNP) found by name search.
+// ***************************************************************************
+
+#ifndef G_FEATURENAME_H
+#define G_FEATURENAME_H
+
+#include <QList>
+#include <QString>
+
+namespace Gambit {
+
+struct GFeatureName {
+
+    // data members
+    QString Name;
+    QString RefName;
+    qint32  Start;
+    qint32  Stop;
+
+    // constructors
+    GFeatureName(void)
+        : Name("")
+        , RefName("")
+        , Start(0)
+        , Stop(0)
+    { }
+};
+
+// typedefs
+typedef QList<GFeatureName> GFeatureNameList;
+
+} // namespace Gambit
+
+#endif // G_FEATURENAME_H
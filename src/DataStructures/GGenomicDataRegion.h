@@ -36,16 +36,19 @@ struct GGenomicDataRegion {
     QString RefName;
     qint32  LeftBound;
     qint32  RightBound;
+    qint32  RefId;      // session reference ID (see GReferenceDictionary), -1 if not yet resolved
 
     // constructor
     // default left/right bound are 1 because Gambit is all 1-based
     // 0-based formats are converted in their respective format readers
     GGenomicDataRegion(const QString& name  = QString(),
                        const qint32&  left  = 1,
-                       const qint32&  right = 1)
+                       const qint32&  right = 1,
+                       const qint32&  refId = -1)
         : RefName(name)
         , LeftBound(left)
         , RightBound(right)
+        , RefId(refId)
     { }
 };
 
@@ -31,6 +31,7 @@
 #include "DataStructures/GAlignment.h"
 #include "DataStructures/GGene.h"
 #include "DataStructures/GGenomicDataRegion.h"
+#include "DataStructures/GGenotypeMatrix.h"
 #include "DataStructures/GReference.h"
 #include "DataStructures/GSnp.h"
 
@@ -45,10 +46,11 @@ struct GGenomicDataSet {
     GGenomicDataRegion Region;
 
     // 'raw' data
-    GAlignmentList Alignments;
-    GGeneList      Genes;
-    QString        Sequence;
-    GSnpList       Snps;
+    GAlignmentList  Alignments;
+    GGeneList       Genes;
+    QString         Sequence;
+    GSnpList        Snps;
+    GGenotypeMatrix Genotypes;
 
     // reference meta-data
     GReferenceList References;
@@ -0,0 +1,120 @@
+// ***************************************************************************
+// GGenotypeMatrix.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes multi-sample genotype data for a set of variant sites.
+// Calls are bit-packed (2 bits per sample), with each site's calls stored as one
+// contiguous column of words.
+// ***************************************************************************
+
+#ifndef G_GENOTYPEMATRIX_H
+#define G_GENOTYPEMATRIX_H
+
+#include <QStringList>
+#include <QVector>
+
+namespace Gambit {
+
+struct GGenotypeMatrix {
+
+    // genotype call values (2 bits each)
+    enum Genotype { HomRef  = 0
+                  , Het     = 1
+                  , HomAlt  = 2
+                  , Missing = 3
+    };
+
+    // data members
+    QStringList      SampleNames;
+    QVector<qint32>  Positions;     // site positions (1-based), one per column
+    QVector<quint32> Calls;         // packed calls, column-major by site
+    int              WordsPerSite;
+
+    // constructor
+    GGenotypeMatrix(void)
+        : WordsPerSite(0)
+    { }
+
+    // sets sample names & clears any existing sites
+    void SetSamples(const QStringList& names) {
+        SampleNames  = names;
+        WordsPerSite = (names.size() + CALLS_PER_WORD - 1) / CALLS_PER_WORD;
+        Positions.clear();
+        Calls.clear();
+    }
+
+    // appends new site (all calls initially hom-ref), returns its index
+    int AppendSite(qint32 position) {
+        Positions.append(position);
+        Calls.insert(Calls.size(), WordsPerSite, 0);
+        return Positions.size() - 1;
+    }
+
+    // returns pointer to packed calls for site (for bulk filling)
+    quint32* SiteCalls(int site) { return Calls.data() + (site * WordsPerSite); }
+    const quint32* SiteCalls(int site) const { return Calls.constData() + (site * WordsPerSite); }
+
+    // single-call access
+    Genotype At(int site, int sample) const {
+        const quint32 word = SiteCalls(site)[sample / CALLS_PER_WORD];
+        return (Genotype)( (word >> ((sample % CALLS_PER_WORD) * 2)) & 0x3 );
+    }
+
+    void Set(int site, int sample, Genotype genotype) {
+        quint32& word = SiteCalls(site)[sample / CALLS_PER_WORD];
+        const int shift = (sample % CALLS_PER_WORD) * 2;
+        word = (word & ~(0x3u << shift)) | ((quint32)genotype << shift);
+    }
+
+    // returns ALT allele count (het = 1, hom-alt = 2) for each sample, over all sites
+    QVector<qint32> AlleleCounts(void) const {
+        QVector<qint32> counts(SampleNames.size());
+        counts.fill(0);
+        const int numSamples = SampleNames.size();
+        for ( int site = 0; site < Positions.size(); ++site ) {
+            const quint32* words = SiteCalls(site);
+            for ( int w = 0; w < WordsPerSite; ++w ) {
+
+                // skip words with only hom-ref calls
+                quint32 word = words[w];
+                if ( word == 0 ) { continue; }
+
+                // missing (0x3) calls don't count
+                int sample = w * CALLS_PER_WORD;
+                for ( ; (word != 0) && (sample < numSamples); word >>= 2, ++sample ) {
+                    const quint32 call = (word & 0x3);
+                    if ( call != (quint32)Missing ) { counts[sample] += (qint32)call; }
+                }
+            }
+        }
+        return counts;
+    }
+
+    // general info
+    bool IsEmpty(void) const     { return Positions.isEmpty() || SampleNames.isEmpty(); }
+    int  SampleCount(void) const { return SampleNames.size(); }
+    int  SiteCount(void) const   { return Positions.size(); }
+
+    static const int CALLS_PER_WORD = 16;
+};
+
+} // namespace Gambit
+
+#endif // G_GENOTYPEMATRIX_H
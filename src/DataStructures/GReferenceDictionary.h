@@ -0,0 +1,194 @@
+// ***************************************************************************
+// GReferenceDictionary.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Maps reference names (and common aliases, e.g. chr1 / 1 / NC_000001) to dense
+// integer IDs. The session holds one dictionary for the current reference list
+// (regions carry its IDs), and each file reader resolves those IDs to its own
+// references once, so data requests compare integers rather than names.
+// ***************************************************************************
+
+#ifndef G_REFERENCEDICTIONARY_H
+#define G_REFERENCEDICTIONARY_H
+
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+#include "DataStructures/GGenomicDataRegion.h"
+
+namespace Gambit {
+
+class GReferenceDictionary {
+
+    // constructor
+    public:
+        GReferenceDictionary(void)
+            : m_generation(0)
+        { }
+
+    // building dictionary
+    public:
+        // adds reference name (if new), returns its ID
+        qint32 Add(const QString& name) {
+            QHash<QString, qint32>::const_iterator nameIter = m_nameLookup.constFind(name);
+            if ( nameIter != m_nameLookup.constEnd() ) { return nameIter.value(); }
+            const qint32 id = m_names.size();
+            m_names.append(name);
+            m_nameLookup.insert(name, id);
+            const QString key = AliasKey(name);
+            if ( !m_aliasLookup.contains(key) ) { m_aliasLookup.insert(key, id); }
+            ++m_generation;
+            return id;
+        }
+
+        // clears all names
+        void Clear(void) {
+            m_names.clear();
+            m_nameLookup.clear();
+            m_aliasLookup.clear();
+            ++m_generation;
+        }
+
+    // lookup
+    public:
+        // returns number of references
+        int Count(void) const { return m_names.size(); }
+        // returns counter that changes whenever dictionary is modified
+        quint32 Generation(void) const { return m_generation; }
+        // returns ID for name (or any alias of it), -1 if unknown
+        qint32 Id(const QString& name) const {
+            QHash<QString, qint32>::const_iterator nameIter = m_nameLookup.constFind(name);
+            if ( nameIter != m_nameLookup.constEnd() ) { return nameIter.value(); }
+            return m_aliasLookup.value(AliasKey(name), -1);
+        }
+        // returns name for ID, empty string if unknown
+        QString Name(qint32 id) const {
+            return ( ((id >= 0) && (id < m_names.size())) ? m_names.at(id) : QString() );
+        }
+        // returns all names, in ID order
+        const QStringList& Names(void) const { return m_names; }
+        // returns (indexed by other's IDs) matching IDs in this dictionary, -1 where no match
+        QVector<qint32> MapFrom(const GReferenceDictionary& other) const {
+            QVector<qint32> ids(other.Count(), -1);
+            for ( int i = 0; i < other.Count(); ++i ) { ids[i] = Id(other.m_names.at(i)); }
+            return ids;
+        }
+
+    // alias handling
+    public:
+        // returns key shared by all aliases of a reference name
+        // (case-insensitive, UCSC 'chr' prefix dropped, RefSeq human chromosome accessions
+        //  converted to chromosome names, 'MT' same as 'M')
+        static QString AliasKey(const QString& name) {
+
+            QString key = name.trimmed().toLower();
+
+            // RefSeq accessions (version ignored)
+            if ( key.startsWith("nc_") ) {
+                const QString accession = key.section('.', 0, 0);
+                if ( accession == "nc_012920" ) { return QString("m"); }
+                if ( accession.startsWith("nc_0000") && (accession.length() == 9) ) {
+                    bool ok = false;
+                    const int number = accession.mid(7).toInt(&ok);
+                    if ( ok && (number >= 1) && (number <= 22) ) { return QString::number(number); }
+                    if ( ok && (number == 23) ) { return QString("x"); }
+                    if ( ok && (number == 24) ) { return QString("y"); }
+                }
+                return key;
+            }
+
+            // UCSC-style names
+            if ( key.startsWith("chr") && (key.length() > 3) ) { key.remove(0, 3); }
+            if ( key == "mt" ) { key = "m"; }
+            return key;
+        }
+
+    // data members
+    private:
+        QStringList            m_names;
+        QHash<QString, qint32> m_nameLookup;
+        QHash<QString, qint32> m_aliasLookup;
+        quint32                m_generation;
+};
+
+// resolves session reference IDs (carried by requested regions) to a single file's own references
+class GReferenceMapper {
+
+    // constructor
+    public:
+        GReferenceMapper(void)
+            : m_session(0)
+            , m_sessionGeneration(0)
+            , m_isMapValid(false)
+        { }
+
+    // mapper interface
+    public:
+        // sets session-wide dictionary
+        void SetSession(const GReferenceDictionary* session) {
+            QMutexLocker locker(&m_mutex);
+            m_session    = session;
+            m_isMapValid = false;
+        }
+        // sets file's own reference names, in file's ID order
+        // note - may be set from background index building, while session is changed
+        void SetFileReferences(const QStringList& names) {
+            QMutexLocker locker(&m_mutex);
+            m_file.Clear();
+            foreach ( const QString& name, names ) { m_file.Add(name); }
+            m_isMapValid = false;
+        }
+        // returns file's reference dictionary
+        const GReferenceDictionary& FileReferences(void) const { return m_file; }
+
+        // returns file's ID for region's reference, -1 if file has no such reference
+        // note - safe for concurrent queries on same file
+        qint32 FileId(const GGenomicDataRegion& region) {
+            QMutexLocker locker(&m_mutex);
+            if ( m_session && (region.RefId >= 0) ) {
+                // (re)build ID map whenever session dictionary changes
+                if ( !m_isMapValid || (m_sessionGeneration != m_session->Generation()) ) {
+                    m_sessionMap        = m_file.MapFrom(*m_session);
+                    m_sessionGeneration = m_session->Generation();
+                    m_isMapValid        = true;
+                }
+                if ( region.RefId < m_sessionMap.size() ) { return m_sessionMap.at(region.RefId); }
+            }
+            return m_file.Id(region.RefName);
+        }
+        // returns file's name for region's reference, empty string if file has no such reference
+        QString FileName(const GGenomicDataRegion& region) {
+            return m_file.Name( FileId(region) );
+        }
+
+    // data members
+    private:
+        const GReferenceDictionary* m_session;
+        GReferenceDictionary        m_file;
+        QVector<qint32>             m_sessionMap;
+        quint32                     m_sessionGeneration;
+        bool                        m_isMapValid;
+        QMutex                      m_mutex;
+};
+
+} // namespace Gambit
+
+#endif // G_REFERENCEDICTIONARY_H
@@ -178,6 +178,7 @@ void GMainWindow::CreateActions(void) {
 void GMainWindow::CreateConnections(void) {
     connect(d->api, SIGNAL(SessionActivated()),   this, SLOT(ShowViewerTab()));
     connect(d->api, SIGNAL(SessionDeactivated()), this, SLOT(ShowHomeTab()));
+    connect(d->api, SIGNAL(StatusMessage(QString)), this, SLOT(ShowStatusMessage(QString)));
 }
 
 void GMainWindow::CreateMainDisplay(void) {
@@ -369,4 +370,10 @@ void GMainWindow::ShowHomeTab(void)    { d->navigator->setCurrentIndex(GMainNavi
 void GMainWindow::ShowViewerTab(void)  { d->navigator->setCurrentIndex(GMainNavigationWidget::Viewer); }
 void GMainWindow::ShowToolkitTab(void) { d->navigator->setCurrentIndex(GMainNavigationWidget::Tools);  }
 void GMainWindow::ShowWebTab(void)     { d->navigator->setCurrentIndex(GMainNavigationWidget::Web);    }
+
+// messages are cleared after a few seconds
+void GMainWindow::ShowStatusMessage(const QString& message) {
+    const int MESSAGE_TIMEOUT = 3000;
+    d->navigator->statusBar()->showMessage(message, MESSAGE_TIMEOUT);
+}
 void GMainWindow::ShowHelpTab(void)    { d->navigator->setCurrentIndex(GMainNavigationWidget::Help);   }
@@ -58,6 +58,7 @@ class GMainWindow : public QMainWindow {
         void ShowAboutQtDialog(void);
         void ShowHelpTab(void);
         void ShowHomeTab(void);
+        void ShowStatusMessage(const QString& message);
         void ShowToolkitTab(void);
         void ShowViewerTab(void);
         void ShowWebTab(void);
@@ -61,6 +61,9 @@ void GambitAPI::ConnectModules(void)
     connect(m_sessionManager, SIGNAL(SessionDeactivated()),
             this,             SIGNAL(SessionDeactivated()));
 
+    connect(m_viewer,         SIGNAL(StatusMessage(QString)),
+            this,             SIGNAL(StatusMessage(QString)));
+
     // connect session manager <--> viewer
     connect(m_sessionManager, SIGNAL(ReferencesLoaded(GReferenceList)),
             m_viewer,         SLOT(ShowReferences(GReferenceList)));
@@ -73,6 +76,21 @@ void GambitAPI::ConnectModules(void)
 
     connect(m_sessionManager, SIGNAL(ViewerDataLoaded(GGenomicDataSet)),
             m_viewer,         SLOT(ShowAssembly(GGenomicDataSet)));
+
+    connect(m_viewer,         SIGNAL(ViewerDataExtensionRequested(GGenomicDataRegion,GGenomicDataRegion)),
+            m_sessionManager, SLOT(ExtendDataForViewer(GGenomicDataRegion,GGenomicDataRegion)));
+
+    connect(m_sessionManager, SIGNAL(ViewerDataExtended(GGenomicDataSet)),
+            m_viewer,         SLOT(ExtendAssembly(GGenomicDataSet)));
+
+    connect(m_viewer,         SIGNAL(GenotypesVisibilityChanged(bool)),
+            m_sessionManager, SLOT(SetGenotypesVisible(bool)));
+
+    connect(m_viewer,         SIGNAL(NameSearchRequested(QString)),
+            m_sessionManager, SLOT(SearchNames(QString)));
+
+    connect(m_sessionManager, SIGNAL(NamesFound(QString,GFeatureNameList)),
+            m_viewer,         SLOT(ShowNameMatches(QString,GFeatureNameList)));
 }
 
 // Gambit app & developer info
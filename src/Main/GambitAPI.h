@@ -51,6 +51,7 @@ class GambitAPI : public QObject {
     signals:
         void SessionActivated(void);
         void SessionDeactivated(void);
+        void StatusMessage(const QString& message);
 
     public slots:
 
@@ -40,8 +40,28 @@ struct GDataManager::GDataManagerPrivate {
     // pre-processing tools
     void ApplyMismatches(GGenomicDataSet& data);
     void ApplyPadding(GGenomicDataSet& data);
+
+    // incremental update tools
+    void ExtendLeft(GGenomicDataSet& data, GGenomicDataSet& delta);
+    void ExtendRight(GGenomicDataSet& data, GGenomicDataSet& delta);
+    void MergeFeatures(GGenomicDataSet& data, const GGenomicDataSet& delta, bool isLeft);
+    void MergeGenotypes(GGenotypeMatrix& genotypes, const GGenotypeMatrix& delta, bool isLeft);
+    void PadFeatures(GGenomicDataSet& data);
+    void RemoveDuplicates(const GGenomicDataSet& data, GGenomicDataSet& delta, bool isLeft);
+    void Reprocess(GGenomicDataSet& data);
 };
 
+// sort functions for merged features
+static inline
+bool GeneLessThan(const GGene& lhs, const GGene& rhs) {
+    return ( lhs.Start < rhs.Start );
+}
+
+static inline
+bool SnpLessThan(const GSnp& lhs, const GSnp& rhs) {
+    return ( lhs.Position < rhs.Position );
+}
+
 void GDataManager::GDataManagerPrivate::ApplyMismatches(GGenomicDataSet& data) {
     GMismatchCalculator mismatchCalculator;
     mismatchCalculator.Exec(data);
@@ -52,6 +72,230 @@ void GDataManager::GDataManagerPrivate::ApplyPadding(GGenomicDataSet& data) {
     padder.Exec(data);
 }
 
+void GDataManager::GDataManagerPrivate::ExtendLeft(GGenomicDataSet& data, GGenomicDataSet& delta) {
+
+    const qint32 oldLeft = data.Region.LeftBound;
+    const qint32 newLeft = delta.Region.LeftBound;
+
+    // collect new reads' insertions
+    GPaddingMap deltaPadding;
+    foreach ( const GAlignment& gAlignment, delta.Alignments ) {
+        GGenomicDataPadder::AddInsertions(gAlignment, deltaPadding);
+    }
+
+    // merge into current padding, noting pads added before old region
+    // (any change inside old region would shift its existing columns)
+    bool isOldRegionChanged = false;
+    qint32 padsAdded = 0;
+    QMap<qint32, qint32>::const_iterator padIter = deltaPadding.constBegin();
+    QMap<qint32, qint32>::const_iterator padEnd  = deltaPadding.constEnd();
+    for ( ; padIter != padEnd; ++padIter ) {
+        const qint32 existingPads = data.Padding.value(padIter.key(), 0);
+        if ( padIter.value() <= existingPads ) { continue; }
+        if ( padIter.key() >= oldLeft ) { isOldRegionChanged = true; }
+        else { padsAdded += ( padIter.value() - existingPads ); }
+        data.Padding.insert(padIter.key(), padIter.value());
+    }
+
+    // if old columns must be widened, simply re-process everything from unpadded data
+    if ( isOldRegionChanged ) {
+        data.Sequence = delta.Sequence + data.Sequence.remove('*');
+        data.Alignments = delta.Alignments + data.Alignments;
+        data.Region.LeftBound = newLeft;
+        MergeFeatures(data, delta, true);
+        Reprocess(data);
+        return;
+    }
+
+    // prepend newly padded reference
+    GGenomicDataPadder::PadSequence(delta.Sequence, newLeft, data.Padding);
+    data.Sequence.prepend(delta.Sequence);
+    data.Region.LeftBound = newLeft;
+
+    // existing reads are only shifted by new pads before them
+    for ( int i = 0; i < data.Alignments.size(); ++i ) {
+        data.Alignments[i].PadsBefore += padsAdded;
+    }
+
+    // pad & compare new reads
+    for ( int i = 0; i < delta.Alignments.size(); ++i ) {
+        GAlignment& gAlignment = delta.Alignments[i];
+        GGenomicDataPadder::PadAlignment(gAlignment, data.Padding);
+        GMismatchCalculator::CalculateMismatches(gAlignment, data.Sequence, newLeft);
+    }
+    data.Alignments = delta.Alignments + data.Alignments;
+
+    // merge remaining data
+    MergeFeatures(data, delta, true);
+}
+
+void GDataManager::GDataManagerPrivate::ExtendRight(GGenomicDataSet& data, GGenomicDataSet& delta) {
+
+    const qint32 oldRight = data.Region.RightBound;
+
+    // merge new reads' insertions into current padding, noting first column that widened
+    // (new reads start within delta region, so only columns after old region can change)
+    bool isPaddingChanged = false;
+    qint32 firstChanged = 0;
+    foreach ( const GAlignment& gAlignment, delta.Alignments ) {
+        QMap<qint32, qint32>::const_iterator insIter = gAlignment.Insertions.constBegin();
+        QMap<qint32, qint32>::const_iterator insEnd  = gAlignment.Insertions.constEnd();
+        for ( ; insIter != insEnd; ++insIter ) {
+            if ( insIter.value() <= data.Padding.value(insIter.key(), 0) ) { continue; }
+            data.Padding.insert(insIter.key(), insIter.value());
+            if ( !isPaddingChanged || insIter.key() < firstChanged ) { firstChanged = insIter.key(); }
+            isPaddingChanged = true;
+        }
+    }
+
+    // append newly padded reference
+    GGenomicDataPadder::PadSequence(delta.Sequence, delta.Region.LeftBound, data.Padding);
+    data.Sequence.append(delta.Sequence);
+    data.Region.RightBound = delta.Region.RightBound;
+
+    // existing reads that extend past old region
+    // re-pad if any column under them widened, and re-compare against extended reference
+    for ( int i = 0; i < data.Alignments.size(); ++i ) {
+        GAlignment& gAlignment = data.Alignments[i];
+        const qint32 alignmentRight = gAlignment.Position + gAlignment.Bases.length() - 1;
+        if ( alignmentRight <= oldRight ) { continue; }
+        if ( isPaddingChanged && (alignmentRight >= firstChanged) ) {
+            gAlignment.PaddedBases = gAlignment.Bases;
+            GGenomicDataPadder::PadAlignment(gAlignment, data.Padding);
+        }
+        GMismatchCalculator::CalculateMismatches(gAlignment, data.Sequence, data.Region.LeftBound);
+    }
+
+    // pad & compare new reads
+    for ( int i = 0; i < delta.Alignments.size(); ++i ) {
+        GAlignment& gAlignment = delta.Alignments[i];
+        GGenomicDataPadder::PadAlignment(gAlignment, data.Padding);
+        GMismatchCalculator::CalculateMismatches(gAlignment, data.Sequence, data.Region.LeftBound);
+    }
+    data.Alignments += delta.Alignments;
+
+    // merge remaining data
+    MergeFeatures(data, delta, false);
+}
+
+void GDataManager::GDataManagerPrivate::MergeFeatures(GGenomicDataSet& data, const GGenomicDataSet& delta, bool isLeft) {
+
+    // genes - delta may contain genes spanning both regions
+    QSet<QString> geneKeys;
+    foreach ( const GGene& gGene, data.Genes ) {
+        geneKeys.insert( gGene.Name + ':' + QString::number(gGene.Start) + ':' + QString::number(gGene.Stop) );
+    }
+    foreach ( const GGene& gGene, delta.Genes ) {
+        const QString key = gGene.Name + ':' + QString::number(gGene.Start) + ':' + QString::number(gGene.Stop);
+        if ( !geneKeys.contains(key) ) { data.Genes.append(gGene); }
+    }
+    qStableSort(data.Genes.begin(), data.Genes.end(), GeneLessThan);
+
+    // SNPs
+    QSet<QString> snpKeys;
+    foreach ( const GSnp& gSnp, data.Snps ) {
+        snpKeys.insert( gSnp.Name + ':' + QString::number(gSnp.Position) );
+    }
+    foreach ( const GSnp& gSnp, delta.Snps ) {
+        if ( !snpKeys.contains(gSnp.Name + ':' + QString::number(gSnp.Position)) ) { data.Snps.append(gSnp); }
+    }
+    qStableSort(data.Snps.begin(), data.Snps.end(), SnpLessThan);
+
+    // genotypes & reference meta-data
+    MergeGenotypes(data.Genotypes, delta.Genotypes, isLeft);
+    if ( data.References.isEmpty() ) { data.References = delta.References; }
+
+    // feature offsets depend on all padding before them
+    PadFeatures(data);
+}
+
+void GDataManager::GDataManagerPrivate::MergeGenotypes(GGenotypeMatrix& genotypes, const GGenotypeMatrix& delta, bool isLeft) {
+
+    // skip if no new sites
+    if ( delta.IsEmpty() ) { return; }
+
+    // take delta as-is if no existing sites
+    if ( genotypes.IsEmpty() ) {
+        genotypes = delta;
+        return;
+    }
+
+    // sample sets must match to merge sites
+    if ( genotypes.SampleNames != delta.SampleNames ) {
+        qDebug() << "GDataManager::ExtendData() => genotype samples differ, new sites skipped";
+        return;
+    }
+
+    // keep sites in position order, skipping any already present
+    GGenotypeMatrix merged;
+    merged.SetSamples(genotypes.SampleNames);
+    const GGenotypeMatrix& first  = ( isLeft ? delta : genotypes );
+    const GGenotypeMatrix& second = ( isLeft ? genotypes : delta );
+    for ( int site = 0; site < first.SiteCount(); ++site ) {
+        const int index = merged.AppendSite(first.Positions.at(site));
+        qCopy(first.SiteCalls(site), first.SiteCalls(site) + first.WordsPerSite, merged.SiteCalls(index));
+    }
+    const qint32 lastPosition = first.Positions.last();
+    for ( int site = 0; site < second.SiteCount(); ++site ) {
+        if ( second.Positions.at(site) <= lastPosition ) { continue; }
+        const int index = merged.AppendSite(second.Positions.at(site));
+        qCopy(second.SiteCalls(site), second.SiteCalls(site) + second.WordsPerSite, merged.SiteCalls(index));
+    }
+    genotypes = merged;
+}
+
+void GDataManager::GDataManagerPrivate::PadFeatures(GGenomicDataSet& data) {
+    for ( int i = 0; i < data.Genes.size(); ++i ) {
+        GGenomicDataPadder::PadGene(data.Genes[i], data.Padding);
+    }
+    for ( int i = 0; i < data.Snps.size(); ++i ) {
+        GGenomicDataPadder::PadSnp(data.Snps[i], data.Padding);
+    }
+}
+
+// drops delta's alignments already in data
+// note - readers return alignments starting in region, but some may also return ones overlapping it
+void GDataManager::GDataManagerPrivate::RemoveDuplicates(const GGenomicDataSet& data, GGenomicDataSet& delta, bool isLeft) {
+
+    // only existing alignments reaching into delta region can be duplicated
+    QSet<QString> keys;
+    foreach ( const GAlignment& gAlignment, data.Alignments ) {
+        const qint32 alignmentRight = gAlignment.Position + gAlignment.Bases.length() - 1;
+        const bool isOverlapping = ( isLeft ? (gAlignment.Position <= delta.Region.RightBound)
+                                            : (alignmentRight >= delta.Region.LeftBound) );
+        if ( isOverlapping ) { keys.insert( AlignmentKey(gAlignment) ); }
+    }
+    if ( keys.isEmpty() ) { return; }
+
+    // keep only new alignments
+    GAlignmentList alignments;
+    foreach ( const GAlignment& gAlignment, delta.Alignments ) {
+        if ( !keys.contains(AlignmentKey(gAlignment)) ) { alignments.append(gAlignment); }
+    }
+    delta.Alignments = alignments;
+}
+
+void GDataManager::GDataManagerPrivate::Reprocess(GGenomicDataSet& data) {
+
+    // rebuild padding from unpadded alignments
+    data.Padding.clear();
+    for ( int i = 0; i < data.Alignments.size(); ++i ) {
+        GAlignment& gAlignment = data.Alignments[i];
+        gAlignment.PaddedBases = gAlignment.Bases;
+        gAlignment.PadsBefore  = 0;
+        GGenomicDataPadder::AddInsertions(gAlignment, data.Padding);
+    }
+
+    // apply padding & compare (no progress reporting - data is already on screen)
+    GGenomicDataPadder::PadSequence(data.Sequence, data.Region.LeftBound, data.Padding);
+    for ( int i = 0; i < data.Alignments.size(); ++i ) {
+        GAlignment& gAlignment = data.Alignments[i];
+        GGenomicDataPadder::PadAlignment(gAlignment, data.Padding);
+        GMismatchCalculator::CalculateMismatches(gAlignment, data.Sequence, data.Region.LeftBound);
+    }
+    PadFeatures(data);
+}
+
 // ----------------------------------------------- //
 // GDataManager implementation
 // ----------------------------------------------- //
@@ -71,3 +315,130 @@ void GDataManager::ProcessData(GGenomicDataSet& data) {
     d->ApplyPadding(data);
     d->ApplyMismatches(data);
 }
+
+void GDataManager::ProcessDataSilently(GGenomicDataSet& data) {
+    d->Reprocess(data);
+}
+
+QString GDataManager::ProcessingKey(void) const {
+    return QString("padding,mismatches");
+}
+
+bool GDataManager::ExtendData(GGenomicDataSet& data, GGenomicDataSet& delta) {
+
+    // must be on same reference, with new reference sequence available
+    if ( (delta.Region.RefId != data.Region.RefId) || delta.Sequence.isEmpty() ) { return false; }
+
+    // new region directly after current
+    if ( delta.Region.LeftBound == (data.Region.RightBound + 1) ) {
+        d->RemoveDuplicates(data, delta, false);
+        d->ExtendRight(data, delta);
+        return true;
+    }
+
+    // new region directly before current
+    // (use sequence length, file manager trims right bound to available sequence)
+    if ( (delta.Region.LeftBound + delta.Sequence.length()) == data.Region.LeftBound ) {
+        d->RemoveDuplicates(data, delta, true);
+        d->ExtendLeft(data, delta);
+        return true;
+    }
+
+    // otherwise not adjacent
+    qDebug() << "GDataManager::ExtendData() => regions are not adjacent";
+    return false;
+}
+
+bool GDataManager::ReuseOverlap(GGenomicDataSet& data, const GGenomicDataRegion& region, QList<GGenomicDataRegion>& missing) {
+
+    missing.clear();
+
+    // must be on same (resolved) reference, with processed data available
+    if ( (region.RefId < 0) || (region.RefId != data.Region.RefId) || data.Sequence.isEmpty() ) { return false; }
+
+    // must overlap
+    if ( (region.LeftBound > data.Region.RightBound) || (region.RightBound < data.Region.LeftBound) ) { return false; }
+
+    // drop data outside region
+    TrimData(data, region.LeftBound, region.RightBound);
+
+    // parts of region not yet loaded
+    if ( region.LeftBound < data.Region.LeftBound ) {
+        missing.append( GGenomicDataRegion(region.RefName, region.LeftBound, data.Region.LeftBound - 1, region.RefId) );
+    }
+    if ( region.RightBound > data.Region.RightBound ) {
+        missing.append( GGenomicDataRegion(region.RefName, data.Region.RightBound + 1, region.RightBound, region.RefId) );
+    }
+    return true;
+}
+
+void GDataManager::TrimData(GGenomicDataSet& data, const qint32& left, const qint32& right) {
+
+    // skip if nothing to trim
+    if ( left > right ) { return; }
+    const bool isLeftTrimmed  = ( left  > data.Region.LeftBound );
+    const bool isRightTrimmed = ( right < data.Region.RightBound );
+    if ( !isLeftTrimmed && !isRightTrimmed ) { return; }
+
+    // trim left - reads starting before new bound are dropped, so padding before it can go too
+    if ( isLeftTrimmed ) {
+        qint32 padsRemoved = 0;
+        GPaddingMap::iterator padIter = data.Padding.begin();
+        while ( (padIter != data.Padding.end()) && (padIter.key() < left) ) {
+            padsRemoved += padIter.value();
+            padIter = data.Padding.erase(padIter);
+        }
+        data.Sequence.remove(0, (left - data.Region.LeftBound) + padsRemoved);
+
+        GAlignmentList kept;
+        foreach ( GAlignment gAlignment, data.Alignments ) {
+            if ( gAlignment.Position < left ) { continue; }
+            gAlignment.PadsBefore -= padsRemoved;
+            kept.append(gAlignment);
+        }
+        data.Alignments = kept;
+        data.Region.LeftBound = left;
+    }
+
+    // trim right - reads crossing new bound are kept (with their padding)
+    if ( isRightTrimmed ) {
+        qint32 padsKept = 0;
+        GPaddingMap::const_iterator padIter = data.Padding.constBegin();
+        GPaddingMap::const_iterator padEnd  = data.Padding.upperBound(right);
+        for ( ; padIter != padEnd; ++padIter ) {
+            if ( padIter.key() >= data.Region.LeftBound ) { padsKept += padIter.value(); }
+        }
+        data.Sequence.truncate( (right - data.Region.LeftBound + 1) + padsKept );
+
+        while ( !data.Alignments.isEmpty() && (data.Alignments.last().Position > right) ) {
+            data.Alignments.removeLast();
+        }
+        data.Region.RightBound = right;
+    }
+
+    // trim features
+    const qint32 leftBound  = data.Region.LeftBound;
+    const qint32 rightBound = data.Region.RightBound;
+    GGeneList genes;
+    foreach ( const GGene& gGene, data.Genes ) {
+        if ( (gGene.Stop >= leftBound) && (gGene.Start <= rightBound) ) { genes.append(gGene); }
+    }
+    data.Genes = genes;
+    GSnpList snps;
+    foreach ( const GSnp& gSnp, data.Snps ) {
+        if ( (gSnp.Position >= leftBound) && (gSnp.Position <= rightBound) ) { snps.append(gSnp); }
+    }
+    data.Snps = snps;
+    if ( !data.Genotypes.IsEmpty() ) {
+        GGenotypeMatrix genotypes;
+        genotypes.SetSamples(data.Genotypes.SampleNames);
+        for ( int site = 0; site < data.Genotypes.SiteCount(); ++site ) {
+            const qint32 position = data.Genotypes.Positions.at(site);
+            if ( (position < leftBound) || (position > rightBound) ) { continue; }
+            const int index = genotypes.AppendSite(position);
+            qCopy(data.Genotypes.SiteCalls(site), data.Genotypes.SiteCalls(site) + data.Genotypes.WordsPerSite, genotypes.SiteCalls(index));
+        }
+        data.Genotypes = genotypes;
+    }
+    d->PadFeatures(data);
+}
@@ -27,11 +27,14 @@
 #ifndef G_DATAMANAGER_H
 #define G_DATAMANAGER_H
 
+#include <QList>
 #include <QObject>
+#include <QtGlobal>
 
 namespace Gambit {
 
 class GGenomicDataSet;
+class GGenomicDataRegion;
 
 namespace Core   {
 
@@ -46,6 +49,23 @@ class GDataManager : public QObject {
     public slots:
         void ProcessData(GGenomicDataSet& data);
 
+    public:
+        // same results as ProcessData(), without progress dialogs (safe to use off GUI thread)
+        void ProcessDataSilently(GGenomicDataSet& data);
+        // identifies processing done by ProcessData() (processed data sets may be re-used while unchanged)
+        QString ProcessingKey(void) const;
+
+    // incremental updates of already-processed data
+    public:
+        // merges unprocessed data from region adjacent to data's region (delta is consumed)
+        // returns false (leaving data untouched) if regions are not adjacent
+        bool ExtendData(GGenomicDataSet& data, GGenomicDataSet& delta);
+        // discards data outside of [left, right]
+        void TrimData(GGenomicDataSet& data, const qint32& left, const qint32& right);
+        // trims data to its overlap with region, and returns parts of region still to be loaded (each adjacent to data)
+        // returns false (leaving data untouched) if region does not overlap data
+        bool ReuseOverlap(GGenomicDataSet& data, const GGenomicDataRegion& region, QList<GGenomicDataRegion>& missing);
+
     private:
         struct GDataManagerPrivate;
         GDataManagerPrivate* d;
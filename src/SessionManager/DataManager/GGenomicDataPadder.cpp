@@ -67,21 +67,27 @@ void GGenomicDataPadder::CalculatePadding(GGenomicDataSet& data) {
         // increment counter for progress dialog
         ++currentAlignmentIndex;
 
-        // iterate over all insertions on alignment
-        QMap<qint32, qint32>::const_iterator insIter = gAlignment.Insertions.constBegin();
-        QMap<qint32, qint32>::const_iterator insEnd  = gAlignment.Insertions.constEnd();
-        for ( ; insIter != insEnd; ++insIter ) {
-
-            // get insertion data
-            qint32 genomicPosition      = insIter.key();
-            qint32 insertionsAtPosition = insIter.value();
-
-            // if insertion position does not exist in the map yet OR
-            // if numInsertions at current position greater than existing value in map
-            if ( !padding.contains(genomicPosition) || ( insertionsAtPosition > padding.value(genomicPosition) ) ) {
-                // store current insertion length for each insertion position
-                padding.insert(genomicPosition, insertionsAtPosition);
-            }
+        // store alignment's insertions
+        AddInsertions(gAlignment, padding);
+    }
+}
+
+void GGenomicDataPadder::AddInsertions(const GAlignment& alignment, GPaddingMap& padding) {
+
+    // iterate over all insertions on alignment
+    QMap<qint32, qint32>::const_iterator insIter = alignment.Insertions.constBegin();
+    QMap<qint32, qint32>::const_iterator insEnd  = alignment.Insertions.constEnd();
+    for ( ; insIter != insEnd; ++insIter ) {
+
+        // get insertion data
+        qint32 genomicPosition      = insIter.key();
+        qint32 insertionsAtPosition = insIter.value();
+
+        // if insertion position does not exist in the map yet OR
+        // if numInsertions at current position greater than existing value in map
+        if ( !padding.contains(genomicPosition) || ( insertionsAtPosition > padding.value(genomicPosition) ) ) {
+            // store current insertion length for each insertion position
+            padding.insert(genomicPosition, insertionsAtPosition);
         }
     }
 }
@@ -124,63 +130,69 @@ void GGenomicDataPadder::ApplyPaddingToAlignments(GGenomicDataSet& data) {
         // update counter for progress dialog
         ++currentAlignmentIndex;
 
-        // alignment coordinates/counters
-        qint32 alignmentLeft  = gAlignment.Position;
-        qint32 alignmentRight = alignmentLeft + gAlignment.Bases.length() - 1;
-        qint32 positionInAlignment = 0;
-        qint32 padsBeforeCurrentPosition = 0;
-        qint32 padsBeforeAlignmentStart  = 0;
-
-        // iterate over padding locations
-        QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
-        QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
-        for ( ; padIter != padEnd; ++padIter ) {
-
-            // get padding data
-            qint32 genomicPosition   = padIter.key();
-            qint32 maxPadsAtPosition = padIter.value();
-
-            // if before alignment begin, store number of pads (used later in GAssemblyView to adjust drawing coordinates )
-            if ( genomicPosition < alignmentLeft ) {
-                padsBeforeAlignmentStart += maxPadsAtPosition;
-            }
+        // pad alignment
+        PadAlignment(gAlignment, padding);
+    }
+}
 
-            else if ( positionInAlignment >= gAlignment.PaddedBases.length() ) {
-                ; // skip this position
-            }
+void GGenomicDataPadder::PadAlignment(GAlignment& alignment, const GPaddingMap& padding) {
+
+    // alignment coordinates/counters
+    qint32 alignmentLeft  = alignment.Position;
+    qint32 alignmentRight = alignmentLeft + alignment.Bases.length() - 1;
+    qint32 positionInAlignment = 0;
+    qint32 padsBeforeCurrentPosition = 0;
+    qint32 padsBeforeAlignmentStart  = 0;
+
+    // iterate over padding locations
+    QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
+    QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
+    for ( ; padIter != padEnd; ++padIter ) {
 
-            else {
+        // get padding data
+        qint32 genomicPosition   = padIter.key();
+        qint32 maxPadsAtPosition = padIter.value();
 
-                // if within alignment range
-                if ( genomicPosition <= alignmentRight) {
+        // if before alignment begin, store number of pads (used later in GAssemblyView to adjust drawing coordinates )
+        if ( genomicPosition < alignmentLeft ) {
+            padsBeforeAlignmentStart += maxPadsAtPosition;
+        }
 
-                    qint32 padsToInsert = maxPadsAtPosition;
+        else if ( positionInAlignment >= alignment.PaddedBases.length() ) {
+            ; // skip this position
+        }
 
-                    // if alignment already contains an insertion at this position
-                    if ( gAlignment.Insertions.contains(genomicPosition) ) {
+        else {
 
-                        // subtract insertions in this read from max from all reads
-                        padsToInsert -= gAlignment.Insertions.value(genomicPosition);
-                    }
+            // if within alignment range
+            if ( genomicPosition <= alignmentRight) {
 
-                    // adjust genomic position to position in alignment sequence, shift by pads inserted before this round
-                    positionInAlignment = (genomicPosition - alignmentLeft) + padsBeforeCurrentPosition;
+                qint32 padsToInsert = maxPadsAtPosition;
 
-                    // insert padding at position
-                    gAlignment.PaddedBases = gAlignment.PaddedBases.insert(positionInAlignment, QString(padsToInsert, '*') );
+                // if alignment already contains an insertion at this position
+                if ( alignment.Insertions.contains(genomicPosition) ) {
 
-                    // update padding counter for this read
-                    padsBeforeCurrentPosition += maxPadsAtPosition;
+                    // subtract insertions in this read from max from all reads
+                    padsToInsert -= alignment.Insertions.value(genomicPosition);
                 }
 
-                // beyond alignment end, stop processing
-                else { break; }
+                // adjust genomic position to position in alignment sequence, shift by pads inserted before this round
+                positionInAlignment = (genomicPosition - alignmentLeft) + padsBeforeCurrentPosition;
+
+                // insert padding at position
+                alignment.PaddedBases = alignment.PaddedBases.insert(positionInAlignment, QString(padsToInsert, '*') );
+
+                // update padding counter for this read
+                padsBeforeCurrentPosition += maxPadsAtPosition;
             }
-        }
 
-        // save number of pads before alignment (GAssemblyView will use this to adjust drawing coordinates)
-        gAlignment.PadsBefore = padsBeforeAlignmentStart;
+            // beyond alignment end, stop processing
+            else { break; }
+        }
     }
+
+    // save number of pads before alignment (GAssemblyView will use this to adjust drawing coordinates)
+    alignment.PadsBefore = padsBeforeAlignmentStart;
 }
 
 void GGenomicDataPadder::ApplyPaddingToGenes(GGenomicDataSet& data) {
@@ -214,36 +226,44 @@ void GGenomicDataPadder::ApplyPaddingToGenes(GGenomicDataSet& data) {
         // update counter for progress dialog
         ++currentGeneIndex;
 
-        // gene coordinates/counters
-        qint32 geneStart = gGene.Start;
-        qint32 geneStop  = gGene.Stop;
+        // pad gene
+        PadGene(gGene, padding);
+    }
+}
 
-        // iterate over padding locations
-        QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
-        QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
-        for ( ; padIter != padEnd; ++padIter ) {
+void GGenomicDataPadder::PadGene(GGene& gene, const GPaddingMap& padding) {
 
-            // get padding data
-            qint32 genomicPosition = padIter.key();
-            qint32 padsAtPosition  = padIter.value();
+    // gene coordinates/counters
+    qint32 geneStart = gene.Start;
+    qint32 geneStop  = gene.Stop;
+    gene.StartOffset = 0;
+    gene.StopOffset  = 0;
 
-            // if before gene begin, store number of pads (used later by GAssemblyView to adjust drawing coordinates )
-            if ( genomicPosition < geneStart ) {
-                gGene.StartOffset += padsAtPosition;
-            }
+    // iterate over padding locations
+    QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
+    QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
+    for ( ; padIter != padEnd; ++padIter ) {
 
-            else {
+        // get padding data
+        qint32 genomicPosition = padIter.key();
+        qint32 padsAtPosition  = padIter.value();
 
-                // if within range
-                if ( genomicPosition <= geneStop) {
+        // if before gene begin, store number of pads (used later by GAssemblyView to adjust drawing coordinates )
+        if ( genomicPosition < geneStart ) {
+            gene.StartOffset += padsAtPosition;
+        }
 
-                    // update padding counter for this gene
-                    gGene.StopOffset += padsAtPosition;
-                }
+        else {
 
-                // beyond gene end, stop processing
-                else { break; }
+            // if within range
+            if ( genomicPosition <= geneStop) {
+
+                // update padding counter for this gene
+                gene.StopOffset += padsAtPosition;
             }
+
+            // beyond gene end, stop processing
+            else { break; }
         }
     }
 }
@@ -303,6 +323,26 @@ void GGenomicDataPadder::ApplyPaddingToSequence(GGenomicDataSet& data) {
     }
 }
 
+void GGenomicDataPadder::PadSequence(QString& sequence, const qint32& leftBound, const GPaddingMap& padding) {
+
+    // keep track of pads inserted before current position
+    qint32 padsBeforeCurrentPosition = 0;
+
+    // iterate over padding locations within sequence
+    QMap<qint32, qint32>::const_iterator padIter = padding.lowerBound(leftBound);
+    QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
+    for ( ; padIter != padEnd; ++padIter ) {
+
+        // adjust genomic position for selected range, then shift to account for previously inserted padding char's
+        int positionInSequence = ( padIter.key() - leftBound ) + padsBeforeCurrentPosition;
+        if ( positionInSequence >= sequence.length() ) { return; }
+
+        // insert padding at position
+        sequence.insert( positionInSequence, QString(padIter.value(), '*') );
+        padsBeforeCurrentPosition += padIter.value();
+    }
+}
+
 void GGenomicDataPadder::ApplyPaddingToSnps(GGenomicDataSet& data) {
 
     // get snp data, skip if empty
@@ -334,22 +374,29 @@ void GGenomicDataPadder::ApplyPaddingToSnps(GGenomicDataSet& data) {
         // update counter for progress dialog
         ++currentSnpIndex;
 
-        // SNP position
-        qint32 snpPosition = gSnp.Position;
+        // pad SNP
+        PadSnp(gSnp, padding);
+    }
+}
+
+void GGenomicDataPadder::PadSnp(GSnp& snp, const GPaddingMap& padding) {
 
-        // iterate over padding locations
-        QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
-        QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
-        for ( ; padIter != padEnd; ++padIter ) {
+    // SNP position
+    qint32 snpPosition = snp.Position;
+    snp.PaddingOffset = 0;
 
-            // get padding data
-            qint32 genomicPosition = padIter.key();
-            qint32 padsAtPosition  = padIter.value();
+    // iterate over padding locations
+    QMap<qint32, qint32>::const_iterator padIter = padding.constBegin();
+    QMap<qint32, qint32>::const_iterator padEnd  = padding.constEnd();
+    for ( ; padIter != padEnd; ++padIter ) {
 
-            // if before SNP position, store number of pads (used later by GAssemblyView to adjust drawing coordinates )
-            if ( genomicPosition <= snpPosition ) {
-                gSnp.PaddingOffset += padsAtPosition;
-            } else { break; }
-        }
+        // get padding data
+        qint32 genomicPosition = padIter.key();
+        qint32 padsAtPosition  = padIter.value();
+
+        // if before SNP position, store number of pads (used later by GAssemblyView to adjust drawing coordinates )
+        if ( genomicPosition <= snpPosition ) {
+            snp.PaddingOffset += padsAtPosition;
+        } else { break; }
     }
 }
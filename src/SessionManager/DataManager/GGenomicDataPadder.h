@@ -27,11 +27,10 @@
 #define G_GENOMICDATAPADDER_H
 
 #include <QObject>
+#include "DataStructures/GGenomicDataSet.h"
 
 namespace Gambit {
 
-class GGenomicDataSet;
-
 class GGenomicDataPadder : public QObject {
 
     Q_OBJECT
@@ -44,6 +43,16 @@ class GGenomicDataPadder : public QObject {
     public slots:
         void Exec(GGenomicDataSet& data);
 
+    // single-item padding (no progress reporting), also used for incremental updates
+    public:
+        static void AddInsertions(const GAlignment& alignment, GPaddingMap& padding);
+        // note - alignment's PaddedBases must not be padded yet
+        static void PadAlignment(GAlignment& alignment, const GPaddingMap& padding);
+        static void PadGene(GGene& gene, const GPaddingMap& padding);
+        static void PadSnp(GSnp& snp, const GPaddingMap& padding);
+        // note - sequence must not be padded yet
+        static void PadSequence(QString& sequence, const qint32& leftBound, const GPaddingMap& padding);
+
     // internal methods
     private:
         void CalculatePadding(GGenomicDataSet& data);
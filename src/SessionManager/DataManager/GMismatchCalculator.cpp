@@ -41,24 +41,31 @@ void GMismatchCalculator::Exec(GGenomicDataSet& data) {
 
     // iterate over all alignments
     for ( int index = 0; index < data.Alignments.size(); ++index ) {
-        GAlignment& gAlignment = data.Alignments[index];
+        CalculateMismatches(data.Alignments[index], reference, data.Region.LeftBound);
+    }
+}
 
-        // get alignment sequence info
-        QString bases = gAlignment.PaddedBases;
-        int baseLength = bases.length();
-        qint32 alignmentStart = (gAlignment.Position + gAlignment.PadsBefore - data.Region.LeftBound);
+void GMismatchCalculator::CalculateMismatches(GAlignment& alignment, const QString& reference, const qint32& leftBound) {
 
-        // get reference sequence info
-        QString refRegion = reference.mid(alignmentStart, baseLength);
-        if (refRegion.length() < baseLength) {
-            baseLength = refRegion.length();
-        }
+    // clear any previous results
+    alignment.Mismatches.clear();
+
+    // get alignment sequence info
+    const QString& bases = alignment.PaddedBases;
+    int baseLength = bases.length();
+    qint32 alignmentStart = (alignment.Position + alignment.PadsBefore - leftBound);
+    if ( alignmentStart < 0 ) { return; }
+
+    // get reference sequence info
+    QString refRegion = reference.mid(alignmentStart, baseLength);
+    if (refRegion.length() < baseLength) {
+        baseLength = refRegion.length();
+    }
 
-        // compare bases
-        for ( int index = 0; index < baseLength; ++index ) {
-            if ( refRegion.at(index) != bases.at(index) ) {
-                gAlignment.Mismatches.append(index);
-            }
+    // compare bases
+    for ( int index = 0; index < baseLength; ++index ) {
+        if ( refRegion.at(index) != bases.at(index) ) {
+            alignment.Mismatches.append(index);
         }
     }
 }
@@ -27,6 +27,7 @@
 #define G_MISMATCHCALCULATOR_H
 
 #include <QObject>
+#include "DataStructures/GAlignment.h"
 
 namespace Gambit {
 
@@ -43,6 +44,11 @@ class GMismatchCalculator : public QObject {
     // tool interface
     public slots:
         void Exec(GGenomicDataSet& data);
+
+    // single-alignment comparison, also used for incremental updates
+    public:
+        // note - replaces any existing mismatch data on alignment
+        static void CalculateMismatches(GAlignment& alignment, const QString& reference, const qint32& leftBound);
 };
 
 } // namespace Gambit
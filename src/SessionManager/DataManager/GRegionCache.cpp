@@ -0,0 +1,123 @@
+// ***************************************************************************
+// GRegionCache.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Bounded (LRU) cache of processed region data sets. A cached data set also
+// serves any region it covers.
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtDebug>
+#include "SessionManager/DataManager/GRegionCache.h"
+using namespace Gambit;
+using namespace Gambit::Core;
+
+// default memory budget
+const int GRegionCache::MAX_KILOBYTES = 256 * 1024;
+
+GRegionCache::GRegionCache(int maxKilobytes)
+    : m_data(maxKilobytes)
+{ }
+
+GRegionCache::~GRegionCache(void) { }
+
+QString GRegionCache::Key(const GGenomicDataRegion& region) {
+    return QString("%1:%2:%3").arg(region.RefId).arg(region.LeftBound).arg(region.RightBound);
+}
+
+bool GRegionCache::Covers(const GGenomicDataRegion& outer, const GGenomicDataRegion& inner) {
+    return ( (outer.RefId == inner.RefId) &&
+             (outer.LeftBound  <= inner.LeftBound) &&
+             (outer.RightBound >= inner.RightBound) );
+}
+
+// rough size of data set (string data & per-item overhead)
+int GRegionCache::EstimateKilobytes(const GGenomicDataSet& data) {
+    qint64 bytes = data.Sequence.size() * sizeof(QChar);
+    foreach ( const GAlignment& gAlignment, data.Alignments ) {
+        bytes += sizeof(GAlignment);
+        bytes += ( gAlignment.Name.size() + gAlignment.Bases.size() + gAlignment.PaddedBases.size() + gAlignment.Qualities.size() ) * sizeof(QChar);
+        bytes += gAlignment.Mismatches.size() * sizeof(qint32);
+        bytes += gAlignment.Insertions.size() * 32;
+    }
+    bytes += data.Genes.size() * (sizeof(GGene) + 64);
+    bytes += data.Snps.size() * (sizeof(GSnp) + 32);
+    bytes += data.Genotypes.Calls.size() * sizeof(quint32);
+    bytes += data.Padding.size() * 32;
+    return (int)( (bytes / 1024) + 1 );
+}
+
+bool GRegionCache::Find(const GGenomicDataRegion& region, GGenomicDataSet& data) {
+
+    // look for smallest cached region covering requested one
+    QString foundKey;
+    qint32 foundLength = 0;
+    QHash<QString, GGenomicDataRegion>::iterator regionIter = m_regions.begin();
+    while ( regionIter != m_regions.end() ) {
+
+        // forget regions evicted from cache
+        if ( !m_data.contains(regionIter.key()) ) {
+            regionIter = m_regions.erase(regionIter);
+            continue;
+        }
+
+        const GGenomicDataRegion& cached = regionIter.value();
+        const qint32 length = cached.RightBound - cached.LeftBound;
+        if ( Covers(cached, region) && (foundKey.isEmpty() || (length < foundLength)) ) {
+            foundKey    = regionIter.key();
+            foundLength = length;
+        }
+        ++regionIter;
+    }
+    if ( foundKey.isEmpty() ) { return false; }
+
+    // note - marks entry as most recently used
+    data = *m_data.object(foundKey);
+    return true;
+}
+
+void GRegionCache::Insert(const GGenomicDataRegion& requested, const GGenomicDataSet& data) {
+
+    // drop cached regions made redundant by this one
+    QHash<QString, GGenomicDataRegion>::iterator regionIter = m_regions.begin();
+    while ( regionIter != m_regions.end() ) {
+        if ( Covers(requested, regionIter.value()) ) {
+            m_data.remove(regionIter.key());
+            regionIter = m_regions.erase(regionIter);
+        } else { ++regionIter; }
+    }
+
+    // store data (QCache evicts least recently used sets to stay within budget)
+    const QString key = Key(requested);
+    if ( m_data.insert(key, new GGenomicDataSet(data), EstimateKilobytes(data)) ) {
+        m_regions.insert(key, requested);
+    }
+}
+
+void GRegionCache::Clear(void) {
+    m_data.clear();
+    m_regions.clear();
+}
+
+void GRegionCache::SetContext(const QString& context) {
+    if ( context == m_context ) { return; }
+    Clear();
+    m_context = context;
+}
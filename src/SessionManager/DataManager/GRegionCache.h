@@ -0,0 +1,76 @@
+// ***************************************************************************
+// GRegionCache.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Bounded (LRU) cache of processed region data sets. A cached data set also
+// serves any region it covers.
+// ***************************************************************************
+
+#ifndef G_REGIONCACHE_H
+#define G_REGIONCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QString>
+#include "DataStructures/GGenomicDataSet.h"
+
+namespace Gambit {
+namespace Core {
+
+class GRegionCache {
+
+    // constructors & destructors
+    public:
+        GRegionCache(int maxKilobytes = MAX_KILOBYTES);
+        ~GRegionCache(void);
+
+    // cache access
+    public:
+        // returns true (and data set) if a cached data set covers region
+        // note - returned data may extend beyond region
+        bool Find(const GGenomicDataRegion& region, GGenomicDataSet& data);
+        // stores data set processed for requested region (replaces any cached sets it covers)
+        void Insert(const GGenomicDataRegion& requested, const GGenomicDataSet& data);
+        void Clear(void);
+        // sets what cached data depends on, besides region (open files, processing settings)
+        // cache is cleared if context changes
+        void SetContext(const QString& context);
+
+    // internal methods
+    private:
+        static QString Key(const GGenomicDataRegion& region);
+        static int EstimateKilobytes(const GGenomicDataSet& data);
+        static bool Covers(const GGenomicDataRegion& outer, const GGenomicDataRegion& inner);
+
+    // data members
+    private:
+        QCache<QString, GGenomicDataSet>   m_data;
+        QHash<QString, GGenomicDataRegion> m_regions;   // requested region for each key (may include evicted keys)
+        QString m_context;
+
+    // static constants
+    public:
+        static const int MAX_KILOBYTES;
+};
+
+} // namespace Core
+} // namespace Gambit
+
+#endif // G_REGIONCACHE_H
@@ -51,12 +51,13 @@ void BgzfData::Close(void) {
     if (!IsOpen) { return; }
     IsOpen = false;
 
-    // flush the current BGZF block
-    if (IsWriteOnly) { FlushBlock(); }
-
-        // write an empty block (as EOF marker)
+    // flush the current BGZF block & write an empty block (as EOF marker)
+    // note - only for files opened for writing
+    if (IsWriteOnly) {
+        FlushBlock();
         int blockLength = DeflateBlock();
         fwrite(CompressedBlock, 1, blockLength, Stream);
+    }
 
     // flush and close
     fflush(Stream);
@@ -250,6 +251,18 @@ void BgzfData::Open(const string& filename, const char* mode) {
     IsOpen = true;
 }
 
+bool BgzfData::OpenForReading(const string& filename) {
+
+    // skip if file can't be opened (e.g. moved, or out of file descriptors)
+    FILE* stream = fopen(filename.c_str(), "rb");
+    if ( stream == 0 ) { return false; }
+
+    Stream      = stream;
+    IsWriteOnly = false;
+    IsOpen      = true;
+    return true;
+}
+
 int BgzfData::Read(char* data, const unsigned int dataLength) {
 
    if (dataLength == 0) { return 0; }
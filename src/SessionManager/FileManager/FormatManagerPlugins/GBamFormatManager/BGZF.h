@@ -91,6 +91,8 @@ struct BgzfData {
     int InflateBlock(const int& blockLength);
     // opens the BGZF file for reading (mode is either "rb" for reading, or "wb" for writing
     void Open(const std::string& filename, const char* mode);
+    // opens the BGZF file for reading, returns false on failure (instead of exiting)
+    bool OpenForReading(const std::string& filename);
     // reads BGZF data into a byte buffer
     int Read(char* data, const unsigned int dataLength);
     // reads BGZF block
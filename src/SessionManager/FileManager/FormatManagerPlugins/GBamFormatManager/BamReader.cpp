@@ -14,6 +14,7 @@
 // C++ includes
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -33,7 +34,9 @@ struct BamReader::BamReaderPrivate {
     BgzfData  mBGZF;
     string    HeaderText;
     BamIndex  Index;
+    const BamIndex* SharedIndex; // index owned by reader this one was cloned from (read-only)
     RefVector References;
+    map<string, int> ReferenceLookup;
     bool      IsIndexLoaded;
     int64_t   AlignmentsBeginOffset;
     string    Filename;
@@ -62,6 +65,7 @@ struct BamReader::BamReaderPrivate {
     void Close(void);
     bool Jump(int refID, int position = 0);
     void Open(const string& filename, const string& indexFilename = "");
+    bool OpenClone(const BamReaderPrivate& source);
     bool Rewind(void);
 
     // access alignment data
@@ -138,6 +142,17 @@ bool BamReader::Jump(int refID, int position) { return d->Jump(refID, position);
 void BamReader::Open(const string& filename, const string& indexFilename) { d->Open(filename, indexFilename); }
 bool BamReader::Rewind(void) { return d->Rewind(); }
 
+// opens clone of this reader (for concurrent queries), returns 0 if not open
+BamReader* BamReader::Clone(void) const {
+    if ( !d->mBGZF.IsOpen ) { return 0; }
+    BamReader* clone = new BamReader;
+    if ( !clone->d->OpenClone(*d) ) {
+        delete clone;
+        return 0;
+    }
+    return clone;
+}
+
 // access alignment data
 bool BamReader::GetNextAlignment(BamAlignment& bAlignment) { return d->GetNextAlignment(bAlignment); }
 
@@ -156,7 +171,8 @@ bool BamReader::CreateIndex(void) { return d->CreateIndex(); }
 
 // constructor
 BamReader::BamReaderPrivate::BamReaderPrivate(void)
-    : IsIndexLoaded(false)
+    : SharedIndex(0)
+    , IsIndexLoaded(false)
     , AlignmentsBeginOffset(0)
     , IsRegionSpecified(false)
     , CurrentRefID(0)
@@ -351,7 +367,10 @@ void BamReader::BamReaderPrivate::ClearIndex(void) {
 void BamReader::BamReaderPrivate::Close(void) {
     mBGZF.Close();
     ClearIndex();
+    SharedIndex = 0;
     HeaderText.clear();
+    References.clear();
+    ReferenceLookup.clear();
     IsRegionSpecified = false;
 }
 
@@ -372,17 +391,9 @@ bool BamReader::BamReaderPrivate::CreateIndex(void) {
 
 // returns RefID for given RefName (returns References.size() if not found)
 const int BamReader::BamReaderPrivate::GetReferenceID(const string& refName) const {
-
-    // retrieve names from reference data
-    vector<string> refNames;
-    RefVector::const_iterator refIter = References.begin();
-    RefVector::const_iterator refEnd  = References.end();
-    for ( ; refIter != refEnd; ++refIter) {
-        refNames.push_back( (*refIter).RefName );
-    }
-
-    // return 'index-of' refName ( if not found, returns refNames.size() )
-    return distance(refNames.begin(), find(refNames.begin(), refNames.end(), refName));
+    map<string, int>::const_iterator lookupIter = ReferenceLookup.find(refName);
+    if ( lookupIter == ReferenceLookup.end() ) { return References.size(); }
+    return lookupIter->second;
 }
 
 // get next alignment (from specified region, if given)
@@ -416,7 +427,8 @@ int64_t BamReader::BamReaderPrivate::GetOffset(int refID, int left) {
     int numBins = BinsFromRegion(refID, left, bins);
 
     // get bins for this reference
-    const ReferenceIndex& refIndex = Index.at(refID);
+    const BamIndex& index          = ( SharedIndex ? *SharedIndex : Index );
+    const ReferenceIndex& refIndex = index.at(refID);
     const BamBinMap& binMap        = refIndex.Bins;
 
     // get minimum offset to consider
@@ -845,6 +857,7 @@ void BamReader::BamReaderPrivate::LoadReferenceData(void) {
         aReference.RefName   = (string)((const char*)refName);
         aReference.RefLength = refLength;
         References.push_back(aReference);
+        ReferenceLookup.insert( make_pair(aReference.RefName, (int)i) );
 
         // clean up calloc-ed temp variable
         free(refName);
@@ -928,6 +941,28 @@ void BamReader::BamReaderPrivate::Open(const string& filename, const string& ind
     }
 }
 
+// opens BAM file already opened by source reader, sharing its (read-only) index
+// returns false if file could not be re-opened
+bool BamReader::BamReaderPrivate::OpenClone(const BamReaderPrivate& source) {
+
+    Filename      = source.Filename;
+    IndexFilename = source.IndexFilename;
+
+    // open own BGZF stream, copy header text & reference data (no need to re-read)
+    if ( !mBGZF.OpenForReading(Filename) ) { return false; }
+    HeaderText            = source.HeaderText;
+    References            = source.References;
+    ReferenceLookup       = source.ReferenceLookup;
+    AlignmentsBeginOffset = source.AlignmentsBeginOffset;
+
+    // use source's index
+    SharedIndex   = ( source.SharedIndex ? source.SharedIndex : &source.Index );
+    IsIndexLoaded = source.IsIndexLoaded;
+
+    // move to first alignment
+    return mBGZF.Seek(AlignmentsBeginOffset);
+}
+
 // returns BAM file pointer to beginning of alignment data
 bool BamReader::BamReaderPrivate::Rewind(void) {
 
@@ -36,6 +36,10 @@ class BamReader {
         // BAM file operations
         // ----------------------
 
+        // opens another reader on the same BAM file, sharing this reader's index & reference data
+        // (for concurrent queries) - returns 0 if not open or file can't be re-opened,
+        // this reader must stay open while clone is in use
+        BamReader* Clone(void) const;
         // close BAM file
         void Close(void);
         // performs random-access jump to reference, position
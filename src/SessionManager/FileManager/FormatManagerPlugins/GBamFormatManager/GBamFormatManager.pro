@@ -19,7 +19,8 @@ HEADERS += GBamReader.h \
     GBamFormatManager.h \
     BamReader.h \
     BamAux.h \
-    BGZF.h
+    BGZF.h \
+    ../../TextIO/GHandlePool.h
 
 # Add included zlib headers for Windows platforms
 win32:HEADERS += ./zconf.h \
@@ -32,17 +32,36 @@
 #include "DataStructures/GColorScheme.h"
 #include "DataStructures/GFileInfo.h"
 #include "DataStructures/GGenomicDataSet.h"
+#include "DataStructures/GReferenceDictionary.h"
+#include "SessionManager/FileManager/TextIO/GHandlePool.h"
 using namespace Gambit;
 using namespace Gambit::FileIO;
 
 #include "BamReader.h"
 using namespace BamTools;
 
+// part of requested region, decoded by a single worker
+struct Gambit::FileIO::GBamRegionPart {
+    const BamReader*        Source;       // main reader (query readers are cloned from it)
+    GHandlePool<BamReader>* Handles;      // query readers
+    QString                 Filename;
+    qint32                  RefId;
+    qint32                  LeftBound;
+    qint32                  RightBound;
+    bool                    IsConcurrent; // decoded alongside other parts
+    GAlignmentList          Alignments;
+};
+
 struct GBamReader::GBamReaderPrivate {
 
     // 'private' data
     BamReader Reader;
+    QString   Filename;
     bool      IsReaderOpen;
+    GReferenceMapper References;
+
+    // query readers (clones of main reader, sharing its index), so regions can be loaded concurrently
+    GHandlePool<BamReader> Handles;
 
     // constructor
     GBamReaderPrivate(void) : IsReaderOpen(false) { }
@@ -53,6 +72,8 @@ struct GBamReader::GBamReaderPrivate {
     bool Open(const GFileInfo& fileInfo);
 
     // 'private' data load methods
+    // note - regions at least twice this wide are split into parts, decoded concurrently
+    static const qint32 MIN_PART_WIDTH = 262144;
     const GAlignmentList LoadAlignments(const GGenomicDataRegion& region);
 
     bool LoadReferences(GReferenceList& references);
@@ -73,6 +94,10 @@ bool GBamReader::Open(const GFileInfo& fileInfo) {
     return d->Open(fileInfo);
 }
 
+void GBamReader::SetReferenceDictionary(const GReferenceDictionary* dictionary) {
+    d->References.SetSession(dictionary);
+}
+
 bool GBamReader::Close(void) {
     return d->Close();
 }
@@ -92,8 +117,10 @@ bool GBamReader::GBamReaderPrivate::Close(void) {
     // skip if not open
     if ( !IsReaderOpen ) { return false; }
 
-    // close reader
+    // close reader (query readers first, they use its index)
+    Handles.Clear();
     Reader.Close();
+    Filename.clear();
     IsReaderOpen = false;
 
     return true;
@@ -112,7 +139,16 @@ bool GBamReader::GBamReaderPrivate::Open(const GFileInfo& fileInfo) {
         Reader.Open(fileInfo.Filename.toStdString(), fileInfo.IndexFilename.toStdString());
     }
 
+    // store file's reference names, for resolving requested regions
+    QStringList refNames;
+    const RefVector refData = Reader.GetReferenceData();
+    RefVector::const_iterator refIter = refData.begin();
+    RefVector::const_iterator refEnd  = refData.end();
+    for ( ; refIter != refEnd; ++refIter ) { refNames.append( QString((*refIter).RefName.c_str()) ); }
+    References.SetFileReferences(refNames);
+
     // set flag return success (fail?)
+    Filename = fileInfo.Filename;
     IsReaderOpen = true;
     return true;
 }
@@ -120,55 +156,42 @@ bool GBamReader::GBamReaderPrivate::Open(const GFileInfo& fileInfo) {
 const GAlignmentList
 GBamReader::GBamReaderPrivate::LoadAlignments(const GGenomicDataRegion& region) {
 
-    const qint32 refID = Reader.GetReferenceID( region.RefName.toStdString() );
-
-    // try to jump to specified region
-    if ( !Reader.Jump(refID, region.LeftBound) ) { return GAlignmentList(); }
-
-    // create container of BamAlignments
-    QList<BamAlignment> bAlignments;
-
-    // populate BamAlignment container
-    BamAlignment bAlignment;
-    while ( Reader.GetNextAlignment(bAlignment) ) {
-
-        // increment position by 1 (BAM is 0-based, Gambit is 1-based)
-        ++bAlignment.Position;
-
-        if ((bAlignment.Position >= region.LeftBound) && (bAlignment.Position <= region.RightBound)) {
-            bAlignments.append(bAlignment);
-        }
-
-        // alignment positions are starting beyond rightbound, just stop checking
-        if ( bAlignment.Position >= region.RightBound) { break; }
+    // resolve region to file's own reference ID
+    const qint32 refID = References.FileId(region);
+    if ( refID < 0 ) { return GAlignmentList(); }
+
+    // split region into parts (wide regions only), aligned to BAI linear index windows
+    // each part holds alignments starting within its bounds, so parts never overlap
+    const qint32 window = ( 1 << BAM_LIDX_SHIFT );
+    const qint32 width  = region.RightBound - region.LeftBound + 1;
+    int numParts = 1;
+    if ( width >= (2 * MIN_PART_WIDTH) ) {
+        numParts = qBound(1, width / MIN_PART_WIDTH, QThread::idealThreadCount());
     }
-
-    // convert BamAlignments to GAlignments
-    // Qt 4.5 introduced a simple interface for multi-threading this type of operation
-    // otherwise, just iterate 'normally'
-
-    GAlignmentList alignments;
-
-#if QT_VERSION >= 0x040500
-    alignments = QtConcurrent::blockingMapped(bAlignments, Gambit::FileIO::ConvertAlignment);
-#else
-    foreach (bAlignment, bAlignments) {
-        GAlignment gAlignment = ConvertAlignment(bAlignment);
-        alignments.append(gAlignment);
+    const qint32 partWidth  = ( ((width / numParts) + window - 1) / window ) * window;
+    const qint32 windowBase = ( (region.LeftBound - 1) / window ) * window;
+
+    QVector<GBamRegionPart> parts;
+    for ( int i = 0; i < numParts; ++i ) {
+        GBamRegionPart part;
+        part.Source     = &Reader;
+        part.Handles    = &Handles;
+        part.Filename   = Filename;
+        part.RefId      = refID;
+        part.LeftBound  = ( (i == 0) ? region.LeftBound : (windowBase + (i * partWidth) + 1) );
+        part.RightBound = ( (i == numParts - 1) ? region.RightBound : qMin(region.RightBound, windowBase + ((i + 1) * partWidth)) );
+        if ( part.LeftBound > part.RightBound ) { break; }
+        parts.append(part);
     }
-#endif
+    for ( int i = 0; i < parts.size(); ++i ) { parts[i].IsConcurrent = ( parts.size() > 1 ); }
 
-    // remove empty alignments (no sequence present... happens in odd cases)
-    QMutableListIterator<GAlignment> alignIter(alignments);
-    while (alignIter.hasNext()) {
-        GAlignment gAlignment = alignIter.next();
-        if (gAlignment.Bases == "") {
-            alignIter.remove();
-        }
-    }
+    // decode parts (each on its own worker & query reader, if region was split)
+    if ( parts.size() == 1 ) { DecodeRegionPart(parts[0]); }
+    else { QtConcurrent::blockingMap(parts, Gambit::FileIO::DecodeRegionPart); }
 
-    // sort alignments by position before return
-    qSort(alignments.begin(), alignments.end(), GAlignment::SortByPosition());
+    // concatenate results (each part is position-sorted, & parts are in position order)
+    GAlignmentList alignments;
+    for ( int i = 0; i < parts.size(); ++i ) { alignments += parts.at(i).Alignments; }
     return alignments;
 }
 
@@ -197,6 +220,63 @@ bool GBamReader::GBamReaderPrivate::LoadReferences(GReferenceList& references) {
     return true;    // error case anywhere?
 }
 
+void Gambit::FileIO::DecodeRegionPart(GBamRegionPart& part) {
+
+    // get query reader, opened on first use
+    GPooledHandle<BamReader> reader(*part.Handles);
+    if ( reader.IsNull() ) { reader.Set( part.Source->Clone() ); }
+    if ( reader.IsNull() ) { return; }
+
+    // try to jump to part (BAM is 0-based, Gambit is 1-based)
+    if ( !reader->Jump(part.RefId, part.LeftBound - 1) ) { return; }
+
+    // create container of BamAlignments
+    QList<BamAlignment> bAlignments;
+
+    // populate BamAlignment container
+    BamAlignment bAlignment;
+    while ( reader->GetNextAlignment(bAlignment) ) {
+
+        // increment position by 1 (BAM is 0-based, Gambit is 1-based)
+        ++bAlignment.Position;
+
+        if ((bAlignment.Position >= part.LeftBound) && (bAlignment.Position <= part.RightBound)) {
+            bAlignments.append(bAlignment);
+        }
+
+        // alignment positions are starting beyond rightbound, just stop checking
+        if ( bAlignment.Position > part.RightBound ) { break; }
+    }
+
+    // convert BamAlignments to GAlignments
+    // Qt 4.5 introduced a simple interface for multi-threading this type of operation
+    // otherwise (or if parts are already decoded concurrently), just iterate 'normally'
+
+#if QT_VERSION >= 0x040500
+    if ( !part.IsConcurrent ) {
+        part.Alignments = QtConcurrent::blockingMapped(bAlignments, Gambit::FileIO::ConvertAlignment);
+    } else
+#endif
+    {
+        foreach (bAlignment, bAlignments) {
+            GAlignment gAlignment = ConvertAlignment(bAlignment);
+            part.Alignments.append(gAlignment);
+        }
+    }
+
+    // remove empty alignments (no sequence present... happens in odd cases), store source file
+    // note - no sorting needed, BAM records are already position-sorted
+    QMutableListIterator<GAlignment> alignIter(part.Alignments);
+    while (alignIter.hasNext()) {
+        GAlignment& gAlignment = alignIter.next();
+        if (gAlignment.Bases == "") {
+            alignIter.remove();
+        } else {
+            gAlignment.SourceFilename = part.Filename;
+        }
+    }
+}
+
 GAlignment Gambit::FileIO::ConvertAlignment(const BamAlignment& bAlignment) {
 
     // build new GAlignment from BamAlignment data
@@ -37,6 +37,8 @@ class GAlignment;
 
 namespace FileIO {
 
+struct GBamRegionPart;
+
 class GBamReader : public GAbstractFileReader {
 
     public:
@@ -48,6 +50,7 @@ class GBamReader : public GAbstractFileReader {
         bool LoadData(GGenomicDataSet& data);
         bool Open(const GFileInfo& fileInfo);
         bool LoadReferences(GReferenceList& references);
+        void SetReferenceDictionary(const GReferenceDictionary* dictionary);
 
     private:
         struct GBamReaderPrivate;
@@ -55,6 +58,7 @@ class GBamReader : public GAbstractFileReader {
 };
 
 GAlignment ConvertAlignment(const BamAlignment&);
+void DecodeRegionPart(GBamRegionPart&);
 
 } // namespace FileIO
 } // namespace Gambit
@@ -36,7 +36,7 @@ GBedFormatManager::GBedFormatManager(QObject* parent)
     , GAbstractFormatManager()
 {
     m_formatData.Name = "BED";
-    m_formatData.Extensions << "*.bed";
+    m_formatData.Extensions << "*.bed" << "*.bed.gz";
 //    m_formatData.IndexExtensions << "*.bei";
     m_formatData.Types << GFileInfo::File_Gene << GFileInfo::File_Snp;
     m_formatData.UsesIndex = false;
@@ -8,3 +8,4 @@ SOURCES     += GBedReader.cpp \
                GBedFormatManager.cpp
 HEADERS     += GBedReader.h \
                GBedFormatManager.h
+include(../../TextIO/TextIO.pri)
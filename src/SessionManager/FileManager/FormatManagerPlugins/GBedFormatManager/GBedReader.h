@@ -27,28 +27,21 @@
 #ifndef G_BEDREADER_H
 #define G_BEDREADER_H
 
-#include "SessionManager/FileManager/GAbstractFileReader.h"
-#include "DataStructures/GReference.h"
-class QString;
+#include "SessionManager/FileManager/TextIO/GIndexedTextReader.h"
 
 namespace Gambit {
 namespace FileIO {
 
-class GBedReader : public GAbstractFileReader {
+class GBedReader : public GIndexedTextReader {
 
     public:
         GBedReader(void);
         ~GBedReader(void);
 
-    public:
-        bool Close(void);
-        bool LoadData(GGenomicDataSet& data);
-        bool Open(const GFileInfo& fileInfo);
-        bool LoadReferences(GReferenceList& references);
-
-    private:
-        struct GBedReaderPrivate;
-        GBedReaderPrivate* d;
+    // GIndexedTextReader implementation
+    protected:
+        void ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const;
+        void ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const;
 };
 
 } // namespace FileIO
@@ -5,6 +5,7 @@ INCLUDEPATH += ../../../../ ../../../../src/
 TARGET       = gambit_fileformat_fasta
 DESTDIR      = ../../../../../plugins
 HEADERS     += GFastaReader.h \
-               GFastaFormatManager.h
+               GFastaFormatManager.h \
+               ../../TextIO/GHandlePool.h
 SOURCES     += GFastaReader.cpp \
                GFastaFormatManager.cpp
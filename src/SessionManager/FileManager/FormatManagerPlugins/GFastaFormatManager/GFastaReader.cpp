@@ -30,6 +30,8 @@
 #include "./GFastaReader.h"
 #include "DataStructures/GFileInfo.h"
 #include "DataStructures/GGenomicDataSet.h"
+#include "DataStructures/GReferenceDictionary.h"
+#include "SessionManager/FileManager/TextIO/GHandlePool.h"
 using namespace Gambit;
 using namespace Gambit::FileIO;
 
@@ -48,8 +50,12 @@ struct GFastaReader::GFastaReaderPrivate {
     QFile File;
     QFile IndexFile;
     QList<GFastaIndexData> Index;
+    GReferenceMapper References;
     bool IsReaderOpen;
 
+    // query file handles (index is shared), so regions can be loaded concurrently
+    GHandlePool<QFile> Handles;
+
     // constructor
     GFastaReaderPrivate(void) : IsReaderOpen(false) { }
     ~GFastaReaderPrivate(void) { Close(); }
@@ -71,7 +77,6 @@ struct GFastaReader::GFastaReaderPrivate {
     QPair<qint64,qint64> CalculateOffsets(const quint32& refID,
                                           const qint32&  left,
                                           const qint32&  right);
-    const quint32 GetReferenceID(const QString& refName);
     void TrimSequenceWhitespace(QString& sequence);
 };
 
@@ -102,6 +107,10 @@ bool GFastaReader::LoadReferences(GReferenceList& references) {
     return false;
 }
 
+void GFastaReader::SetReferenceDictionary(const GReferenceDictionary* dictionary) {
+    d->References.SetSession(dictionary);
+}
+
 bool GFastaReader::Open(const GFileInfo& fileInfo) {
     return d->Open(fileInfo);
 }
@@ -111,6 +120,7 @@ bool GFastaReader::Open(const GFileInfo& fileInfo) {
 // ------------------------------------------
 
 bool GFastaReader::GFastaReaderPrivate::Close(void) {
+    Handles.Clear();
     File.close();
     Index.clear();
     IsReaderOpen = false;
@@ -150,6 +160,11 @@ bool GFastaReader::GFastaReaderPrivate::Open(const GFileInfo& fileInfo) {
         // load index data from index file
         else { LoadIndex(); }
 
+        // store file's reference names, for resolving requested regions
+        QStringList refNames;
+        foreach ( const GFastaIndexData& entry, Index ) { refNames.append(entry.Name); }
+        References.SetFileReferences(refNames);
+
         // set flag
         IsReaderOpen = true;
 
@@ -166,9 +181,9 @@ GFastaReader::GFastaReaderPrivate::LoadSequence(GGenomicDataRegion& region)
     // intialize sequence string
     QString sequence = "";
 
-    // get reference ID from name
-    quint32 refID = GetReferenceID(region.RefName);
-    if ( refID >= (quint32)Index.size() ) { qDebug() << "Reference not found."; return sequence; }
+    // resolve region to file's own reference ID
+    const qint32 refID = References.FileId(region);
+    if ( (refID < 0) || (refID >= Index.size()) ) { qDebug() << "Reference not found."; return sequence; }
 
     // adjust right bound if greater than ref-seq length
     qint32 refMaxLength = Index.at(refID).Length;
@@ -182,8 +197,17 @@ GFastaReader::GFastaReaderPrivate::LoadSequence(GGenomicDataRegion& region)
     QPair<qint64,qint64> offsets = CalculateOffsets(refID, region.LeftBound, region.RightBound);
     if ( (offsets.first == -1) ) { qDebug() << "Could not find FASTA entry"; return sequence; }
 
+    // get query file handle, opened on first use
+    GPooledHandle<QFile> file(Handles);
+    if ( file.IsNull() ) {
+        QFile* newFile = new QFile(File.fileName());
+        if ( newFile->open(QIODevice::ReadOnly) ) { file.Set(newFile); }
+        else { delete newFile; }
+    }
+    if ( file.IsNull() ) { qDebug() << "Could not open file."; return sequence; }
+
     // seek to beginning of desired FASTA region
-    QTextStream stream(&File);
+    QTextStream stream(file.Get());
     if ( !stream.seek(offsets.first) ) { qDebug() << "Could not seek"; return sequence; }
 
     // read sequence
@@ -392,15 +416,6 @@ GFastaReader::GFastaReaderPrivate::CalculateOffsets(const quint32& refID,
     return qMakePair(startOffset, bytesToRead);
 }
 
-const quint32 GFastaReader::GFastaReaderPrivate::GetReferenceID(const QString& refName) {
-    quint32 id = 0;
-    foreach (GFastaIndexData entry, Index) {
-        if ( entry.Name == refName ) { break; }
-        ++id;
-    }
-    return id;
-}
-
 void GFastaReader::GFastaReaderPrivate::TrimSequenceWhitespace(QString& sequence) {
 
     // initialize data buffers, indices, and boundaries
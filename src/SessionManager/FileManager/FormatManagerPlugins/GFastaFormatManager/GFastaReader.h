@@ -45,6 +45,7 @@ class GFastaReader : public GAbstractFileReader {
         bool LoadData(GGenomicDataSet& data);
         bool Open(const GFileInfo& fileInfo);
         bool LoadReferences(GReferenceList& references);
+        void SetReferenceDictionary(const GReferenceDictionary* dictionary);
 
     private:
         struct GFastaReaderPrivate;
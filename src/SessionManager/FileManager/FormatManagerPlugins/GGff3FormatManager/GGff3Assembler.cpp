@@ -0,0 +1,404 @@
+// ***************************************************************************
+// GGff3Assembler.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit plugin: (lib)gambit_fileformat_gff3.
+// Plugin license rights are same as main application.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Assembles GFF3 features into genes, joining ID/Parent attributes. Transcripts
+// (features with exon/CDS children) become genes with their exon lists. For
+// sorted input, each top-level feature is flushed once reading moves past it.
+// ***************************************************************************
+
+
+#include <QtCore>
+#include <cstring>
+#include "./GGff3Assembler.h"
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// GFF3 columns used for assembly (1-based coordinates)
+enum Gff3Field { CHROM_NAME    = 0
+               , FEATURE_TYPE  = 2
+               , FEATURE_START = 3
+               , FEATURE_STOP  = 4
+               , STRAND        = 6
+               , ATTRIBUTES    = 8
+};
+
+// max depth followed through hierarchy (guards against malformed, cyclic Parent attributes)
+static const int MAX_DEPTH = 32;
+
+// returns whether field matches (null-terminated) key
+static inline
+bool IsKey(const GFieldView& field, const char* key) {
+    const int length = (int)strlen(key);
+    return ( (field.Length == length) && (memcmp(field.Data, key, length) == 0) );
+}
+
+// returns attribute value, decoding any escaped characters
+static inline
+QByteArray AttributeValue(const GFieldView& value) {
+    const QByteArray result = value.ToByteArray();
+    return ( result.contains('%') ? QByteArray::fromPercentEncoding(result) : result );
+}
+
+GGff3Assembler::GGff3Assembler(bool isStreaming)
+    : m_isStreaming(isStreaming)
+    , m_minOpenStop(0)
+    , m_droppedCount(0)
+{ }
+
+GGff3Assembler::~GGff3Assembler(void) { }
+
+bool GGff3Assembler::ParseFeature(GFieldTokenizer& fields, GGff3Feature& feature) {
+
+    // get position data
+    bool startOk = false;
+    bool stopOk  = false;
+    feature.Start = fields.Field(FEATURE_START).ToInt(&startOk);
+    feature.Stop  = fields.Field(FEATURE_STOP).ToInt(&stopOk);
+    if ( !startOk || !stopOk ) { return false; }
+
+    // get reference, type & strand (reusing previous feature's strings when unchanged)
+    const GFieldView refName = fields.Field(CHROM_NAME);
+    const GFieldView type    = fields.Field(FEATURE_TYPE).Trimmed();
+    const GFieldView strand  = fields.Field(STRAND).Trimmed();
+    if ( refName != feature.RefName ) { feature.RefName = refName.ToByteArray(); }
+    if ( type    != feature.Type )    { feature.Type    = type.ToByteArray(); }
+    feature.Strand = ( strand.IsEmpty() ? '?' : strand.Data[0] );
+
+    // scan attributes ("key=value;key=value..."), keeping only those used for assembly
+    feature.Id.clear();
+    feature.Parents.clear();
+    feature.Name.clear();
+    const GFieldView attributes = fields.Field(ATTRIBUTES);
+    const char* p   = attributes.Data;
+    const char* end = attributes.Data + attributes.Length;
+    while ( p < end ) {
+        const char* stop = (const char*)memchr(p, ';', end - p);
+        if ( stop == 0 ) { stop = end; }
+        const char* equals = (const char*)memchr(p, '=', stop - p);
+        if ( equals ) {
+            const GFieldView key   = GFieldView(p, equals - p).Trimmed();
+            const GFieldView value = GFieldView(equals + 1, stop - equals - 1).Trimmed();
+            if      ( IsKey(key, "ID") )     { feature.Id      = AttributeValue(value); }
+            else if ( IsKey(key, "Parent") ) { feature.Parents = AttributeValue(value); }
+            else if ( IsKey(key, "Name") )   { feature.Name    = AttributeValue(value); }
+        }
+        p = stop + 1;
+    }
+    return true;
+}
+
+void GGff3Assembler::AddFeature(const GGff3Feature& feature) {
+
+    // if new reference
+    if ( feature.RefName != m_refName ) {
+
+        // when streaming, everything on previous reference is done
+        if ( m_isStreaming ) {
+            FlushAll();
+            m_flushedIds.clear();
+        }
+        m_refName        = feature.RefName;
+        m_currentRefName = QString::fromLatin1(m_refName.constData(), m_refName.size());
+    }
+
+    // otherwise, flush any top-level features that end before this one
+    else if ( m_isStreaming ) { FlushFinished(feature.Start); }
+
+    const bool hasId     = !feature.Id.isEmpty();
+    const bool hasParent = !feature.Parents.isEmpty();
+
+    // standalone feature - emit right away
+    if ( !hasId && !hasParent ) {
+        GGene gGene;
+        gGene.Name    = QString::fromLatin1(feature.Name.constData(), feature.Name.size());
+        gGene.AuxInfo = QString::fromLatin1(feature.Type.constData(), feature.Type.size());
+        gGene.Start   = feature.Start;
+        gGene.Stop    = feature.Stop;
+        gGene.Strand  = QString(QChar::fromLatin1(feature.Strand));
+        EmitGene(gGene, m_currentRefName);
+        return;
+    }
+
+    // drop features whose parents (or earlier lines of the same feature) were already flushed,
+    // rather than emitting them as stray top-level genes
+    if ( (hasParent && IsFlushed(feature.Parents)) || (hasId && m_flushedIds.contains(feature.Id)) ) {
+        if ( hasId ) { m_flushedIds.insert(feature.Id); }   // its own children go with it
+        ++m_droppedCount;
+        return;
+    }
+
+    // exon/CDS parts - attach to each parent
+    // note - other ID-less children, and transcript sub-parts (UTRs, start/stop codons, etc.) even with an ID
+    //        (as in GENCODE), are not drawn - they must not become child nodes, hiding their transcript's exons
+    const bool isExon = ( feature.Type == "exon" );
+    const bool isCds  = ( feature.Type == "CDS" );
+    if ( isExon || isCds || !hasId || (hasParent && IsSubPartType(feature.Type)) ) {
+        if ( !isExon && !isCds ) { return; }
+        foreach ( const QByteArray& parentId, feature.Parents.split(',') ) {
+            if ( m_flushedIds.contains(parentId) ) { continue; }
+            const int slot = FindNode(parentId);
+            Node& node = m_nodes[slot];
+            if ( isExon ) { node.Exons.append( qMakePair(feature.Start, feature.Stop) ); }
+            else          { node.Cds.append( qMakePair(feature.Start, feature.Stop) ); }
+            Extend(slot, feature.Start, feature.Stop);
+        }
+        return;
+    }
+
+    // feature with ID
+    const int slot = FindNode(feature.Id);
+
+    // if already defined, this is another line of a multi-line feature - store each line as exon
+    if ( m_nodes.at(slot).IsDefined ) {
+        Node& node = m_nodes[slot];
+        if ( node.Exons.isEmpty() ) { node.Exons.append( qMakePair(node.Start, node.Stop) ); }
+        node.Exons.append( qMakePair(feature.Start, feature.Stop) );
+        Extend(slot, feature.Start, feature.Stop);
+        return;
+    }
+
+    // define node
+    {
+        Node& node = m_nodes[slot];
+        node.IsDefined = true;
+        node.Name      = feature.Name;
+        node.Type      = feature.Type;
+        node.Strand    = feature.Strand;
+    }
+
+    // link to (first unflushed) parent
+    if ( hasParent ) {
+        QByteArray parentId;
+        foreach ( const QByteArray& id, feature.Parents.split(',') ) {
+            if ( !m_flushedIds.contains(id) ) {
+                parentId = id;
+                break;
+            }
+        }
+        if ( parentId != feature.Id ) {
+            const int parentSlot = FindNode(parentId);
+            m_openRoots.removeOne(slot);
+            m_nodes[slot].Parent = parentSlot;
+            m_nodes[parentSlot].Children.append(slot);
+        }
+    }
+    Extend(slot, feature.Start, feature.Stop);
+}
+
+void GGff3Assembler::Finish(void) {
+
+    FlushAll();
+
+    if ( m_droppedCount > 0 ) {
+        qDebug() << "GGff3Assembler: dropped" << m_droppedCount << "feature(s) listed after their parent's extent (file not sorted by start?)";
+    }
+    m_flushedIds.clear();
+    m_droppedCount = 0;
+
+    // drop any nodes left over (only possible with cyclic Parent attributes)
+    m_nodes.clear();
+    m_freeSlots.clear();
+    m_lookup.clear();
+    m_refName.clear();
+    m_currentRefName.clear();
+}
+
+QVector< QPair<QString, GGene> > GGff3Assembler::TakeGenes(void) {
+    QVector< QPair<QString, GGene> > genes = m_genes;
+    m_genes.clear();
+    return genes;
+}
+
+// returns node slot for ID, creating (top-level, undefined) node if needed
+int GGff3Assembler::FindNode(const QByteArray& id) {
+
+    // return existing node if found
+    QHash<QByteArray, int>::const_iterator lookupIter = m_lookup.constFind(id);
+    if ( lookupIter != m_lookup.constEnd() ) { return lookupIter.value(); }
+
+    // otherwise create node (reusing released slots)
+    int slot;
+    if ( !m_freeSlots.isEmpty() ) {
+        slot = m_freeSlots.last();
+        m_freeSlots.pop_back();
+    } else {
+        slot = m_nodes.size();
+        m_nodes.append( Node() );
+    }
+    Node& node = m_nodes[slot];
+    node.Id      = id;
+    node.RefName = m_currentRefName;
+    m_lookup.insert(id, slot);
+    m_openRoots.append(slot);
+    return slot;
+}
+
+// returns whether all of (comma-separated) parent IDs belong to already-flushed nodes
+bool GGff3Assembler::IsFlushed(const QByteArray& parents) const {
+    if ( m_flushedIds.isEmpty() ) { return false; }
+    foreach ( const QByteArray& parentId, parents.split(',') ) {
+        if ( !m_flushedIds.contains(parentId) ) { return false; }
+    }
+    return true;
+}
+
+// returns whether node (or any descendant) has exon/CDS parts
+bool GGff3Assembler::HasParts(int slot, int depth) const {
+    if ( depth >= MAX_DEPTH ) { return false; }
+    const Node& node = m_nodes.at(slot);
+    if ( !node.Exons.isEmpty() || !node.Cds.isEmpty() ) { return true; }
+    foreach ( int child, node.Children ) {
+        if ( HasParts(child, depth + 1) ) { return true; }
+    }
+    return false;
+}
+
+// returns whether feature type is a piece of a transcript (rather than something that owns exons)
+bool GGff3Assembler::IsSubPartType(const QByteArray& type) {
+    return ( type.endsWith("UTR") || type.endsWith("_codon") || type.startsWith("stop_codon") ||
+             (type == "intron") || (type == "Selenocysteine") );
+}
+
+// extends node (and its ancestors) to include [start, stop]
+void GGff3Assembler::Extend(int slot, qint32 start, qint32 stop) {
+    for ( int depth = 0; (slot != -1) && (depth < MAX_DEPTH); ++depth ) {
+        Node& node = m_nodes[slot];
+        if ( !node.HasExtent ) {
+            node.Start     = start;
+            node.Stop      = stop;
+            node.HasExtent = true;
+        } else {
+            if ( start < node.Start ) { node.Start = start; }
+            if ( stop  > node.Stop  ) { node.Stop  = stop;  }
+        }
+        if ( (node.Parent == -1) && (node.Stop < m_minOpenStop) ) { m_minOpenStop = node.Stop; }
+        slot = node.Parent;
+    }
+}
+
+// flushes top-level nodes that end before position (sorted input only)
+void GGff3Assembler::FlushFinished(qint32 position) {
+
+    // skip if no top-level node can end before position
+    if ( position <= m_minOpenStop ) { return; }
+
+    // flush finished nodes & recalculate minimum stop of those still open
+    qint32 minStop = position;
+    bool hasOpen = false;
+    for ( int i = 0; i < m_openRoots.size(); ) {
+        const int slot = m_openRoots.at(i);
+        const qint32 stop = m_nodes.at(slot).Stop;
+        if ( stop < position ) {
+            FlushRoot(slot);    // removes slot from open list
+        } else {
+            if ( !hasOpen || (stop < minStop) ) { minStop = stop; }
+            hasOpen = true;
+            ++i;
+        }
+    }
+    m_minOpenStop = minStop;
+}
+
+void GGff3Assembler::FlushAll(void) {
+    while ( !m_openRoots.isEmpty() ) { FlushRoot(m_openRoots.first()); }
+    m_minOpenStop = 0;
+}
+
+void GGff3Assembler::FlushRoot(int slot) {
+    m_openRoots.removeOne(slot);
+    EmitNode(slot, 0);
+    ReleaseNode(slot, 0);
+}
+
+// emits leaf nodes (transcripts, or genes without transcripts) as genes
+void GGff3Assembler::EmitNode(int slot, int depth) {
+
+    if ( depth >= MAX_DEPTH ) { return; }
+    const Node& node = m_nodes.at(slot);
+
+    // if node has no exon/CDS parts of its own, but has child nodes, emit those instead
+    // (only children with parts, e.g. transcripts, if there are any)
+    if ( node.Exons.isEmpty() && node.Cds.isEmpty() && !node.Children.isEmpty() ) {
+        bool hasChildParts = false;
+        foreach ( int child, node.Children ) {
+            if ( HasParts(child, depth + 1) ) {
+                hasChildParts = true;
+                break;
+            }
+        }
+        foreach ( int child, node.Children ) {
+            if ( !hasChildParts || HasParts(child, depth + 1) ) { EmitNode(child, depth + 1); }
+        }
+        return;
+    }
+
+    // skip nodes with no data at all
+    if ( !node.IsDefined && node.Exons.isEmpty() && node.Cds.isEmpty() ) { return; }
+
+    // build gene
+    GGene gGene;
+    const QByteArray& name = ( node.Name.isEmpty() ? node.Id : node.Name );
+    gGene.Name   = QString::fromLatin1(name.constData(), name.size());
+    gGene.Start  = node.Start;
+    gGene.Stop   = node.Stop;
+    gGene.Strand = QString(QChar::fromLatin1(node.Strand));
+
+    // aux info is parent's name (e.g. gene of a transcript), or feature type for top-level features
+    if ( node.Parent != -1 ) {
+        const Node& parent = m_nodes.at(node.Parent);
+        const QByteArray& parentName = ( parent.Name.isEmpty() ? parent.Id : parent.Name );
+        gGene.AuxInfo = QString::fromLatin1(parentName.constData(), parentName.size());
+    } else {
+        gGene.AuxInfo = QString::fromLatin1(node.Type.constData(), node.Type.size());
+    }
+
+    // build exon list (from exons, or CDS if no exons given), in position order
+    QVector< QPair<qint32, qint32> > parts = ( node.Exons.isEmpty() ? node.Cds : node.Exons );
+    qSort(parts);
+    for ( int i = 0; i < parts.size(); ++i ) {
+        GExon gExon;
+        gExon.Start = parts.at(i).first;
+        gExon.Stop  = parts.at(i).second;
+        gGene.Exons.append(gExon);
+    }
+
+    EmitGene(gGene, node.RefName);
+}
+
+// removes node (and its descendants), freeing their slots & IDs
+void GGff3Assembler::ReleaseNode(int slot, int depth) {
+
+    if ( depth >= MAX_DEPTH ) { return; }
+
+    const QVector<int> children = m_nodes.at(slot).Children;
+    foreach ( int child, children ) { ReleaseNode(child, depth + 1); }
+
+    m_lookup.remove( m_nodes.at(slot).Id );
+    if ( m_isStreaming ) { m_flushedIds.insert( m_nodes.at(slot).Id ); }
+    m_nodes[slot] = Node();
+    m_freeSlots.append(slot);
+}
+
+void GGff3Assembler::EmitGene(const GGene& gene, const QString& refName) {
+    m_genes.append( qMakePair(refName, gene) );
+}
@@ -0,0 +1,150 @@
+// ***************************************************************************
+// GGff3Assembler.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit plugin: (lib)gambit_fileformat_gff3.
+// Plugin license rights are same as main application.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Assembles GFF3 features into genes, joining ID/Parent attributes. Transcripts
+// (features with exon/CDS children) become genes with their exon lists. For
+// sorted input, each top-level feature is flushed once reading moves past it.
+// ***************************************************************************
+
+
+#ifndef G_GFF3ASSEMBLER_H
+#define G_GFF3ASSEMBLER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "DataStructures/GGene.h"
+
+namespace Gambit {
+namespace FileIO {
+
+class GFieldTokenizer;
+
+// single GFF3 line (only data needed for assembly)
+struct GGff3Feature {
+
+    // data members
+    QByteArray RefName;
+    QByteArray Type;
+    qint32     Start;
+    qint32     Stop;
+    char       Strand;
+    QByteArray Id;
+    QByteArray Parents;     // comma-separated IDs
+    QByteArray Name;
+
+    // constructor
+    GGff3Feature(void)
+        : Start(0)
+        , Stop(0)
+        , Strand('?')
+    { }
+};
+
+class GGff3Assembler {
+
+    // constructor/destructor
+    public:
+        // isStreaming - input is position-sorted, so finished genes can be flushed early
+        GGff3Assembler(bool isStreaming = false);
+        ~GGff3Assembler(void);
+
+    // assembler interface
+    public:
+        // parses feature from (tokenized) line, returns success/fail
+        static bool ParseFeature(GFieldTokenizer& fields, GGff3Feature& feature);
+        // adds feature to hierarchy
+        void AddFeature(const GGff3Feature& feature);
+        // flushes all remaining genes, must be called after last feature is added
+        void Finish(void);
+        // returns whether any assembled genes are waiting to be taken
+        bool HasGenes(void) const { return !m_genes.isEmpty(); }
+        // returns (& clears) assembled genes, with their reference names
+        QVector< QPair<QString, GGene> > TakeGenes(void);
+
+    // feature hierarchy node
+    private:
+        struct Node {
+            QByteArray   Id;
+            QByteArray   Name;
+            QByteArray   Type;
+            QString      RefName;
+            qint32       Start;
+            qint32       Stop;
+            char         Strand;
+            bool         IsDefined;   // false until node's own line is seen (only referenced as Parent so far)
+            bool         HasExtent;
+            int          Parent;
+            QVector<int> Children;
+            QVector< QPair<qint32, qint32> > Exons;
+            QVector< QPair<qint32, qint32> > Cds;
+            Node(void) : Start(0), Stop(0), Strand('?'), IsDefined(false), HasExtent(false), Parent(-1) { }
+        };
+
+    // 'internal' methods
+    private:
+        int  FindNode(const QByteArray& id);
+        bool IsFlushed(const QByteArray& parents) const;
+        bool HasParts(int slot, int depth) const;
+        static bool IsSubPartType(const QByteArray& type);
+        void Extend(int slot, qint32 start, qint32 stop);
+        void FlushFinished(qint32 position);
+        void FlushAll(void);
+        void FlushRoot(int slot);
+        void EmitNode(int slot, int depth);
+        void ReleaseNode(int slot, int depth);
+        void EmitGene(const GGene& gene, const QString& refName);
+
+    // data members
+    private:
+        bool m_isStreaming;
+
+        // current reference
+        QByteArray m_refName;
+        QString    m_currentRefName;
+
+        // nodes, looked up by (interned) ID
+        QVector<Node>         m_nodes;
+        QVector<int>          m_freeSlots;
+        QHash<QByteArray,int> m_lookup;
+
+        // top-level nodes not yet flushed
+        QList<int> m_openRoots;
+        qint32     m_minOpenStop;
+
+        // IDs of nodes already flushed on current reference (streaming only), & count of
+        // late features dropped because their parents were among them
+        QSet<QByteArray> m_flushedIds;
+        int              m_droppedCount;
+
+        // assembled genes
+        QVector< QPair<QString, GGene> > m_genes;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_GFF3ASSEMBLER_H
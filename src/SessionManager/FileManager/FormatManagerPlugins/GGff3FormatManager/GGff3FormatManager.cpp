@@ -36,7 +36,7 @@ GGff3FormatManager::GGff3FormatManager(QObject* parent)
     , GAbstractFormatManager()
 {
     m_formatData.Name = "GFF3";
-    m_formatData.Extensions << "*.gff3";
+    m_formatData.Extensions << "*.gff3" << "*.gff3.gz";
     m_formatData.Types << GFileInfo::File_Gene << GFileInfo::File_Snp;
     m_formatData.UsesIndex = false;
 }
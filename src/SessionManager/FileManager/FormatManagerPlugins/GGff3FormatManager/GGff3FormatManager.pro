@@ -4,7 +4,10 @@ INCLUDEPATH += .
 INCLUDEPATH += ../../../../ ../../../../src/
 TARGET       = gambit_fileformat_gff3
 DESTDIR      = ../../../../../plugins
-SOURCES     += GGff3Reader.cpp \
+SOURCES     += GGff3Assembler.cpp \
+               GGff3Reader.cpp \
                GGff3FormatManager.cpp
-HEADERS     += GGff3Reader.h \
+HEADERS     += GGff3Assembler.h \
+               GGff3Reader.h \
                GGff3FormatManager.h
+include(../../TextIO/TextIO.pri)
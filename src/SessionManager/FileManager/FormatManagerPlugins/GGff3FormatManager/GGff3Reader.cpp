@@ -25,229 +25,200 @@
 // ***************************************************************************
 
 #include <QtCore>
-#include <QProgressDialog>
-#include <QtDebug>
 #include "./GGff3Reader.h"
-#include "DataStructures/GFileInfo.h"
 #include "DataStructures/GGene.h"
 #include "DataStructures/GGenomicDataSet.h"
 #include "DataStructures/GSnp.h"
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+#include "SessionManager/FileManager/TextIO/GParallelTextParser.h"
 using namespace Gambit;
 using namespace Gambit::FileIO;
 
-struct GGff3Reader::GGff3ReaderPrivate {
-
-    // data members
-    QFile File;
-    bool  IsReaderOpen;
-    GFileInfo::FileType Type;
-
-    // constructor
-    GGff3ReaderPrivate(void) : IsReaderOpen(false), Type(GFileInfo::File_Gene) { }
-    ~GGff3ReaderPrivate(void) { Close(); }
-
-    // general file handling
-    bool Close(void);
-    bool Open(const GFileInfo& fileInfo);
-    bool LoadData(GGenomicDataSet& data);
-
-    // used internally for specific data access
-    private:
-        const GGeneList LoadGenes(const GGenomicDataRegion& region);
-        const GSnpList  LoadSnps(const GGenomicDataRegion& region);
-        GGene LoadSingleGene(const QStringList& fields);
-        GSnp  LoadSingleSnp(const QStringList& fields);
-
-        // GFF2 is 1-based coordinates
-        enum Gff3Field { CHROM_NAME = 0
-                      , SOURCE
-                      , FEATURE_NAME
-                      , FEATURE_START
-                      , FEATURE_STOP
-                      , SCORE
-                      , STRAND
-                      , FRAME
-                      , ATTRIBUTES
-                      , COMMENTS
-        };
+// GFF3 is 1-based coordinates
+enum Gff3Field { CHROM_NAME = 0
+               , SOURCE
+               , FEATURE_NAME
+               , FEATURE_START
+               , FEATURE_STOP
+               , SCORE
+               , STRAND
+               , FRAME
+               , ATTRIBUTES
+               , COMMENTS
 };
 
-GGff3Reader::GGff3Reader(void)
-    : GAbstractFileReader()
-{
-    d = new GGff3ReaderPrivate;
-}
+static GSnp LoadSingleSnp(GFieldTokenizer& fields) {
 
-GGff3Reader::~GGff3Reader(void) {
-    delete d;
-    d = 0;
-}
+    // construct new SNP
+    GSnp gSnp;
+    gSnp.Position = fields.Field(FEATURE_START).ToInt();
 
-bool GGff3Reader::Close(void) {
-    return d->Close();
-}
+    // if name availale, set snp name
+    if (fields.Count() > FEATURE_NAME) {
+        gSnp.Name = fields.Field(FEATURE_NAME).ToString();
+    }
 
-bool GGff3Reader::LoadData(GGenomicDataSet& data) {
-    if ( !d->IsReaderOpen ) { return false; }
-    return d->LoadData(data);
-}
+    // if score data available, set snp score
+    if (fields.Count() > SCORE ) {
+        gSnp.Score = fields.Field(SCORE).ToDouble();
+    }
 
-bool GGff3Reader::LoadReferences(GReferenceList& references) {
-    Q_UNUSED(references);
-    return false;
+    return gSnp;
 }
 
-bool GGff3Reader::Open(const GFileInfo& fileInfo) {
-    return d->Open(fileInfo);
+// moves any assembled genes into store
+static void StoreGenes(GGff3Assembler& assembler, GAnnotationStore& store) {
+    if ( !assembler.HasGenes() ) { return; }
+    const QVector< QPair<QString, GGene> > genes = assembler.TakeGenes();
+    for ( int i = 0; i < genes.size(); ++i ) {
+        store.AddGene(genes.at(i).first, genes.at(i).second);
+    }
 }
 
-// ------------------------------------------
-// GFastaReaderPrivate implementation
-// ------------------------------------------
+// assembles each parsed range as soon as it (& all ranges before it) are done
+struct Gff3RangeAssembler {
 
-bool GGff3Reader::GGff3ReaderPrivate::Close(void) {
-    File.close();
-    IsReaderOpen = false;
-    return true;
-}
+    GGff3Assembler&   Assembler;
+    GAnnotationStore& Store;
 
-bool GGff3Reader::GGff3ReaderPrivate::Open(const GFileInfo& fileInfo) {
+    Gff3RangeAssembler(GGff3Assembler& assembler, GAnnotationStore& store)
+        : Assembler(assembler)
+        , Store(store)
+    { }
 
-    // skip if reader already opened
-    if ( IsReaderOpen ) { return false; }
+    void operator()(const QVector<GGff3Feature>& features) {
+        for ( int i = 0; i < features.size(); ++i ) {
+            Assembler.AddFeature(features.at(i));
+            StoreGenes(Assembler, Store);
+        }
+    }
+};
 
-    // set filename & type
-    File.setFileName(fileInfo.Filename);
-    Type = fileInfo.Type;
+// ------------------------------------------
+// GGff3Reader implementation
+// ------------------------------------------
 
-    // open BED file
-    if ( File.open(QIODevice::ReadOnly)) { IsReaderOpen = true; }
+GGff3Reader::GGff3Reader(void)
+    : GIndexedTextReader(GTextIndexFormat::GffFormat())
+{ }
 
-    // return success/fail
-    return IsReaderOpen;
+GGff3Reader::~GGff3Reader(void) {
+    Close();
 }
 
-bool GGff3Reader::GGff3ReaderPrivate::LoadData(GGenomicDataSet& data) {
-
-    // skip if reader not open
-    if ( !IsReaderOpen ) { return false; }
-
-    switch ( Type ) {
-
-        case ( GFileInfo::File_Gene ) :
-            data.Genes = LoadGenes(data.Region);
-            break;
+void GGff3Reader::ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const {
+    if ( Type() == GFileInfo::File_Snp ) { batch.Snps.append( qMakePair(refName, LoadSingleSnp(fields)) ); }
+}
 
-        case ( GFileInfo::File_Snp  ) :
-            data.Snps = LoadSnps(data.Region);
-            break;
+void GGff3Reader::ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const {
 
-        default : qDebug() << "Unknown file type in GGff3Reader..."; return false;
+    // SNPs
+    if ( Type() == GFileInfo::File_Snp ) {
+        const GSnp snp = LoadSingleSnp(fields);
+        names.AddName(refName, snp.Name, snp.Position, snp.Position);
+        return;
     }
 
-    // return success
-    return true;
+    // genes - named features (genes, transcripts, ...), exon & CDS parts are not searchable
+    GGff3Feature feature;
+    if ( !GGff3Assembler::ParseFeature(fields, feature) ) { return; }
+    if ( (feature.Type == "exon") || (feature.Type == "CDS") ) { return; }
+    const QByteArray& name = ( feature.Name.isEmpty() ? feature.Id : feature.Name );
+    names.AddName(refName, QString::fromUtf8(name.constData(), name.size()), feature.Start, feature.Stop);
 }
 
-const GGeneList GGff3Reader::GGff3ReaderPrivate::LoadGenes(const GGenomicDataRegion& region) {
-
-    // initialize gene list
-    GGeneList genes;
+void GGff3Reader::BuildStore(GAnnotationStore& store) {
 
-    // initialize string parsing variables
-    QString line = "";
-    QStringList fields;
-
-    // rewind file pointer
-    File.seek(0);
-
-    // while data exists
-    while ( !File.atEnd() ) {
+    // SNPs are one per line
+    if ( Type() == GFileInfo::File_Snp ) {
+        GIndexedTextReader::BuildStore(store);
+        return;
+    }
 
-        // get line data
-        line   = File.readLine();
-        fields = line.split('\t');
+    // large (plain text) files - features are parsed in parallel, but assembled in file order
+    // note - only a few ranges are parsed ahead of assembly, so memory use is bounded by range size, not file size
+    GGff3Assembler assembler( File().Index().IsSorted() );
+    qint64 dataSize = 0;
+    const char* data = ( (QFileInfo(Filename()).size() >= GParallelTextParser::MIN_FILE_SIZE) ? File().MapData(dataSize) : 0 );
+    if ( data ) {
+        Gff3RangeAssembler rangeAssembler(assembler, store);
+        GParallelTextParser::RunOrdered(this, &GGff3Reader::ParseFeatures, data, dataSize, rangeAssembler);
+        File().UnmapData();
+    }
 
-        // if entry in desired region
-        if ( (fields.at(GGff3Reader::GGff3ReaderPrivate::CHROM_NAME)             == region.RefName) &&
-             (fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_START).toInt() >= region.LeftBound)    &&
-             (fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_STOP).toInt()  <= region.RightBound)
-            )
-        {
-            // append new gene entry
-            genes.append( LoadSingleGene(fields) );
+    // otherwise read features reference by reference
+    // note - for sorted files this is file order, so genes can be assembled (& flushed) as they are read
+    else {
+        GFieldTokenizer fields;
+        GGff3Feature    feature;
+        foreach ( const QString& refName, File().Index().ReferenceNames() ) {
+            if ( !File().SetReference(refName) ) { continue; }
+            while ( File().GetNextLine(fields) ) {
+                if ( GGff3Assembler::ParseFeature(fields, feature) ) {
+                    assembler.AddFeature(feature);
+                    StoreGenes(assembler, store);
+                }
+            }
         }
     }
 
-    return genes;
+    assembler.Finish();
+    StoreGenes(assembler, store);
 }
 
-const GSnpList GGff3Reader::GGff3ReaderPrivate::LoadSnps(const GGenomicDataRegion& region) {
-
-    // intialize snp list
-    GSnpList snps;
-
-    // initialize string parsing variables
-    QString line = "";
-    QStringList fields;
+void GGff3Reader::LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data) {
 
-    // rewind
-    File.seek(0);
-
-    // while data exists
-    while ( !File.atEnd() ) {
-
-        // get line data
-        line   = File.readLine();
-        fields = line.split('\t');
+    // SNPs are one per line
+    if ( Type() == GFileInfo::File_Snp ) {
+        GIndexedTextReader::LoadRegion(file, region, data);
+        return;
+    }
 
-        // if entry in desired region
-        if ( (fields.at(GGff3Reader::GGff3ReaderPrivate::CHROM_NAME)             == region.RefName) &&
-             (fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_START).toInt() >= region.LeftBound)    &&
-             (fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_STOP).toInt()  <= region.RightBound)
-            )
-        {
-            // append new snp entry
-            snps.append( LoadSingleSnp(fields) );
+    // assemble genes from all features overlapping region
+    // note - children lie within their parent's extent, so all parts of genes in region are read here
+    GFieldTokenizer fields;
+    GGff3Feature    feature;
+    GGff3Assembler  assembler;
+    while ( file.GetNextLine(fields) ) {
+        if ( GGff3Assembler::ParseFeature(fields, feature) ) { assembler.AddFeature(feature); }
+    }
+    assembler.Finish();
+
+    // keep genes contained in region
+    const QVector< QPair<QString, GGene> > assembled = assembler.TakeGenes();
+    for ( int i = 0; i < assembled.size(); ++i ) {
+        const GGene& gGene = assembled.at(i).second;
+        if ( (gGene.Start >= region.LeftBound) && (gGene.Stop <= region.RightBound) ) {
+            data.Genes.append(gGene);
         }
     }
-
-    return snps;
 }
 
-GGene GGff3Reader::GGff3ReaderPrivate::LoadSingleGene(const QStringList& fields) {
-
-    // construct new gene
-    GGene gGene;
-    gGene.Name  = fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_NAME).trimmed();
-    gGene.Start = fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_START).toInt();
-    gGene.Stop  = fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_STOP).toInt();
+// parses features in byte range of (mapped) file data
+// note - runs concurrently with other ranges
+QVector<GGff3Feature> GGff3Reader::ParseFeatures(const char* data, GTextIndexChunk range) {
 
-    // if strand data available, get it... else set default
-    if ( fields.size() > GGff3Reader::GGff3ReaderPrivate::STRAND ) {
-        gGene.Strand = fields.at(GGff3Reader::GGff3ReaderPrivate::STRAND).trimmed();
-    } else {
-        gGene.Strand = "?";
-    }
-
-    return gGene;
-}
+    QVector<GGff3Feature> features;
 
-GSnp GGff3Reader::GGff3ReaderPrivate::LoadSingleSnp(const QStringList& fields) {
+    // initialize field parsing variables
+    GFieldTokenizer fields;
+    GFieldView   line;
+    GFieldView   refName;
+    GGff3Feature feature;
+    qint32 begin = 0;
+    qint32 end   = 0;
 
-    // construct new SNP
-    GSnp gSnp;
-    gSnp.Position = fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_START).toInt();
+    // while range data exists
+    qint64 position = range.Start;
+    while ( GParallelTextParser::NextLine(data, range.Stop, position, line) ) {
 
-    // if name availale, set snp name
-    if (fields.size() > GGff3Reader::GGff3ReaderPrivate::FEATURE_NAME) {
-        gSnp.Name = fields.at(GGff3Reader::GGff3ReaderPrivate::FEATURE_NAME);
-    }
+        // skip header lines, comments, & any non-interval entries
+        fields.SetLine(line);
+        if ( !GTextIndex::ParseInterval(fields, File().Index().Format(), refName, begin, end) ) { continue; }
 
-    // if score data available, set snp score
-    if (fields.size() > GGff3Reader::GGff3ReaderPrivate::SCORE ) {
-        gSnp.Score = fields.at(GGff3Reader::GGff3ReaderPrivate::SCORE).toDouble();
+        // store feature
+        if ( GGff3Assembler::ParseFeature(fields, feature) ) { features.append(feature); }
     }
 
-    return gSnp;
+    return features;
 }
@@ -27,28 +27,30 @@
 #ifndef G_GFF3READER_H
 #define G_GFF3READER_H
 
-#include "SessionManager/FileManager/GAbstractFileReader.h"
-#include "DataStructures/GReference.h"
-class QString;
+#include <QVector>
+#include "./GGff3Assembler.h"
+#include "SessionManager/FileManager/TextIO/GIndexedTextReader.h"
 
 namespace Gambit {
 namespace FileIO {
 
-class GGff3Reader : public GAbstractFileReader {
+class GGff3Reader : public GIndexedTextReader {
 
     public:
         GGff3Reader(void);
         ~GGff3Reader(void);
 
-    public:
-        bool Close(void);
-        bool LoadData(GGenomicDataSet& data);
-        bool Open(const GFileInfo& fileInfo);
-        bool LoadReferences(GReferenceList& references);
+    // GIndexedTextReader implementation
+    // note - genes span several lines, so are assembled in BuildStore() & LoadRegion() instead of ParseLine()
+    protected:
+        void ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const;
+        void ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const;
+        void BuildStore(GAnnotationStore& store);
+        void LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data);
 
+    // 'internal' methods
     private:
-        struct GGff3ReaderPrivate;
-        GGff3ReaderPrivate* d;
+        QVector<GGff3Feature> ParseFeatures(const char* data, GTextIndexChunk range);
 };
 
 } // namespace FileIO
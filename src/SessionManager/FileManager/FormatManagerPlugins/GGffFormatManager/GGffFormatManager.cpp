@@ -36,7 +36,7 @@ GGffFormatManager::GGffFormatManager(QObject* parent)
     , GAbstractFormatManager()
 {
     m_formatData.Name = "GFF2";
-    m_formatData.Extensions << "*.gff";
+    m_formatData.Extensions << "*.gff" << "*.gff.gz";
     m_formatData.Types << GFileInfo::File_Gene << GFileInfo::File_Snp;
     m_formatData.UsesIndex = false;
 }
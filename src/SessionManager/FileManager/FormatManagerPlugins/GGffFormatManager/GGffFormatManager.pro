@@ -8,3 +8,4 @@ SOURCES     += GGffReader.cpp \
                GGffFormatManager.cpp
 HEADERS     += GGffReader.h \
                GGffFormatManager.h
+include(../../TextIO/TextIO.pri)
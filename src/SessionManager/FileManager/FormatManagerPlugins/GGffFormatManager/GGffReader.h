@@ -27,28 +27,21 @@
 #ifndef G_GFFREADER_H
 #define G_GFFREADER_H
 
-#include "SessionManager/FileManager/GAbstractFileReader.h"
-#include "DataStructures/GReference.h"
-class QString;
+#include "SessionManager/FileManager/TextIO/GIndexedTextReader.h"
 
 namespace Gambit {
 namespace FileIO {
 
-class GGffReader : public GAbstractFileReader {
+class GGffReader : public GIndexedTextReader {
 
     public:
         GGffReader(void);
         ~GGffReader(void);
 
-    public:
-        bool Close(void);
-        bool LoadData(GGenomicDataSet& data);
-        bool Open(const GFileInfo& fileInfo);
-        bool LoadReferences(GReferenceList& references);
-
-    private:
-        struct GGffReaderPrivate;
-        GGffReaderPrivate* d;
+    // GIndexedTextReader implementation
+    protected:
+        void ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const;
+        void ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const;
 };
 
 } // namespace FileIO
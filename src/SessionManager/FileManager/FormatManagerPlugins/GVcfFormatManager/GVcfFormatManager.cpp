@@ -36,7 +36,7 @@ GVcfFormatManager::GVcfFormatManager(QObject* parent)
     , GAbstractFormatManager()
 {
     m_formatData.Name = "VCF";
-    m_formatData.Extensions << "*.vcf";
+    m_formatData.Extensions << "*.vcf" << "*.vcf.gz";
     m_formatData.Types << GFileInfo::File_Snp;
     m_formatData.UsesIndex = false;
 }
@@ -8,3 +8,4 @@ SOURCES     += GVcfReader.cpp \
                GVcfFormatManager.cpp
 HEADERS     += GVcfReader.h \
                GVcfFormatManager.h
+include(../../TextIO/TextIO.pri)
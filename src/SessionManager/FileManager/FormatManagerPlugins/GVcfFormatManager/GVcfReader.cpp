@@ -25,171 +25,281 @@
 // ***************************************************************************
 
 #include <QtCore>
-#include <QProgressDialog>
-#include <QtDebug>
+#include <cstring>
 #include "./GVcfReader.h"
-#include "DataStructures/GFileInfo.h"
-#include "DataStructures/GGene.h"
 #include "DataStructures/GGenomicDataSet.h"
+#include "DataStructures/GGenotypeMatrix.h"
 #include "DataStructures/GSnp.h"
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
 using namespace Gambit;
 using namespace Gambit::FileIO;
 
+// VCF is 1-based coordinates
+enum VcfField { CHROM_NAME = 0
+              , POSITION
+              , FEATURE_ID
+              , REF_ALLELE
+              , ALT_ALLELES
+              , QUAL
+              , FILTER
+              , ADDL_INFO
+              , FORMAT
+              , FIRST_SAMPLE
+};
+
 struct GVcfReader::GVcfReaderPrivate {
 
-    // data members
-    QFile File;
-    bool  IsReaderOpen;
-    GFileInfo::FileType Type;
-
-    // constructor
-    GVcfReaderPrivate(void) : IsReaderOpen(false), Type(GFileInfo::File_Gene) { }
-    ~GVcfReaderPrivate(void) { Close(); }
-
-    // general file handling
-    bool Close(void);
-    bool Open(const GFileInfo& fileInfo);
-    bool LoadData(GGenomicDataSet& data);
-
-    // used internally for specific data access
-    private:
-        const GSnpList LoadSnps(const GGenomicDataRegion& region);
-        GSnpList LoadSnpLine(const QStringList& fields);
-
-        // VCF is 1-based coordinates
-        enum VcfField { CHROM_NAME = 0
-                      , POSITION
-                      , FEATURE_ID
-                      , REF_ALLELE
-                      , ALT_ALLELES
-                      , QUAL
-                      , FILTER
-                      , ADDL_INFO
-        };
+    // sample names (from '#CHROM' header line), empty if sites-only file
+    QStringList SampleNames;
+
+    // genotypes are only parsed while shown (see SetGenotypesEnabled())
+    bool IsGenotypesEnabled;
+
+    GVcfReaderPrivate(void) : IsGenotypesEnabled(false) { }
+    void LoadSampleNames(GIndexedTextFile& file);
 };
 
-// ------------------------------------------
-// GVcfReader implementation
-// ------------------------------------------
+// appends one SNP entry per ALT allele of data line
+static void LoadSnpLine(GFieldTokenizer& fields, const QString& refName, QVector< QPair<QString, GSnp> >& snps) {
 
-GVcfReader::GVcfReader(void)
-    : GAbstractFileReader()
-{
-    d = new GVcfReaderPrivate;
-}
+    GFieldTokenizer alleles(',');
+    alleles.SetLine( fields.Field(ALT_ALLELES) );
 
-GVcfReader::~GVcfReader(void) {
-    delete d;
-    d = 0;
-}
+    GSnp gSnp;
+    gSnp.Position = fields.Field(POSITION).ToInt();
+    gSnp.Name     = fields.Field(FEATURE_ID).ToString();
+    gSnp.Score    = fields.Field(QUAL).ToDouble();
 
-bool GVcfReader::Close(void) {
-    return d->Close();
+    const int numAlleles = alleles.Count();
+    for ( int i = 0; i < numAlleles; ++i ) { snps.append( qMakePair(refName, gSnp) ); }
 }
 
-bool GVcfReader::LoadData(GGenomicDataSet& data) {
-    if ( !d->IsReaderOpen ) { return false; }
-    return d->LoadData(data);
+// returns first tab in [p, end), or end if none
+// note - checks 8 bytes at a time: (x - 0x01..) & ~x & 0x80.. is non-zero iff some byte of x is zero,
+//        with x = word ^ 0x09.. that finds tab bytes (only words containing one are scanned bytewise)
+static inline const char* FindTab(const char* p, const char* end) {
+
+    const quint64 ONES  = Q_UINT64_C(0x0101010101010101);
+    const quint64 HIGHS = Q_UINT64_C(0x8080808080808080);
+    const quint64 TABS  = Q_UINT64_C(0x0909090909090909);
+
+    while ( (end - p) >= 8 ) {
+        quint64 word;
+        memcpy(&word, p, 8);
+        const quint64 x = word ^ TABS;
+        if ( ((x - ONES) & ~x & HIGHS) != 0 ) { break; }
+        p += 8;
+    }
+    while ( (p < end) && (*p != '\t') ) { ++p; }
+    return p;
 }
 
-bool GVcfReader::LoadReferences(GReferenceList& references) {
-    Q_UNUSED(references);
-    return false;
+static inline bool IsAlleleChar(char c) {
+    return ( ((c >= '0') && (c <= '9')) || (c == '.') || (c == '/') || (c == '|') );
 }
 
-bool GVcfReader::Open(const GFileInfo& fileInfo) {
-    return d->Open(fileInfo);
+// classifies call from allele counts
+static inline GGenotypeMatrix::Genotype ClassifyCall(int numAlleles, int numAlt, bool isMissing) {
+    if ( isMissing || (numAlleles == 0) ) { return GGenotypeMatrix::Missing; }
+    if ( numAlt == 0 )                    { return GGenotypeMatrix::HomRef; }
+    if ( numAlt == numAlleles )           { return GGenotypeMatrix::HomAlt; }
+    return GGenotypeMatrix::Het;
 }
 
-// ------------------------------------------
-// GVcfReaderPrivate implementation
-// ------------------------------------------
+// reads GT value at start of sample column, advancing p past it
+static inline GGenotypeMatrix::Genotype ParseCall(const char*& p, const char* end) {
+
+    // common case - diploid call with single-digit alleles (e.g. "0/1", "1|1", "./.")
+    if ( ((end - p) >= 3) && ((p[1] == '/') || (p[1] == '|')) && (((end - p) == 3) || !IsAlleleChar(p[3])) ) {
+        const char a = p[0];
+        const char b = p[2];
+        const bool isDigitA = ( (a >= '0') && (a <= '9') );
+        const bool isDigitB = ( (b >= '0') && (b <= '9') );
+        if ( (isDigitA || (a == '.')) && (isDigitB || (b == '.')) ) {
+            p += 3;
+            return ClassifyCall(2, (int)(a > '0') + (int)(b > '0'), !isDigitA || !isDigitB);
+        }
+    }
 
-bool GVcfReader::GVcfReaderPrivate::Close(void) {
-    File.close();
-    IsReaderOpen = false;
-    return true;
+    // otherwise read allele indexes (separated by '/' or '|'), until ':' or end of column
+    int  numAlleles = 0;
+    int  numAlt     = 0;
+    bool isMissing  = false;
+    while ( (p < end) && (*p != ':') && (*p != '\t') ) {
+        if ( *p == '.' ) {
+            isMissing = true;
+            ++numAlleles;
+            ++p;
+        } else if ( (*p >= '0') && (*p <= '9') ) {
+            int allele = 0;
+            while ( (p < end) && (*p >= '0') && (*p <= '9') ) { allele = (allele * 10) + (*p - '0'); ++p; }
+            if ( allele != 0 ) { ++numAlt; }
+            ++numAlleles;
+        } else { ++p; }
+    }
+    return ClassifyCall(numAlleles, numAlt, isMissing);
 }
 
-bool GVcfReader::GVcfReaderPrivate::Open(const GFileInfo& fileInfo) {
+// reads GT calls from sample columns (starting at 'begin'), writing packed calls directly into 'words'
+// note - single pass over raw bytes; rest of each column (after GT) is skipped 8 bytes at a time
+static void ParseGenotypeCalls(const char* begin, const char* end, quint32* words, int numSamples) {
 
-    // skip if reader already opened
-    if ( IsReaderOpen ) { return false; }
+    const char* p = begin;
+    quint32 word = 0;
+    int shift = 0;
+    int w = 0;
 
-    // set filename & type
-    File.setFileName(fileInfo.Filename);
-    Type = fileInfo.Type;
+    for ( int sample = 0; sample < numSamples; ++sample ) {
 
-    // open BED file
-    if ( File.open(QIODevice::ReadOnly)) { IsReaderOpen = true; }
+        // missing sample columns are treated as missing calls
+        GGenotypeMatrix::Genotype call = GGenotypeMatrix::Missing;
+        if ( p < end ) {
+            call = ParseCall(p, end);
 
-    // return success/fail
-    return IsReaderOpen;
-}
+            // skip to next sample column
+            p = FindTab(p, end);
+            if ( p < end ) { ++p; }
+        }
+
+        // pack call
+        word |= ((quint32)call << shift);
+        shift += 2;
+        if ( shift == 32 ) {
+            words[w++] = word;
+            word  = 0;
+            shift = 0;
+        }
+    }
 
-bool GVcfReader::GVcfReaderPrivate::LoadData(GGenomicDataSet& data) {
+    // store any partial word
+    if ( shift > 0 ) { words[w] = word; }
+}
 
-    // skip if reader not open
-    if ( !IsReaderOpen ) { return false; }
+// ------------------------------------------
+// GVcfReader implementation
+// ------------------------------------------
 
-    // load data
-    data.Snps = LoadSnps(data.Region);
+GVcfReader::GVcfReader(void)
+    : GIndexedTextReader(GTextIndexFormat::VcfFormat())
+{
+    d = new GVcfReaderPrivate;
+}
 
-    // return success
-    return true;
+GVcfReader::~GVcfReader(void) {
+    Close();
+    delete d;
+    d = 0;
 }
 
-const GSnpList GVcfReader::GVcfReaderPrivate::LoadSnps(const GGenomicDataRegion& region) {
+void GVcfReader::SetGenotypesEnabled(bool ok) {
+    d->IsGenotypesEnabled = ok;
+}
 
-    // intialize snp list
-    GSnpList snps;
+void GVcfReader::ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const {
+    LoadSnpLine(fields, refName, batch.Snps);
+}
 
-    // initialize string parsing variables
-    QString line = "";
-    QStringList fields;
+void GVcfReader::ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const {
 
-    // rewind
-    File.seek(0);
+    // variant extent covers REF allele
+    const qint32 position = fields.Field(POSITION).ToInt();
+    const qint32 stop     = position + qMax(1, fields.Field(REF_ALLELE).Length) - 1;
 
-    // while data exists
-    while ( !File.atEnd() ) {
+    // ID column may list several IDs (';'-separated), '.' if none
+    GFieldTokenizer ids(';');
+    ids.SetLine( fields.Field(FEATURE_ID) );
+    const int numIds = ids.Count();
+    for ( int i = 0; i < numIds; ++i ) {
+        const GFieldView id = ids.Field(i).Trimmed();
+        if ( id.IsEmpty() || ((id.Length == 1) && (id.Data[0] == '.')) ) { continue; }
+        names.AddName(refName, id.ToString(), position, stop);
+    }
+}
 
-        // get line data
-        line   = File.readLine();
+void GVcfReader::OpenFormat(void) {
+    d->LoadSampleNames( File() );
+}
 
-        // skip header comments
-        if ( line.startsWith("#")) { continue; }
+void GVcfReader::CloseFormat(void) {
+    d->SampleNames.clear();
+}
 
-        // retrieve tab-delimited fields
-        fields = line.split('\t');
+// store only holds SNPs - while genotypes are wanted, they are read from file in same pass as SNPs
+bool GVcfReader::IsStoreRequest(const GGenomicDataSet& data) const {
+    Q_UNUSED(data);
+    return ( d->SampleNames.isEmpty() || !d->IsGenotypesEnabled );
+}
 
-        // if entry in desired region
-        if ( (fields.at(GVcfReader::GVcfReaderPrivate::CHROM_NAME)       == region.RefName) &&
-             (fields.at(GVcfReader::GVcfReaderPrivate::POSITION).toInt() >= region.LeftBound)
-            )
-        {
-            // append new snp entry
-            snps.append( LoadSnpLine(fields) );
+void GVcfReader::LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data) {
+
+    // initialize genotype matrix (if genotypes wanted)
+    GGenotypeMatrix genotypes;
+    const int numSamples = ( d->IsGenotypesEnabled ? d->SampleNames.size() : 0 );
+    if ( numSamples > 0 ) { genotypes.SetSamples(d->SampleNames); }
+
+    // initialize field parsing variables
+    // note - only leading fields are tokenized, sample columns are parsed directly from line
+    GFieldTokenizer fields;
+    QVector< QPair<QString, GSnp> > snps;
+
+    // while region data exists
+    // note - header lines are skipped by GetNextLine(), which also stops once past region in sorted files
+    while ( file.GetNextLine(fields) ) {
+
+        // skip if entry not in desired region (same rule as stored SNPs)
+        const qint32 position = fields.Field(POSITION).ToInt();
+        if ( (position < region.LeftBound) || (position > region.RightBound) ) { continue; }
+
+        // append SNP entries
+        LoadSnpLine(fields, region.RefName, snps);
+        if ( numSamples == 0 ) { continue; }
+
+        // append genotype site
+        const int site = genotypes.AppendSite(position);
+        quint32* words = genotypes.SiteCalls(site);
+
+        // VCF requires GT (if present) to be first FORMAT key - otherwise mark all calls missing
+        const GFieldView format = fields.Field(FORMAT);
+        const bool hasGT = ( (format.Length >= 2) && (format.Data[0] == 'G') && (format.Data[1] == 'T') &&
+                             ((format.Length == 2) || (format.Data[2] == ':')) );
+        if ( !hasGT ) {
+            for ( int w = 0; w < genotypes.WordsPerSite; ++w ) { words[w] = 0xFFFFFFFFu; }
+            continue;
         }
+
+        // parse sample columns (start just past FORMAT column)
+        const char* lineEnd = fields.Line() + fields.LineLength();
+        const char* begin   = format.Data + format.Length;
+        if ( begin < lineEnd ) { ++begin; }
+        ParseGenotypeCalls(begin, lineEnd, words, numSamples);
     }
 
-    return snps;
+    // store results
+    for ( int i = 0; i < snps.size(); ++i ) { data.Snps.append(snps.at(i).second); }
+    if ( numSamples > 0 ) { data.Genotypes = genotypes; }
 }
 
-GSnpList GVcfReader::GVcfReaderPrivate::LoadSnpLine(const QStringList& fields) {
+// ------------------------------------------
+// GVcfReaderPrivate implementation
+// ------------------------------------------
 
-    GSnpList snps;
-    QString altAlleles = fields.at(GVcfReader::GVcfReaderPrivate::ALT_ALLELES);
-    QStringList alleleList = altAlleles.split(',');
+void GVcfReader::GVcfReaderPrivate::LoadSampleNames(GIndexedTextFile& file) {
 
-    foreach (QString alleleEntry, alleleList) {
-        GSnp gSnp;
-        gSnp.Position = fields.at(GVcfReader::GVcfReaderPrivate::POSITION).toInt();
-        gSnp.Name     = fields.at(GVcfReader::GVcfReaderPrivate::FEATURE_ID);
-        gSnp.Score    = fields.at(GVcfReader::GVcfReaderPrivate::QUAL).toDouble();
-        snps.append(gSnp);
-    }
+    SampleNames.clear();
 
-    return snps;
+    // read header lines
+    QList<QByteArray> headerLines;
+    if ( !file.ReadHeader(headerLines) ) { return; }
 
+    // sample names follow FORMAT column on '#CHROM' line
+    GFieldTokenizer fields;
+    foreach ( const QByteArray& line, headerLines ) {
+        if ( !line.startsWith("#CHROM") ) { continue; }
+        fields.SetLine(line);
+        const int numFields = fields.Count();
+        for ( int i = FIRST_SAMPLE; i < numFields; ++i ) {
+            SampleNames.append( fields.Field(i).ToString() );
+        }
+        break;
+    }
 }
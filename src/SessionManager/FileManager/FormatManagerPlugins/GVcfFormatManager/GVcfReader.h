@@ -27,24 +27,28 @@
 #ifndef G_VCFREADER_H
 #define G_VCFREADER_H
 
-#include "SessionManager/FileManager/GAbstractFileReader.h"
-#include "DataStructures/GReference.h"
-class QString;
+#include "SessionManager/FileManager/TextIO/GIndexedTextReader.h"
 
 namespace Gambit {
 namespace FileIO {
 
-class GVcfReader : public GAbstractFileReader {
+class GVcfReader : public GIndexedTextReader {
 
     public:
         GVcfReader(void);
         ~GVcfReader(void);
 
     public:
-        bool Close(void);
-        bool LoadData(GGenomicDataSet& data);
-        bool Open(const GFileInfo& fileInfo);
-        bool LoadReferences(GReferenceList& references);
+        void SetGenotypesEnabled(bool ok);
+
+    // GIndexedTextReader implementation
+    protected:
+        void ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const;
+        void ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const;
+        void OpenFormat(void);
+        void CloseFormat(void);
+        bool IsStoreRequest(const GGenomicDataSet& data) const;
+        void LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data);
 
     private:
         struct GVcfReaderPrivate;
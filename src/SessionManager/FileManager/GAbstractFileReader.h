@@ -27,6 +27,7 @@
 #ifndef G_ABSTRACTFILEREADER_H
 #define G_ABSTRACTFILEREADER_H
 
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GReference.h"
 class QString;
 
@@ -34,6 +35,7 @@ namespace Gambit {
 
 class GFileInfo;
 class GGenomicDataSet;
+class GReferenceDictionary;
 
 namespace FileIO {
 
@@ -48,6 +50,25 @@ class GAbstractFileReader {
         virtual bool Open(const GFileInfo& fileInfo) =0;
         virtual bool LoadData(GGenomicDataSet& data) =0;
         virtual bool LoadReferences(GReferenceList& references) =0;
+
+    public:
+        // sets session-wide reference dictionary, whose IDs are carried by requested regions
+        // note - readers should resolve these to their own references (see GReferenceMapper)
+        virtual void SetReferenceDictionary(const GReferenceDictionary* dictionary) {
+            Q_UNUSED(dictionary);
+        }
+        // sets whether per-sample genotypes are loaded along with data (only needed while they are shown)
+        virtual void SetGenotypesEnabled(bool ok) {
+            Q_UNUSED(ok);
+        }
+        // appends (up to maxCount) features whose name starts with prefix, ignoring case
+        // returns false if reader has no name index (or it is still being built)
+        virtual bool FindNames(const QString& prefix, int maxCount, GFeatureNameList& names) {
+            Q_UNUSED(prefix);
+            Q_UNUSED(maxCount);
+            Q_UNUSED(names);
+            return false;
+        }
 };
 
 } // namespace FileIO
@@ -56,6 +56,8 @@ void GAbstractFormatManager::OpenFiles(const GFileInfoList& files) {
         if (fileInfo.Format == m_formatData.Name) {
             GAbstractFileReader* reader = CreateNewReader();
             if ( reader ) {
+                reader->SetReferenceDictionary(m_referenceDictionary);
+                reader->SetGenotypesEnabled(m_isGenotypesEnabled);
                 reader->Open(fileInfo);
                 m_readerMap.insert(fileInfo, reader);
             }
@@ -84,6 +86,35 @@ bool GAbstractFormatManager::LoadReferences(GReferenceList& references) {
     return false;
 }
 
+void GAbstractFormatManager::FindNames(const QString& prefix, int maxCount, GFeatureNameList& names) {
+    GReaderMap::const_iterator mapIter = m_readerMap.constBegin();
+    GReaderMap::const_iterator mapEnd  = m_readerMap.constEnd();
+    for ( ; mapIter != mapEnd; ++mapIter ) {
+        GAbstractFileReader* reader = mapIter.value();
+        reader->FindNames(prefix, maxCount, names);
+    }
+}
+
+void GAbstractFormatManager::SetReferenceDictionary(const GReferenceDictionary* dictionary) {
+    m_referenceDictionary = dictionary;
+    GReaderMap::const_iterator mapIter = m_readerMap.constBegin();
+    GReaderMap::const_iterator mapEnd  = m_readerMap.constEnd();
+    for ( ; mapIter != mapEnd; ++mapIter ) {
+        GAbstractFileReader* reader = mapIter.value();
+        reader->SetReferenceDictionary(dictionary);
+    }
+}
+
+void GAbstractFormatManager::SetGenotypesEnabled(bool ok) {
+    m_isGenotypesEnabled = ok;
+    GReaderMap::const_iterator mapIter = m_readerMap.constBegin();
+    GReaderMap::const_iterator mapEnd  = m_readerMap.constEnd();
+    for ( ; mapIter != mapEnd; ++mapIter ) {
+        GAbstractFileReader* reader = mapIter.value();
+        reader->SetGenotypesEnabled(ok);
+    }
+}
+
 const GFileFormatData& GAbstractFormatManager::FormatData(void) {
     return m_formatData;
 }
@@ -91,3 +122,7 @@ const GFileFormatData& GAbstractFormatManager::FormatData(void) {
 const GFileInfoList GAbstractFormatManager::CurrentFiles(void) {
     return m_readerMap.keys();
 }
+
+const QList<GAbstractFileReader*> GAbstractFormatManager::CurrentReaders(void) {
+    return m_readerMap.values();
+}
@@ -38,6 +38,7 @@
 
 #include <QMap>
 #include <QtPlugin>
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GFileFormatData.h"
 #include "DataStructures/GFileInfo.h"
 #include "DataStructures/GReference.h"
@@ -45,6 +46,7 @@
 namespace Gambit {
 
 class GGenomicDataSet;
+class GReferenceDictionary;
 
 namespace FileIO {
 
@@ -54,7 +56,7 @@ typedef QMap<GFileInfo, GAbstractFileReader*> GReaderMap;
 class GAbstractFormatManager {
 
     public:
-        GAbstractFormatManager(void) { }
+        GAbstractFormatManager(void) : m_referenceDictionary(0), m_isGenotypesEnabled(false) { }
         virtual ~GAbstractFormatManager(void) { }
 
     public:
@@ -62,8 +64,12 @@ class GAbstractFormatManager {
         void OpenFiles(const GFileInfoList& files);
         void LoadData(GGenomicDataSet& data);
         bool LoadReferences(GReferenceList& references);
+        void FindNames(const QString& prefix, int maxCount, GFeatureNameList& names);
+        void SetReferenceDictionary(const GReferenceDictionary* dictionary);
+        void SetGenotypesEnabled(bool ok);
         const GFileFormatData& FormatData(void);
         const GFileInfoList CurrentFiles(void);
+        const QList<GAbstractFileReader*> CurrentReaders(void);
 
     protected:
         virtual GAbstractFileReader* CreateNewReader(void) =0;
@@ -71,11 +77,13 @@ class GAbstractFormatManager {
     protected:
         GReaderMap      m_readerMap;
         GFileFormatData m_formatData;
+        const GReferenceDictionary* m_referenceDictionary;
+        bool m_isGenotypesEnabled;
 };
 
 } // namespace FileIO
 } // namespace Gambit
 
-Q_DECLARE_INTERFACE(Gambit::FileIO::GAbstractFormatManager, "Gambit.GFileIO.GAbstractFormatManager/1.0")
+Q_DECLARE_INTERFACE(Gambit::FileIO::GAbstractFormatManager, "Gambit.GFileIO.GAbstractFormatManager/1.1")
 
 #endif // G_ABSTRACTFORMATMANAGER_H
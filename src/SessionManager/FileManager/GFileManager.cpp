@@ -24,11 +24,13 @@
 // This manager is currently responsible for all major file-related operations:
 //   - Opening/closing data files
 //   - Retrieving data from a specified region (from all open files)
+//   - Searching feature names (from all open files)
 //   - Serialization (saves list of currently open files)
 //   - Detecting/loading file format plugins
 // ***************************************************************************
 
 #include <QtGui>
+#include <QtConcurrentMap>
 #include <QtDebug>
 #include "SessionManager/FileManager/GFileManager.h"
 #include "DataStructures/GGenomicDataSet.h"
@@ -40,9 +42,72 @@
 using namespace Gambit;
 using namespace Gambit::FileIO;
 
+// sort helpers
+static inline
+bool FeatureNameLessThan(const GFeatureName& lhs, const GFeatureName& rhs) {
+    return ( QString::compare(lhs.Name, rhs.Name, Qt::CaseInsensitive) < 0 );
+}
+
+static inline
+bool GeneLessThan(const GGene& lhs, const GGene& rhs) {
+    return ( lhs.Start < rhs.Start );
+}
+
+static inline
+bool SnpLessThan(const GSnp& lhs, const GSnp& rhs) {
+    return ( lhs.Position < rhs.Position );
+}
+
+namespace Gambit {
+namespace FileIO {
+
+// single reader's part of a region load (each reader fills its own data set)
+struct GReaderSlot {
+    GAbstractFileReader* Reader;
+    GGenomicDataSet      Data;
+};
+
+static void LoadReaderSlot(GReaderSlot& slot) {
+    slot.Reader->LoadData(slot.Data);
+}
+
+// position in one of several alignment lists being merged
+struct GAlignmentCursor {
+    int List;
+    int Index;
+};
+
+// returns true if lhs cursor's alignment comes first (ties keep list order)
+static inline
+bool CursorLessThan(const GAlignmentCursor& lhs, const GAlignmentCursor& rhs, const QList<const GAlignmentList*>& lists) {
+    const qint32 lhsPosition = lists.at(lhs.List)->at(lhs.Index).Position;
+    const qint32 rhsPosition = lists.at(rhs.List)->at(rhs.Index).Position;
+    if ( lhsPosition != rhsPosition ) { return ( lhsPosition < rhsPosition ); }
+    return ( lhs.List < rhs.List );
+}
+
+// restores min-heap order below cursor at index
+static void SiftDown(QVector<GAlignmentCursor>& heap, int index, const QList<const GAlignmentList*>& lists) {
+    const int size = heap.size();
+    while ( true ) {
+        const int left  = (2 * index) + 1;
+        const int right = left + 1;
+        int smallest = index;
+        if ( (left  < size) && CursorLessThan(heap.at(left),  heap.at(smallest), lists) ) { smallest = left; }
+        if ( (right < size) && CursorLessThan(heap.at(right), heap.at(smallest), lists) ) { smallest = right; }
+        if ( smallest == index ) { return; }
+        qSwap(heap[index], heap[smallest]);
+        index = smallest;
+    }
+}
+
+} // namespace FileIO
+} // namespace Gambit
+
 GFileManager::GFileManager(QObject* parent)
     : QObject(parent)
     , m_isModified(false)
+    , m_isGenotypesEnabled(false)
 {
     LoadPlugins();
 }
@@ -91,6 +156,8 @@ void GFileManager::SavePlugin(QObject* plugin) {
     // check if plugin already known to FileManager
     // (will allow safer 'refresh' when adding plugins during operation)
     if ( manager && !m_managers.contains(manager) ) {
+        manager->SetReferenceDictionary(&m_referenceDictionary);
+        manager->SetGenotypesEnabled(m_isGenotypesEnabled);
         m_managers.append(manager);
     }
 }
@@ -130,6 +197,11 @@ void GFileManager::OpenFiles(GFileInfoList files) {
             if ( !referencesLoaded ) {
                 GReferenceList references;
                 if ( manager->LoadReferences(references) ) {
+
+                    // assign session reference IDs (in reference list order)
+                    m_referenceDictionary.Clear();
+                    foreach ( const GReference& reference, references ) { m_referenceDictionary.Add(reference.Name); }
+
                     emit ReferencesLoaded(references);
                     referencesLoaded = true;
                 }
@@ -198,17 +270,116 @@ GFileFormatList GFileManager::GetSupportedFormats(void) {
 
 GGenomicDataSet GFileManager::LoadData(const GGenomicDataRegion& region)
 {
+    // resolve region's reference ID once, readers then map it to their own references
     GGenomicDataSet data(region);
+    if ( data.Region.RefId < 0 ) { data.Region.RefId = m_referenceDictionary.Id(region.RefName); }
+
+    // set up one slot per open reader
+    QVector<GReaderSlot> readerSlots;
     foreach (GAbstractFormatManager* manager, m_managers) {
-        if ( manager ) { manager->LoadData(data); }
+        if ( !manager ) { continue; }
+        foreach (GAbstractFileReader* reader, manager->CurrentReaders()) {
+            GReaderSlot slot;
+            slot.Reader = reader;
+            slot.Data   = GGenomicDataSet(data.Region);
+            readerSlots.append(slot);
+        }
     }
 
+    // load all readers' data concurrently (region takes as long as slowest reader)
+    // note - each reader is only used by one thread at a time
+    QtConcurrent::blockingMap(readerSlots, Gambit::FileIO::LoadReaderSlot);
+
+    // merge results, in reader order
+    bool isGenesMerged = false;
+    bool isSnpsMerged  = false;
+    QList<const GAlignmentList*> alignmentLists;
+    for ( int i = 0; i < readerSlots.size(); ++i ) {
+        const GGenomicDataSet& readerData = readerSlots.at(i).Data;
+        MergeData(data, readerData, isGenesMerged, isSnpsMerged);
+        if ( !readerData.Alignments.isEmpty() ) { alignmentLists.append(&readerData.Alignments); }
+    }
+    MergeAlignments(alignmentLists, data.Alignments);
+    if ( isGenesMerged ) { qStableSort(data.Genes.begin(), data.Genes.end(), GeneLessThan); }
+    if ( isSnpsMerged )  { qStableSort(data.Snps.begin(),  data.Snps.end(),  SnpLessThan);  }
+
     // ensure right bound matches actual length of reference sequence available
     // (requested range might initially extend beyond reference length)
     data.Region.RightBound = (data.Region.LeftBound + data.Sequence.length() - 1);
     return data;
 }
 
+// adds one reader's data to region data set
+// isGenesMerged/isSnpsMerged are set once entries from more than one reader are combined (list then needs sorting)
+void GFileManager::MergeData(GGenomicDataSet& data, const GGenomicDataSet& readerData, bool& isGenesMerged, bool& isSnpsMerged)
+{
+    // note - alignments are merged separately (see MergeAlignments())
+    if ( !readerData.Sequence.isEmpty() ) { data.Sequence = readerData.Sequence; }
+    if ( !readerData.Genes.isEmpty() ) {
+        isGenesMerged |= !data.Genes.isEmpty();
+        data.Genes += readerData.Genes;
+    }
+    if ( !readerData.Snps.isEmpty() ) {
+        isSnpsMerged |= !data.Snps.isEmpty();
+        data.Snps += readerData.Snps;
+    }
+    if ( data.Genotypes.IsEmpty() && !readerData.Genotypes.IsEmpty() ) { data.Genotypes = readerData.Genotypes; }
+}
+
+// merges readers' (position-sorted) alignment lists into single position-sorted list
+// uses k-way merge over min-heap of list cursors, so no full sort is needed
+void GFileManager::MergeAlignments(const QList<const GAlignmentList*>& lists, GAlignmentList& alignments)
+{
+    // nothing to merge for single list
+    if ( lists.size() == 1 ) {
+        alignments += *lists.first();
+        return;
+    }
+
+    // build heap with first alignment of each list
+    QVector<GAlignmentCursor> heap;
+    for ( int i = 0; i < lists.size(); ++i ) {
+        GAlignmentCursor cursor;
+        cursor.List  = i;
+        cursor.Index = 0;
+        heap.append(cursor);
+    }
+    for ( int i = (heap.size() / 2) - 1; i >= 0; --i ) { SiftDown(heap, i, lists); }
+
+    // repeatedly take first alignment, advance its list's cursor
+    while ( !heap.isEmpty() ) {
+        GAlignmentCursor& first = heap[0];
+        alignments.append( lists.at(first.List)->at(first.Index) );
+        if ( ++first.Index == lists.at(first.List)->size() ) {
+            heap[0] = heap.last();
+            heap.remove(heap.size() - 1);
+        }
+        if ( !heap.isEmpty() ) { SiftDown(heap, 0, lists); }
+    }
+}
+
+void GFileManager::SetGenotypesEnabled(bool ok)
+{
+    m_isGenotypesEnabled = ok;
+    foreach (GAbstractFormatManager* manager, m_managers) {
+        if ( manager ) { manager->SetGenotypesEnabled(ok); }
+    }
+}
+
+GFeatureNameList GFileManager::FindNames(const QString& prefix, int maxCount)
+{
+    // each file returns its own best matches
+    GFeatureNameList names;
+    foreach (GAbstractFormatManager* manager, m_managers) {
+        if ( manager ) { manager->FindNames(prefix, maxCount, names); }
+    }
+
+    // merge into single list, in name order
+    qStableSort(names.begin(), names.end(), FeatureNameLessThan);
+    while ( names.size() > maxCount ) { names.removeLast(); }
+    return names;
+}
+
 
 void GFileManager::Load(QDataStream& in, int version) {
     if ( version >= 100 ) {
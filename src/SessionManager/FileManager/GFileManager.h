@@ -24,6 +24,7 @@
 // This manager is currently responsible for all major file-related operations:
 //   - Opening/closing data files
 //   - Retrieving data from a specified region (from all open files)
+//   - Searching feature names (from all open files)
 //   - Serialization (saves list of currently open files)
 //   - Detecting/loading file format plugins
 // ***************************************************************************
@@ -32,10 +33,12 @@
 #define G_FILEMANAGER_H
 
 #include <QObject>
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GFileInfo.h"
 #include "DataStructures/GFileFormatData.h"
 #include "DataStructures/GGenomicDataSet.h"
 #include "DataStructures/GReference.h"
+#include "DataStructures/GReferenceDictionary.h"
 
 namespace Gambit {
 namespace FileIO {
@@ -63,6 +66,9 @@ class GFileManager : public QObject {
 
         // data access
         GGenomicDataSet LoadData(const GGenomicDataRegion& region);
+        GFeatureNameList FindNames(const QString& prefix, int maxCount);
+        // sets whether readers load per-sample genotypes (off while genotypes are not shown)
+        void SetGenotypesEnabled(bool ok);
 
         // file access
         void CloseAll(void);
@@ -74,6 +80,10 @@ class GFileManager : public QObject {
         bool IsModified(void) { return m_isModified; }
 
     private:
+        // data access
+        static void MergeData(GGenomicDataSet& data, const GGenomicDataSet& readerData, bool& isGenesMerged, bool& isSnpsMerged);
+        static void MergeAlignments(const QList<const GAlignmentList*>& lists, GAlignmentList& alignments);
+
         // plugin support
         void LoadPlugins(void);
         void SavePlugin(QObject* plugin);
@@ -86,7 +96,9 @@ class GFileManager : public QObject {
 
     private:
         bool m_isModified;
+        bool m_isGenotypesEnabled;
         QList<GAbstractFormatManager*> m_managers;
+        GReferenceDictionary m_referenceDictionary;
 };
 
 } // namespace FileIO
@@ -0,0 +1,606 @@
+// ***************************************************************************
+// GAnnotationStore.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// In-memory store of annotation (gene & SNP) data for a single file, built
+// once at open time. Entries are kept in compact, per-reference arrays sorted
+// by position: genes use an implicit interval tree (max-end augmentation over
+// the sorted array), SNPs use a simple binary search.
+//
+// A finalized store can be saved to a binary cache file (keyed by source file
+// path, size & timestamp), so later sessions can skip reparsing the source.
+// All entry arrays (and the string table) are stored raw & 8-byte aligned, and
+// a loaded store queries them in place from the memory-mapped cache file.
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtDebug>
+#include <cstring>
+#include "DataStructures/GGenomicDataRegion.h"
+#include "SessionManager/FileManager/TextIO/GAnnotationStore.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// files up to this size are loaded into memory
+const qint64 GAnnotationStore::MAX_FILE_SIZE = 64 * 1024 * 1024;
+
+// cache file identifiers
+// note - version must be bumped whenever entry layout (or how readers build entries) changes
+const quint32 GAnnotationStore::CACHE_MAGIC   = 0x47414301; // "GAC\1"
+const quint32 GAnnotationStore::CACHE_VERSION = 103;
+
+// cache is only valid on machines with same byte order
+static const quint32 CACHE_BYTE_ORDER = 0x01020304;
+
+// cache files are stored in user's home directory
+static const char* CACHE_DIRECTORY = ".gambit/cache";
+
+// sort helpers
+static inline
+bool GeneLessThan(const GAnnotationGene& lhs, const GAnnotationGene& rhs) {
+    return ( lhs.Start < rhs.Start );
+}
+
+static inline
+bool SnpLessThan(const GAnnotationSnp& lhs, const GAnnotationSnp& rhs) {
+    return ( lhs.Position < rhs.Position );
+}
+
+GAnnotationStore::GAnnotationStore(void)
+    : m_stringOffsets(0)
+    , m_stringData(0)
+    , m_stringCount(0)
+    , m_stringDataLength(0)
+    , m_cacheFile(0)
+    , m_cacheData(0)
+{ }
+
+GAnnotationStore::~GAnnotationStore(void) {
+    Clear();
+}
+
+void GAnnotationStore::AddGene(const QString& refName, const GGene& gene) {
+
+    ReferenceData& reference = Reference(refName);
+
+    // store compact gene entry
+    // note - zeroed so struct padding is deterministic in cache files
+    GAnnotationGene entry;
+    memset(&entry, 0, sizeof(GAnnotationGene));
+    entry.Start     = gene.Start;
+    entry.Stop      = gene.Stop;
+    entry.MaxStop   = gene.Stop;
+    entry.Name      = InternString(gene.Name);
+    entry.AuxInfo   = InternString(gene.AuxInfo);
+    entry.FirstExon = reference.BuiltExons.size();
+    entry.ExonCount = gene.Exons.size();
+    entry.Strand    = ( gene.Strand.isEmpty() ? '\0' : gene.Strand.at(0).toLatin1() );
+    reference.BuiltGenes.append(entry);
+
+    // store exons
+    foreach ( const GExon& exon, gene.Exons ) {
+        GAnnotationExon exonEntry;
+        exonEntry.Start = exon.Start;
+        exonEntry.Stop  = exon.Stop;
+        reference.BuiltExons.append(exonEntry);
+    }
+}
+
+void GAnnotationStore::AddSnp(const QString& refName, const GSnp& snp) {
+    GAnnotationSnp entry;
+    memset(&entry, 0, sizeof(GAnnotationSnp));
+    entry.Position = snp.Position;
+    entry.Name     = InternString(snp.Name);
+    entry.Score    = snp.Score;
+    Reference(refName).BuiltSnps.append(entry);
+}
+
+void GAnnotationStore::AddBatch(const GAnnotationBatch& batch) {
+    for ( int i = 0; i < batch.Genes.size(); ++i ) { AddGene(batch.Genes.at(i).first, batch.Genes.at(i).second); }
+    for ( int i = 0; i < batch.Snps.size();  ++i ) { AddSnp(batch.Snps.at(i).first,   batch.Snps.at(i).second);  }
+}
+
+void GAnnotationStore::Clear(void) {
+
+    // unmap any cache file
+    if ( m_cacheFile ) {
+        if ( m_cacheData ) { m_cacheFile->unmap(m_cacheData); }
+        m_cacheFile->close();
+        delete m_cacheFile;
+        m_cacheFile = 0;
+        m_cacheData = 0;
+    }
+
+    // clear data
+    m_references.clear();
+    m_referenceLookup.clear();
+    m_pendingStrings.clear();
+    m_stringLookup.clear();
+    m_builtStringOffsets.clear();
+    m_builtStringData.clear();
+    m_stringOffsets    = 0;
+    m_stringData       = 0;
+    m_stringCount      = 0;
+    m_stringDataLength = 0;
+}
+
+void GAnnotationStore::Finalize(void) {
+
+    // sort each reference's entries & build gene interval index
+    for ( int i = 0; i < m_references.size(); ++i ) {
+        ReferenceData& reference = m_references[i];
+        qStableSort(reference.BuiltGenes.begin(), reference.BuiltGenes.end(), GeneLessThan);
+        qStableSort(reference.BuiltSnps.begin(),  reference.BuiltSnps.end(),  SnpLessThan);
+        reference.MaxLevel = IndexGenes(reference.BuiltGenes);
+        reference.BuiltGenes.squeeze();
+        reference.BuiltExons.squeeze();
+        reference.BuiltSnps.squeeze();
+
+        // set current entries
+        reference.Genes     = reference.BuiltGenes.constData();
+        reference.Exons     = reference.BuiltExons.constData();
+        reference.Snps      = reference.BuiltSnps.constData();
+        reference.GeneCount = reference.BuiltGenes.size();
+        reference.ExonCount = reference.BuiltExons.size();
+        reference.SnpCount  = reference.BuiltSnps.size();
+    }
+
+    // flatten string table (same layout as cache file)
+    m_builtStringOffsets.clear();
+    m_builtStringOffsets.reserve(m_pendingStrings.size() + 1);
+    m_builtStringData.clear();
+    foreach ( const QString& s, m_pendingStrings ) {
+        m_builtStringOffsets.append(m_builtStringData.size());
+        m_builtStringData.append(s);
+    }
+    m_builtStringOffsets.append(m_builtStringData.size());
+
+    // pending strings & lookup table no longer needed once store is built
+    m_pendingStrings.clear();
+    m_stringLookup.clear();
+
+    // set current string table
+    m_stringOffsets    = m_builtStringOffsets.constData();
+    m_stringData       = m_builtStringData.constData();
+    m_stringCount      = m_builtStringOffsets.size() - 1;
+    m_stringDataLength = m_builtStringData.size();
+}
+
+GGeneList GAnnotationStore::Genes(const GGenomicDataRegion& region) const {
+
+    GGeneList genes;
+
+    // skip if no data for reference
+    const ReferenceData* reference = FindReference(region.RefName);
+    if ( (reference == 0) || (reference->MaxLevel < 0) ) { return genes; }
+    const GAnnotationGene* entries = reference->Genes;
+    const qint64 numEntries = reference->GeneCount;
+
+    // traverse implicit interval tree, looking for entries overlapping region
+    // (node at level k has its k lowest index bits set, its subtrees span +/- 2^(k-1))
+    // note - left subtree, node & right subtree are visited in that order, so hits come out sorted
+    struct StackItem { int Level; qint64 Index; bool IsLeftDone; };
+    StackItem stack[64];
+    int top = 0;
+    const StackItem root = { reference->MaxLevel, (Q_INT64_C(1) << reference->MaxLevel) - 1, false };
+    stack[top++] = root;
+
+    while ( top > 0 ) {
+        const StackItem item = stack[--top];
+
+        // small subtree - just scan it
+        if ( item.Level <= 3 ) {
+            const qint64 first = (item.Index >> item.Level) << item.Level;
+            qint64 last = first + (Q_INT64_C(1) << (item.Level + 1)) - 1;
+            if ( last > numEntries ) { last = numEntries; }
+            for ( qint64 i = first; (i < last) && (entries[i].Start <= region.RightBound); ++i ) {
+                const GAnnotationGene& entry = entries[i];
+                if ( (entry.Start >= region.LeftBound) && (entry.Stop <= region.RightBound) ) {
+                    genes.append( MakeGene(*reference, entry) );
+                }
+            }
+        }
+
+        // descend into left subtree, unless it ends before region
+        else if ( !item.IsLeftDone ) {
+            const qint64 left = item.Index - (Q_INT64_C(1) << (item.Level - 1));
+            const StackItem self = { item.Level, item.Index, true };
+            stack[top++] = self;
+            if ( (left >= numEntries) || (entries[left].MaxStop >= region.LeftBound) ) {
+                const StackItem child = { item.Level - 1, left, false };
+                stack[top++] = child;
+            }
+        }
+
+        // check node itself & descend into right subtree, unless node starts after region
+        else if ( (item.Index < numEntries) && (entries[item.Index].Start <= region.RightBound) ) {
+            const GAnnotationGene& entry = entries[item.Index];
+            if ( (entry.Start >= region.LeftBound) && (entry.Stop <= region.RightBound) ) {
+                genes.append( MakeGene(*reference, entry) );
+            }
+            const StackItem child = { item.Level - 1, item.Index + (Q_INT64_C(1) << (item.Level - 1)), false };
+            stack[top++] = child;
+        }
+    }
+
+    return genes;
+}
+
+GSnpList GAnnotationStore::Snps(const GGenomicDataRegion& region) const {
+
+    GSnpList snps;
+
+    // skip if no data for reference
+    const ReferenceData* reference = FindReference(region.RefName);
+    if ( reference == 0 ) { return snps; }
+
+    // find first SNP in region, then read until past region
+    GAnnotationSnp leftEntry;
+    leftEntry.Position = region.LeftBound;
+    const GAnnotationSnp* snpEnd  = reference->Snps + reference->SnpCount;
+    const GAnnotationSnp* snpIter = qLowerBound(reference->Snps, snpEnd, leftEntry, SnpLessThan);
+    for ( ; (snpIter != snpEnd) && (snpIter->Position <= region.RightBound); ++snpIter ) {
+        GSnp gSnp;
+        gSnp.Position = snpIter->Position;
+        gSnp.Name     = String(snpIter->Name);
+        gSnp.Score    = snpIter->Score;
+        snps.append(gSnp);
+    }
+
+    return snps;
+}
+
+bool GAnnotationStore::IsEmpty(void) const {
+    return m_references.isEmpty();
+}
+
+// ------------------------------------------
+// binary cache file support
+// ------------------------------------------
+
+namespace Gambit {
+namespace FileIO {
+
+// writes raw data to cache file, padding each block to 8 bytes
+class GCacheWriter {
+    public:
+        GCacheWriter(QIODevice* device) : m_device(device), m_isOk(true) { }
+        void Write(const void* data, qint64 length) {
+            if ( m_isOk && (length > 0) ) { m_isOk = ( m_device->write((const char*)data, length) == length ); }
+            static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+            const qint64 padLength = (8 - (length % 8)) % 8;
+            if ( m_isOk && (padLength > 0) ) { m_isOk = ( m_device->write(padding, padLength) == padLength ); }
+        }
+        void WriteValue(quint64 value) { Write(&value, sizeof(value)); }
+        void WriteString(const QString& s) {
+            WriteValue(s.size());
+            Write(s.constData(), s.size() * sizeof(QChar));
+        }
+        template<typename T> void WriteArray(const T* data, qint64 count) {
+            WriteValue(count);
+            Write(data, count * sizeof(T));
+        }
+        bool IsOk(void) const { return m_isOk; }
+    private:
+        QIODevice* m_device;
+        bool m_isOk;
+};
+
+// reads data blocks (as written by GCacheWriter) from mapped cache file
+class GCacheReader {
+    public:
+        GCacheReader(const uchar* data, qint64 size) : m_data(data), m_size(size), m_position(0), m_isOk(true) { }
+        const uchar* Read(qint64 length) {
+            const qint64 paddedLength = length + ((8 - (length % 8)) % 8);
+            if ( !m_isOk || (length < 0) || (paddedLength > (m_size - m_position)) ) {
+                m_isOk = false;
+                return 0;
+            }
+            const uchar* result = m_data + m_position;
+            m_position += paddedLength;
+            return result;
+        }
+        quint64 ReadValue(void) {
+            quint64 value = 0;
+            const uchar* data = Read(sizeof(value));
+            if ( data ) { memcpy(&value, data, sizeof(value)); }
+            return value;
+        }
+        QString ReadString(void) {
+            qint64 length = 0;
+            const QChar* data = ReadArray<QChar>(length);
+            if ( data == 0 ) { return QString(); }
+            return QString(data, length);
+        }
+        // returns array in place (blocks are 8-byte aligned, as is mapped data)
+        template<typename T> const T* ReadArray(qint64& count) {
+            count = (qint64)ReadValue();
+            const uchar* data = Read(count * (qint64)sizeof(T));
+            if ( data == 0 ) { count = 0; }
+            return (const T*)data;
+        }
+        bool IsOk(void) const { return m_isOk; }
+    private:
+        const uchar* m_data;
+        qint64 m_size;
+        qint64 m_position;
+        bool m_isOk;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+bool GAnnotationStore::Load(const QString& cacheFilename, const QString& dataFilename) {
+
+    // clear any existing data
+    Clear();
+
+    // open & map cache file
+    QFile* cacheFile = new QFile(cacheFilename);
+    if ( !cacheFile->exists() || !cacheFile->open(QIODevice::ReadOnly) ) {
+        delete cacheFile;
+        return false;
+    }
+    const qint64 cacheSize = cacheFile->size();
+    uchar* cacheData = cacheFile->map(0, cacheSize);
+    if ( cacheData == 0 ) {
+        delete cacheFile;
+        return false;
+    }
+    GCacheReader in(cacheData, cacheSize);
+
+    // read and validate 'magic number', version, byte order & entry layout
+    const quint32 magic     = (quint32)in.ReadValue();
+    const quint32 version   = (quint32)in.ReadValue();
+    const quint32 byteOrder = (quint32)in.ReadValue();
+    const quint64 geneSize  = in.ReadValue();
+    const quint64 exonSize  = in.ReadValue();
+    const quint64 snpSize   = in.ReadValue();
+    bool isValid = ( in.IsOk() &&
+                     (magic     == GAnnotationStore::CACHE_MAGIC)   &&
+                     (version   == GAnnotationStore::CACHE_VERSION) &&
+                     (byteOrder == CACHE_BYTE_ORDER)                &&
+                     (geneSize  == sizeof(GAnnotationGene))         &&
+                     (exonSize  == sizeof(GAnnotationExon))         &&
+                     (snpSize   == sizeof(GAnnotationSnp)) );
+
+    // make sure cache is not stale
+    if ( isValid ) {
+        const QFileInfo dataInfo(dataFilename);
+        const qint64  fileSize     = (qint64)in.ReadValue();
+        const quint32 fileModified = (quint32)in.ReadValue();
+        const QString filePath     = in.ReadString();
+        isValid = ( in.IsOk() &&
+                    (fileSize     == dataInfo.size()) &&
+                    (fileModified == dataInfo.lastModified().toTime_t()) &&
+                    (filePath     == dataInfo.absoluteFilePath()) );
+    }
+
+    // point to data in mapped file
+    if ( isValid ) {
+
+        // string table
+        qint64 numOffsets = 0;
+        qint64 dataLength = 0;
+        m_stringOffsets = in.ReadArray<quint64>(numOffsets);
+        m_stringData    = in.ReadArray<QChar>(dataLength);
+        if ( (numOffsets > 0) && (m_stringOffsets[numOffsets - 1] == (quint64)dataLength) ) {
+            m_stringCount      = numOffsets - 1;
+            m_stringDataLength = dataLength;
+        } else { isValid = false; }
+
+        // references
+        const qint64 numReferences = (qint64)in.ReadValue();
+        for ( qint64 i = 0; (i < numReferences) && in.IsOk(); ++i ) {
+            ReferenceData& reference = Reference( in.ReadString() );
+            reference.MaxLevel = (int)(qint64)in.ReadValue();
+            reference.Genes    = in.ReadArray<GAnnotationGene>(reference.GeneCount);
+            reference.Exons    = in.ReadArray<GAnnotationExon>(reference.ExonCount);
+            reference.Snps     = in.ReadArray<GAnnotationSnp>(reference.SnpCount);
+            if ( reference.MaxLevel >= 62 ) { isValid = false; } // query stack depth
+        }
+
+        // check for any read errors
+        if ( !in.IsOk() || !isValid ) {
+            qDebug() << "GAnnotationStore::Load() => corrupt cache file:" << cacheFilename;
+            isValid = false;
+        }
+    }
+
+    // clean up if cache not usable
+    if ( !isValid ) {
+        cacheFile->unmap(cacheData);
+        cacheFile->close();
+        delete cacheFile;
+        Clear();
+        return false;
+    }
+
+    // keep file mapped until cleared
+    m_cacheFile = cacheFile;
+    m_cacheData = cacheData;
+    return true;
+}
+
+bool GAnnotationStore::Save(const QString& cacheFilename, const QString& dataFilename) const {
+
+    // make sure cache directory exists
+    const QFileInfo cacheInfo(cacheFilename);
+    if ( !QDir().mkpath(cacheInfo.absolutePath()) ) { return false; }
+
+    // write to temp file first, so that other sessions never see partial cache files
+    const QString tempFilename = cacheFilename + ".tmp";
+    QFile cacheFile(tempFilename);
+    if ( !cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ) {
+        qDebug() << "GAnnotationStore::Save() => could not open cache file:" << tempFilename;
+        return false;
+    }
+    GCacheWriter out(&cacheFile);
+
+    // write header
+    const QFileInfo dataInfo(dataFilename);
+    out.WriteValue(GAnnotationStore::CACHE_MAGIC);
+    out.WriteValue(GAnnotationStore::CACHE_VERSION);
+    out.WriteValue(CACHE_BYTE_ORDER);
+    out.WriteValue(sizeof(GAnnotationGene));
+    out.WriteValue(sizeof(GAnnotationExon));
+    out.WriteValue(sizeof(GAnnotationSnp));
+    out.WriteValue(dataInfo.size());
+    out.WriteValue(dataInfo.lastModified().toTime_t());
+    out.WriteString(dataInfo.absoluteFilePath());
+
+    // write string table
+    out.WriteArray(m_stringOffsets, (qint64)m_stringCount + 1);
+    out.WriteArray(m_stringData, (qint64)m_stringDataLength);
+
+    // write references (in index order)
+    QVector<QString> referenceNames(m_references.size());
+    QHash<QString, int>::const_iterator refIter = m_referenceLookup.constBegin();
+    QHash<QString, int>::const_iterator refEnd  = m_referenceLookup.constEnd();
+    for ( ; refIter != refEnd; ++refIter ) { referenceNames[refIter.value()] = refIter.key(); }
+
+    out.WriteValue(m_references.size());
+    for ( int i = 0; i < m_references.size(); ++i ) {
+        const ReferenceData& reference = m_references.at(i);
+        out.WriteString(referenceNames.at(i));
+        out.WriteValue((qint64)reference.MaxLevel);
+        out.WriteArray(reference.Genes, reference.GeneCount);
+        out.WriteArray(reference.Exons, reference.ExonCount);
+        out.WriteArray(reference.Snps,  reference.SnpCount);
+    }
+    cacheFile.close();
+
+    // check for write errors
+    if ( !out.IsOk() || (cacheFile.error() != QFile::NoError) ) {
+        qDebug() << "GAnnotationStore::Save() => could not write cache file:" << tempFilename;
+        QFile::remove(tempFilename);
+        return false;
+    }
+
+    // replace any existing cache file
+    QFile::remove(cacheFilename);
+    return QFile::rename(tempFilename, cacheFilename);
+}
+
+QString GAnnotationStore::CacheFilename(const QString& dataFilename, int contentType, const QString& extension) {
+    const QString path = QFileInfo(dataFilename).absoluteFilePath();
+    const QByteArray key = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QDir(QDir::homePath()).filePath( QString("%1/%2-%3%4").arg(CACHE_DIRECTORY)
+                                                                 .arg(QString::fromLatin1(key))
+                                                                 .arg(contentType)
+                                                                 .arg(extension) );
+}
+
+// builds max-end augmentation over position-sorted genes, returns tree's max level (-1 if empty)
+int GAnnotationStore::IndexGenes(QVector<GAnnotationGene>& genes) {
+
+    const qint64 numEntries = genes.size();
+    if ( numEntries == 0 ) { return -1; }
+
+    // leaves (even indexes)
+    qint64 lastIndex = 0;
+    qint32 lastMax   = 0;
+    for ( qint64 i = 0; i < numEntries; i += 2 ) {
+        lastIndex = i;
+        lastMax   = genes[i].MaxStop = genes[i].Stop;
+    }
+
+    // internal nodes, one level at a time
+    int level = 1;
+    for ( ; (Q_INT64_C(1) << level) <= numEntries; ++level ) {
+        const qint64 offset = Q_INT64_C(1) << (level - 1);
+        const qint64 first  = (offset << 1) - 1;
+        const qint64 step   = offset << 2;
+        for ( qint64 i = first; i < numEntries; i += step ) {
+            const qint32 leftMax  = genes.at(i - offset).MaxStop;
+            const qint32 rightMax = ( (i + offset) < numEntries ? genes.at(i + offset).MaxStop : lastMax );
+            genes[i].MaxStop = qMax(genes.at(i).Stop, qMax(leftMax, rightMax));
+        }
+
+        // track max for last node at this level (fills in for missing right subtrees)
+        lastIndex = ( ((lastIndex >> level) & 1) ? (lastIndex - offset) : (lastIndex + offset) );
+        if ( (lastIndex < numEntries) && (genes.at(lastIndex).MaxStop > lastMax) ) {
+            lastMax = genes.at(lastIndex).MaxStop;
+        }
+    }
+    return level - 1;
+}
+
+GGene GAnnotationStore::MakeGene(const ReferenceData& reference, const GAnnotationGene& entry) const {
+
+    // restore gene data
+    GGene gGene;
+    gGene.Name    = String(entry.Name);
+    gGene.AuxInfo = String(entry.AuxInfo);
+    gGene.Start   = entry.Start;
+    gGene.Stop    = entry.Stop;
+    if ( entry.Strand != '\0' ) { gGene.Strand = QString(QChar::fromLatin1(entry.Strand)); }
+
+    // restore exons
+    const qint64 lastExon = qMin((qint64)entry.FirstExon + entry.ExonCount, reference.ExonCount);
+    for ( qint64 i = qMax(0, entry.FirstExon); i < lastExon; ++i ) {
+        const GAnnotationExon& exonEntry = reference.Exons[i];
+        GExon gExon;
+        gExon.Start = exonEntry.Start;
+        gExon.Stop  = exonEntry.Stop;
+        gGene.Exons.append(gExon);
+    }
+    return gGene;
+}
+
+GAnnotationStore::ReferenceData& GAnnotationStore::Reference(const QString& refName) {
+
+    // return existing entry if found
+    QHash<QString, int>::const_iterator refIter = m_referenceLookup.constFind(refName);
+    if ( refIter != m_referenceLookup.constEnd() ) { return m_references[refIter.value()]; }
+
+    // otherwise create new entry
+    m_referenceLookup.insert(refName, m_references.size());
+    m_references.append( ReferenceData() );
+    return m_references.last();
+}
+
+const GAnnotationStore::ReferenceData* GAnnotationStore::FindReference(const QString& refName) const {
+    QHash<QString, int>::const_iterator refIter = m_referenceLookup.constFind(refName);
+    if ( refIter == m_referenceLookup.constEnd() ) { return 0; }
+    return &m_references.at(refIter.value());
+}
+
+quint32 GAnnotationStore::InternString(const QString& s) {
+
+    // return existing index if found
+    QHash<QString, quint32>::const_iterator stringIter = m_stringLookup.constFind(s);
+    if ( stringIter != m_stringLookup.constEnd() ) { return stringIter.value(); }
+
+    // otherwise store new string
+    const quint32 index = (quint32)m_pendingStrings.size();
+    m_pendingStrings.append(s);
+    m_stringLookup.insert(s, index);
+    return index;
+}
+
+// note - offsets are checked, since mapped cache data is only validated as a whole
+QString GAnnotationStore::String(quint32 index) const {
+    if ( index >= m_stringCount ) { return QString(); }
+    const quint64 begin = m_stringOffsets[index];
+    const quint64 end   = m_stringOffsets[index + 1];
+    if ( (begin > end) || (end > m_stringDataLength) ) { return QString(); }
+    return QString(m_stringData + begin, (int)(end - begin));
+}
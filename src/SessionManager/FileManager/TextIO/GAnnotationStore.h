@@ -0,0 +1,188 @@
+// ***************************************************************************
+// GAnnotationStore.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// In-memory store of annotation (gene & SNP) data for a single file, built
+// once at open time. Entries are kept in compact, per-reference arrays sorted
+// by position: genes use an implicit interval tree (max-end augmentation over
+// the sorted array), SNPs use a simple binary search.
+//
+// A finalized store can be saved to a binary cache file (keyed by source file
+// path, size & timestamp), so later sessions can skip reparsing the source.
+// All entry arrays (and the string table) are stored raw & 8-byte aligned, and
+// a loaded store queries them in place from the memory-mapped cache file.
+// ***************************************************************************
+
+#ifndef G_ANNOTATIONSTORE_H
+#define G_ANNOTATIONSTORE_H
+
+#include <QHash>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+#include "DataStructures/GGene.h"
+#include "DataStructures/GSnp.h"
+class QFile;
+
+namespace Gambit {
+
+struct GGenomicDataRegion;
+
+namespace FileIO {
+
+// compact gene entry (strings are indexes into store's string table)
+struct GAnnotationGene {
+    qint32  Start;
+    qint32  Stop;
+    qint32  MaxStop;    // max Stop in this entry's (implicit) subtree
+    quint32 Name;
+    quint32 AuxInfo;
+    qint32  FirstExon;
+    qint32  ExonCount;
+    char    Strand;
+};
+
+// compact exon entry
+struct GAnnotationExon {
+    qint32 Start;
+    qint32 Stop;
+};
+
+// compact SNP entry
+struct GAnnotationSnp {
+    qint32  Position;
+    quint32 Name;
+    double  Score;
+};
+
+// entries parsed from one part of a file, in file order (see GParallelTextParser)
+struct GAnnotationBatch {
+    QVector< QPair<QString, GGene> > Genes;
+    QVector< QPair<QString, GSnp> >  Snps;
+};
+
+class GAnnotationStore {
+
+    // constructor/destructor
+    public:
+        GAnnotationStore(void);
+        ~GAnnotationStore(void);
+
+    // building store
+    public:
+        // stores gene/SNP entry (Gambit coordinates)
+        void AddGene(const QString& refName, const GGene& gene);
+        void AddSnp(const QString& refName, const GSnp& snp);
+        // stores all entries from batch
+        void AddBatch(const GAnnotationBatch& batch);
+        // clears all data (and unmaps any cache file)
+        void Clear(void);
+        // sorts & indexes data, must be called after all entries are added
+        void Finalize(void);
+
+    // data access
+    public:
+        // returns entries contained in region, in position order
+        GGeneList Genes(const GGenomicDataRegion& region) const;
+        GSnpList  Snps(const GGenomicDataRegion& region) const;
+        // returns whether any entries are stored
+        bool IsEmpty(void) const;
+
+    // binary cache
+    public:
+        // maps cache file, fails if cache is stale (or from another source file)
+        bool Load(const QString& cacheFilename, const QString& dataFilename);
+        // saves (finalized) store to cache file
+        bool Save(const QString& cacheFilename, const QString& dataFilename) const;
+        // returns cache filename for source data file (content type distinguishes e.g. BED genes vs SNPs)
+        // note - extension lets other per-file caches (e.g. GNameIndex) share the same naming
+        static QString CacheFilename(const QString& dataFilename, int contentType, const QString& extension = ".gac");
+
+    // file size limit for using a store (larger files are queried directly from disk)
+    // note - also limits building name indexes in memory (larger files' names are sorted on disk)
+    public:
+        static const qint64 MAX_FILE_SIZE;
+
+    // cache file identifiers
+    private:
+        static const quint32 CACHE_MAGIC;
+        static const quint32 CACHE_VERSION;
+
+    // per-reference entries
+    private:
+        struct ReferenceData {
+
+            // entries added since last Finalize() (empty if mapped from cache file)
+            QVector<GAnnotationGene> BuiltGenes;
+            QVector<GAnnotationExon> BuiltExons;
+            QVector<GAnnotationSnp>  BuiltSnps;
+
+            // current entries - either built vectors, or mapped from cache file
+            const GAnnotationGene* Genes;
+            const GAnnotationExon* Exons;
+            const GAnnotationSnp*  Snps;
+            qint64 GeneCount;
+            qint64 ExonCount;
+            qint64 SnpCount;
+            int    MaxLevel;
+
+            ReferenceData(void)
+                : Genes(0), Exons(0), Snps(0)
+                , GeneCount(0), ExonCount(0), SnpCount(0)
+                , MaxLevel(-1)
+            { }
+        };
+
+    // 'internal' methods
+    private:
+        ReferenceData& Reference(const QString& refName);
+        const ReferenceData* FindReference(const QString& refName) const;
+        GGene MakeGene(const ReferenceData& reference, const GAnnotationGene& entry) const;
+        quint32 InternString(const QString& s);
+        QString String(quint32 index) const;
+        static int IndexGenes(QVector<GAnnotationGene>& genes);
+
+    // data members
+    private:
+        QVector<ReferenceData> m_references;
+        QHash<QString, int>    m_referenceLookup;
+
+        // interned strings (names, aux info), added since last Finalize()
+        QStringList             m_pendingStrings;
+        QHash<QString, quint32> m_stringLookup;
+
+        // finalized string table (string i is UTF-16 data between offsets i & i+1)
+        // either built in memory, or mapped from cache file
+        QVector<quint64> m_builtStringOffsets;
+        QString          m_builtStringData;
+        const quint64*   m_stringOffsets;
+        const QChar*     m_stringData;
+        quint64          m_stringCount;
+        quint64          m_stringDataLength;
+
+        // mapped cache file (see Load())
+        QFile* m_cacheFile;
+        uchar* m_cacheData;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_ANNOTATIONSTORE_H
@@ -0,0 +1,215 @@
+// ***************************************************************************
+// GFieldTokenizer.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Provides allocation-free access to delimited fields within a line buffer.
+// Fields are located lazily (only up to the highest column requested) and
+// returned as views into the buffer, with fast numeric conversion.
+// ***************************************************************************
+
+#include <QtCore>
+#include <climits>
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// powers of ten exactly representable as doubles
+static const double EXACT_POWERS_OF_TEN[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MAX_EXACT_POWER    = 22;
+static const int MAX_EXACT_DIGITS   = 15; // mantissa digits that always fit in a double exactly
+
+static inline
+bool IsDigit(char c) { return ( (c >= '0') && (c <= '9') ); }
+
+// ------------------------------------------
+// GFieldView implementation
+// ------------------------------------------
+
+qint32 GFieldView::ToInt(bool* ok) const {
+
+    const GFieldView field = Trimmed();
+    const char* data = field.Data;
+    const char* end  = data + field.Length;
+
+    // optional sign
+    bool isNegative = false;
+    if ( (data != end) && ((*data == '-') || (*data == '+')) ) {
+        isNegative = ( *data == '-' );
+        ++data;
+    }
+
+    // digits (fail on empty, overflow or any other characters)
+    qint64 value = 0;
+    const bool hasDigits = ( data != end );
+    for ( ; data != end; ++data ) {
+        if ( !IsDigit(*data) ) { break; }
+        value = (value * 10) + (*data - '0');
+        if ( value > Q_INT64_C(2147483648) ) { break; }
+    }
+    if ( isNegative ) { value = -value; }
+    const bool isValid = ( hasDigits && (data == end) && (value >= INT_MIN) && (value <= INT_MAX) );
+
+    if ( ok ) { *ok = isValid; }
+    return ( isValid ? (qint32)value : 0 );
+}
+
+double GFieldView::ToDouble(bool* ok) const {
+
+    const GFieldView field = Trimmed();
+    const char* data = field.Data;
+    const char* end  = data + field.Length;
+
+    // optional sign
+    bool isNegative = false;
+    if ( (data != end) && ((*data == '-') || (*data == '+')) ) {
+        isNegative = ( *data == '-' );
+        ++data;
+    }
+
+    // mantissa digits, with optional decimal point
+    quint64 mantissa   = 0;
+    int     numDigits  = 0;
+    int     exponent   = 0;
+    bool    hasDigits  = false;
+    for ( ; (data != end) && IsDigit(*data); ++data ) {
+        hasDigits = true;
+        if ( (mantissa == 0) && (*data == '0') ) { continue; }
+        mantissa = (mantissa * 10) + (*data - '0');
+        ++numDigits;
+    }
+    if ( (data != end) && (*data == '.') ) {
+        for ( ++data; (data != end) && IsDigit(*data); ++data ) {
+            hasDigits = true;
+            if ( (mantissa == 0) && (*data == '0') ) { --exponent; continue; }
+            mantissa = (mantissa * 10) + (*data - '0');
+            ++numDigits;
+            --exponent;
+        }
+    }
+
+    // optional exponent
+    if ( hasDigits && (data != end) && ((*data == 'e') || (*data == 'E')) ) {
+        ++data;
+        bool isExponentNegative = false;
+        if ( (data != end) && ((*data == '-') || (*data == '+')) ) {
+            isExponentNegative = ( *data == '-' );
+            ++data;
+        }
+        int value = 0;
+        bool hasExponentDigits = false;
+        for ( ; (data != end) && IsDigit(*data); ++data ) {
+            hasExponentDigits = true;
+            if ( value < 10000 ) { value = (value * 10) + (*data - '0'); }
+        }
+        if ( !hasExponentDigits ) { hasDigits = false; }
+        exponent += ( isExponentNegative ? -value : value );
+    }
+
+    // fail on anything unparsed (e.g. "." for missing values)
+    if ( !hasDigits || (data != end) ) {
+        if ( ok ) { *ok = false; }
+        return 0.0;
+    }
+
+    // fast path - result is exact (correctly rounded) when both mantissa & power of ten are exact
+    if ( (numDigits <= MAX_EXACT_DIGITS) && (qAbs(exponent) <= MAX_EXACT_POWER) ) {
+        double value = (double)mantissa;
+        if ( exponent < 0 ) { value /= EXACT_POWERS_OF_TEN[-exponent]; }
+        else                { value *= EXACT_POWERS_OF_TEN[exponent];  }
+        if ( ok ) { *ok = true; }
+        return ( isNegative ? -value : value );
+    }
+
+    // otherwise fall back to full conversion
+    return field.ToByteArray().toDouble(ok);
+}
+
+GFieldView GFieldView::Trimmed(void) const {
+    const char* data = Data;
+    int length = Length;
+    while ( (length > 0) && ((*data == ' ') || (*data == '\t') || (*data == '\r') || (*data == '\n')) ) { ++data; --length; }
+    while ( (length > 0) && ((data[length-1] == ' ') || (data[length-1] == '\t') || (data[length-1] == '\r') || (data[length-1] == '\n')) ) { --length; }
+    return GFieldView(data, length);
+}
+
+// ------------------------------------------
+// GFieldTokenizer implementation
+// ------------------------------------------
+
+GFieldTokenizer::GFieldTokenizer(char delimiter)
+    : m_line(0)
+    , m_length(0)
+    , m_position(0)
+    , m_isDone(true)
+    , m_delimiter(delimiter)
+{ }
+
+GFieldTokenizer::~GFieldTokenizer(void) { }
+
+void GFieldTokenizer::SetLine(const char* data, int length) {
+
+    // ignore trailing newline(s)
+    while ( (length > 0) && ((data[length-1] == '\n') || (data[length-1] == '\r')) ) { --length; }
+
+    // reset tokenizer state (keeps field storage capacity)
+    m_line     = data;
+    m_length   = length;
+    m_position = 0;
+    m_isDone   = ( data == 0 );
+    m_fields.resize(0);
+}
+
+void GFieldTokenizer::SetLine(const QByteArray& line) {
+    SetLine(line.constData(), line.size());
+}
+
+void GFieldTokenizer::SetLine(const GFieldView& line) {
+    SetLine(line.Data, line.Length);
+}
+
+int GFieldTokenizer::Count(void) {
+    TokenizeTo(INT_MAX);
+    return m_fields.size();
+}
+
+// locates fields up to requested column, returns true if column exists
+bool GFieldTokenizer::TokenizeTo(int column) {
+
+    while ( !m_isDone && (m_fields.size() <= column) ) {
+
+        // find end of current field
+        const char* fieldStart = m_line + m_position;
+        const char* delimiter  = (const char*)memchr(fieldStart, m_delimiter, m_length - m_position);
+
+        // store field
+        if ( delimiter ) {
+            m_fields.append( GFieldView(fieldStart, delimiter - fieldStart) );
+            m_position = (delimiter - m_line) + 1;
+        } else {
+            m_fields.append( GFieldView(fieldStart, m_length - m_position) );
+            m_position = m_length;
+            m_isDone   = true;
+        }
+    }
+    return ( column < m_fields.size() );
+}
@@ -0,0 +1,112 @@
+// ***************************************************************************
+// GFieldTokenizer.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Provides allocation-free access to delimited fields within a line buffer.
+// Fields are located lazily (only up to the highest column requested) and
+// returned as views into the buffer, with fast numeric conversion.
+// ***************************************************************************
+
+#ifndef G_FIELDTOKENIZER_H
+#define G_FIELDTOKENIZER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVarLengthArray>
+#include <cstring>
+
+namespace Gambit {
+namespace FileIO {
+
+// non-owning view of a single field
+// note - only valid while the underlying line buffer is unchanged
+struct GFieldView {
+
+    // data members
+    const char* Data;
+    int         Length;
+
+    // constructor
+    GFieldView(const char* data = 0, int length = 0)
+        : Data(data)
+        , Length(length)
+    { }
+
+    // comparison
+    bool IsEmpty(void) const { return ( Length == 0 ); }
+    bool operator==(const QByteArray& other) const {
+        return ( (Length == other.size()) && (memcmp(Data, other.constData(), Length) == 0) );
+    }
+    bool operator!=(const QByteArray& other) const { return !(*this == other); }
+
+    // conversion
+    QByteArray ToByteArray(void) const { return QByteArray(Data, Length); }
+    QString    ToString(void) const    { return QString::fromLatin1(Data, Length); }
+    qint32     ToInt(bool* ok = 0) const;
+    double     ToDouble(bool* ok = 0) const;
+    GFieldView Trimmed(void) const;
+};
+
+class GFieldTokenizer {
+
+    // constructor/destructor
+    public:
+        GFieldTokenizer(char delimiter = '\t');
+        ~GFieldTokenizer(void);
+
+    // tokenizer interface
+    public:
+        // sets line to tokenize (trailing newline characters are ignored)
+        void SetLine(const char* data, int length);
+        void SetLine(const QByteArray& line);
+        void SetLine(const GFieldView& line);
+        // returns field at (0-based) column, or empty view if line has no such column
+        GFieldView Field(int column);
+        // returns number of fields in line
+        int Count(void);
+        // returns line data
+        const char* Line(void) const { return m_line; }
+        int LineLength(void) const { return m_length; }
+
+    // 'internal' methods
+    private:
+        bool TokenizeTo(int column);
+
+    // data members
+    private:
+        const char* m_line;
+        int         m_length;
+        int         m_position;
+        bool        m_isDone;
+        char        m_delimiter;
+        QVarLengthArray<GFieldView, 16> m_fields;
+};
+
+inline
+GFieldView GFieldTokenizer::Field(int column) {
+    if ( column < 0 ) { return GFieldView(); }
+    if ( (column < m_fields.size()) || TokenizeTo(column) ) { return m_fields[column]; }
+    return GFieldView();
+}
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_FIELDTOKENIZER_H
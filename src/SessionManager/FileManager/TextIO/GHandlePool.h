@@ -0,0 +1,122 @@
+// ***************************************************************************
+// GHandlePool.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Pool of file handles for a single open file, so that concurrent queries never
+// share a seek position. Handles are created on demand (up to a per-file limit)
+// and reused afterwards; any parsed index stays with the file's main handle and
+// is shared read-only by all pooled handles.
+// ***************************************************************************
+
+#ifndef G_HANDLEPOOL_H
+#define G_HANDLEPOOL_H
+
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+namespace Gambit {
+namespace FileIO {
+
+template<typename Handle>
+class GHandlePool {
+
+    // constructor/destructor
+    public:
+        GHandlePool(int maxHandles = 0)
+            : m_maxHandles( (maxHandles > 0) ? maxHandles : qMax(2, QThread::idealThreadCount()) )
+            , m_handleCount(0)
+        { }
+        ~GHandlePool(void) { Clear(); }
+
+    // pool interface
+    public:
+        // returns idle handle, or 0 if caller should create a new one (pool slot is reserved for it)
+        // note - blocks while all handles are in use & handle limit is reached
+        Handle* Acquire(void) {
+            QMutexLocker locker(&m_mutex);
+            while ( m_idleHandles.isEmpty() && (m_handleCount >= m_maxHandles) ) { m_released.wait(&m_mutex); }
+            if ( !m_idleHandles.isEmpty() ) { return m_idleHandles.takeLast(); }
+            ++m_handleCount;
+            return 0;
+        }
+        // returns handle to pool (pool takes ownership of newly-created handles)
+        // note - releasing 0 frees slot reserved by Acquire(), if handle could not be created
+        void Release(Handle* handle) {
+            QMutexLocker locker(&m_mutex);
+            if ( handle ) { m_idleHandles.append(handle); }
+            else { --m_handleCount; }
+            m_released.wakeOne();
+        }
+        // waits until all handles are returned, then deletes them
+        void Clear(void) {
+            QMutexLocker locker(&m_mutex);
+            while ( m_idleHandles.size() < m_handleCount ) { m_released.wait(&m_mutex); }
+            qDeleteAll(m_idleHandles);
+            m_idleHandles.clear();
+            m_handleCount = 0;
+        }
+
+    // data members
+    private:
+        QMutex         m_mutex;
+        QWaitCondition m_released;
+        QList<Handle*> m_idleHandles;
+        int            m_maxHandles;
+        int            m_handleCount;
+};
+
+// acquires pooled handle for current scope, returning it to pool when done
+template<typename Handle>
+class GPooledHandle {
+
+    // constructor/destructor
+    public:
+        GPooledHandle(GHandlePool<Handle>& pool)
+            : m_pool(pool)
+            , m_handle(pool.Acquire())
+        { }
+        ~GPooledHandle(void) { m_pool.Release(m_handle); }
+
+    // handle access
+    public:
+        // returns true if no handle available (call Set() with newly-created handle)
+        bool IsNull(void) const { return ( m_handle == 0 ); }
+        // stores newly-created handle (may be 0, if creation failed)
+        void Set(Handle* handle) { m_handle = handle; }
+        Handle* Get(void) const { return m_handle; }
+        Handle* operator->(void) const { return m_handle; }
+
+    // not copyable
+    private:
+        GPooledHandle(const GPooledHandle&);
+        GPooledHandle& operator=(const GPooledHandle&);
+
+    // data members
+    private:
+        GHandlePool<Handle>& m_pool;
+        Handle*              m_handle;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_HANDLEPOOL_H
@@ -0,0 +1,445 @@
+// ***************************************************************************
+// GIndexedTextFile.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Provides region-based line access to tab-delimited text files, using a
+// GTextIndex to seek directly to lines overlapping the requested region.
+// ***************************************************************************
+
+#include <QtCore>
+#include <climits>
+#include <QtDebug>
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+#include "SessionManager/FileManager/TextIO/GIndexedTextFile.h"
+#include "SessionManager/FileManager/FormatManagerPlugins/GBamFormatManager/BGZF.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+struct GIndexedTextFile::GIndexedTextFilePrivate {
+
+    // data members
+    QFile              File;
+    BamTools::BgzfData Bgzf;
+    GTextIndex         Index;
+    QString            Filename;
+    bool               IsOpen;
+    bool               IsCompressed;
+    bool               IsIndexReady;
+
+    // index owned by another handle on same file (see Clone()), read-only
+    const GTextIndex* SharedIndex;
+
+    // mapped file data (see MapData())
+    uchar* MappedData;
+
+    // line buffer (reused between lines)
+    QByteArray Buffer;
+    int        BufferLength;
+
+    // current region data (0-based, half-open)
+    QByteArray          RefName;
+    qint32              Begin;
+    qint32              End;
+    GTextIndexChunkList Chunks;
+    int                 CurrentChunk;
+    bool                IsRegionDone;
+
+    // constructor
+    GIndexedTextFilePrivate(const GTextIndexFormat& format)
+        : Index(format)
+        , IsOpen(false)
+        , IsCompressed(false)
+        , IsIndexReady(false)
+        , SharedIndex(0)
+        , MappedData(0)
+        , BufferLength(0)
+        , Begin(0)
+        , End(0)
+        , CurrentChunk(0)
+        , IsRegionDone(true)
+    { }
+    ~GIndexedTextFilePrivate(void) { Close(); }
+
+    // 'private' interface
+    void Close(void);
+    bool Open(const QString& filename);
+    bool OpenClone(const GIndexedTextFilePrivate& source);
+    bool BuildIndex(GTextLineVisitor* visitor);
+    const GTextIndex& CurrentIndex(void) const { return ( SharedIndex ? *SharedIndex : Index ); }
+    bool ReadHeader(QList<QByteArray>& lines);
+    bool SetRegion(const QString& refName, qint32 left, qint32 right);
+    bool SetReference(const QString& refName);
+    bool GetNextLine(GFieldTokenizer& fields);
+    const char* MapData(qint64& size);
+    void UnmapData(void);
+
+    // used internally for (plain or BGZF-compressed) file access
+    private:
+        bool OpenCompressed(const QString& filename);
+        bool OpenPlain(const QString& filename);
+        bool ReadLine(void);
+        bool Seek(qint64 offset);
+        qint64 Tell(void);
+};
+
+// ------------------------------------------
+// GIndexedTextFile implementation
+// ------------------------------------------
+
+GIndexedTextFile::GIndexedTextFile(const GTextIndexFormat& format) {
+    d = new GIndexedTextFilePrivate(format);
+}
+
+GIndexedTextFile::~GIndexedTextFile(void) {
+    delete d;
+    d = 0;
+}
+
+void GIndexedTextFile::Close(void)                  { d->Close(); }
+bool GIndexedTextFile::IsOpen(void) const           { return d->IsOpen; }
+bool GIndexedTextFile::Open(const QString& filename) { return d->Open(filename); }
+const GTextIndex& GIndexedTextFile::Index(void) const { return d->CurrentIndex(); }
+bool GIndexedTextFile::IsIndexReady(void) const     { return d->IsIndexReady; }
+bool GIndexedTextFile::BuildIndex(GTextLineVisitor* visitor) { return d->BuildIndex(visitor); }
+
+GIndexedTextFile* GIndexedTextFile::Clone(void) const {
+
+    // skip if not open, or index not ready
+    if ( !d->IsOpen || !d->IsIndexReady ) { return 0; }
+
+    // open new handle
+    GIndexedTextFile* clone = new GIndexedTextFile( d->CurrentIndex().Format() );
+    if ( !clone->d->OpenClone(*d) ) {
+        delete clone;
+        return 0;
+    }
+    return clone;
+}
+
+const char* GIndexedTextFile::MapData(qint64& size) {
+    return d->MapData(size);
+}
+
+void GIndexedTextFile::UnmapData(void) {
+    d->UnmapData();
+}
+
+bool GIndexedTextFile::ReadHeader(QList<QByteArray>& lines) {
+    return d->ReadHeader(lines);
+}
+
+bool GIndexedTextFile::SetRegion(const QString& refName, qint32 left, qint32 right) {
+    return d->SetRegion(refName, left, right);
+}
+
+bool GIndexedTextFile::SetReference(const QString& refName) {
+    return d->SetReference(refName);
+}
+
+bool GIndexedTextFile::GetNextLine(GFieldTokenizer& fields) {
+    return d->GetNextLine(fields);
+}
+
+// ------------------------------------------
+// GIndexedTextFilePrivate implementation
+// ------------------------------------------
+
+void GIndexedTextFile::GIndexedTextFilePrivate::Close(void) {
+    UnmapData();
+    File.close();
+    Bgzf.Close();
+    IsCompressed = false;
+    IsIndexReady = false;
+    Index.Clear();
+    SharedIndex = 0;
+    Filename.clear();
+    Chunks.clear();
+    IsRegionDone = true;
+    IsOpen = false;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::Open(const QString& filename) {
+
+    // skip if already open
+    if ( IsOpen ) { return false; }
+
+    // open data file, bgzipped files ('.gz') require a tabix index
+    if ( filename.endsWith(".gz", Qt::CaseInsensitive) ) { IsOpen = OpenCompressed(filename); }
+    else { IsOpen = OpenPlain(filename); }
+    if ( IsOpen ) { Filename = filename; }
+    return IsOpen;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::OpenClone(const GIndexedTextFilePrivate& source) {
+
+    // skip if already open
+    if ( IsOpen ) { return false; }
+
+    // open own stream on source's data file (index is not reloaded)
+    // note - must not exit on failure (clones are opened on worker threads, mid-query)
+    if ( source.IsCompressed ) {
+        if ( !Bgzf.OpenForReading(source.Filename.toStdString()) ) { return false; }
+        Bgzf.BlockLength = 0;
+        Bgzf.BlockOffset = 0;
+        IsCompressed = true;
+    } else {
+        File.setFileName(source.Filename);
+        if ( !File.open(QIODevice::ReadOnly) ) { return false; }
+    }
+
+    // share source's index & return success
+    SharedIndex  = &source.CurrentIndex();
+    Filename     = source.Filename;
+    IsIndexReady = true;
+    IsOpen       = true;
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::OpenCompressed(const QString& filename) {
+
+    // make sure data file exists & is BGZF-compressed
+    File.setFileName(filename);
+    if ( !File.open(QIODevice::ReadOnly) ) { return false; }
+    QByteArray header = File.read(BamTools::BLOCK_HEADER_LENGTH);
+    File.close();
+    if ( (header.size() != BamTools::BLOCK_HEADER_LENGTH) || !BamTools::BgzfData::CheckBlockHeader(header.data()) ) {
+        qDebug() << "File is not BGZF-compressed (use bgzip):" << filename;
+        return false;
+    }
+
+    // load tabix index
+    const QString indexFilename = GTextIndex::TabixFilename(filename);
+    if ( !Index.LoadTabix(indexFilename) ) {
+        qDebug() << "Could not load tabix index file:" << indexFilename;
+        return false;
+    }
+
+    // open BGZF stream & return success
+    if ( !Bgzf.OpenForReading(filename.toStdString()) ) { return false; }
+    Bgzf.BlockLength = 0;
+    Bgzf.BlockOffset = 0;
+    IsCompressed = true;
+    IsIndexReady = true;
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::OpenPlain(const QString& filename) {
+
+    // open data file
+    File.setFileName(filename);
+    if ( !File.open(QIODevice::ReadOnly) ) { return false; }
+
+    // load existing sidecar index, if available & up-to-date (otherwise left for BuildIndex())
+    IsIndexReady = Index.Load(GTextIndex::SidecarFilename(filename), filename);
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::BuildIndex(GTextLineVisitor* visitor) {
+
+    // skip if not open, or index already available
+    if ( !IsOpen ) { return false; }
+    if ( IsIndexReady ) { return true; }
+
+    // scan file data, on own handle (main one may be in use, e.g. reading header)
+    QFile file(Filename);
+    if ( !file.open(QIODevice::ReadOnly) || !Index.Build(file, visitor) ) {
+        qDebug() << "Could not build index for file:" << Filename;
+        Index.Clear();
+        return false;
+    }
+
+    // save for next time (index still usable from memory if this fails)
+    const QString indexFilename = GTextIndex::SidecarFilename(Filename);
+    if ( !Index.Save(indexFilename, Filename) ) {
+        qDebug() << "Could not save index file:" << indexFilename;
+    }
+    IsIndexReady = true;
+    return true;
+}
+
+const char* GIndexedTextFile::GIndexedTextFilePrivate::MapData(qint64& size) {
+
+    size = 0;
+
+    // skip if file not open, or compressed (byte ranges would not be line-aligned)
+    if ( !IsOpen || IsCompressed ) { return 0; }
+
+    // map file data
+    if ( MappedData == 0 ) { MappedData = File.map(0, File.size()); }
+    if ( MappedData == 0 ) { return 0; }
+    size = File.size();
+    return (const char*)MappedData;
+}
+
+void GIndexedTextFile::GIndexedTextFilePrivate::UnmapData(void) {
+    if ( MappedData ) {
+        File.unmap(MappedData);
+        MappedData = 0;
+    }
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::ReadHeader(QList<QByteArray>& lines) {
+
+    lines.clear();
+
+    // skip if file not open
+    if ( !IsOpen ) { return false; }
+
+    // reset any current region
+    Chunks.clear();
+    IsRegionDone = true;
+
+    // read from start of file, until first non-header line
+    if ( !Seek(0) ) { return false; }
+    const char metaChar = CurrentIndex().Format().MetaChar;
+    while ( ReadLine() ) {
+        if ( (BufferLength == 0) || (Buffer.at(0) != metaChar) ) { break; }
+        int length = BufferLength;
+        while ( (length > 0) && ((Buffer.at(length-1) == '\n') || (Buffer.at(length-1) == '\r')) ) { --length; }
+        lines.append( QByteArray(Buffer.constData(), length) );
+    }
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::SetRegion(const QString& refName, qint32 left, qint32 right) {
+
+    // skip if file not open
+    if ( !IsOpen ) { return false; }
+
+    // store region, adjusted to 0-based half-open coordinates
+    RefName = refName.toLatin1();
+    Begin   = left - 1;
+    End     = right;
+
+    // look up file chunks that may contain region data
+    Chunks       = CurrentIndex().Chunks(refName, Begin, End);
+    CurrentChunk = -1;
+    IsRegionDone = Chunks.isEmpty();
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::SetReference(const QString& refName) {
+
+    // skip if file not open
+    if ( !IsOpen ) { return false; }
+
+    // store region, covering entire reference
+    RefName = refName.toLatin1();
+    Begin   = 0;
+    End     = INT_MAX;
+
+    // look up file chunks for reference
+    Chunks       = CurrentIndex().Chunks(refName);
+    CurrentChunk = -1;
+    IsRegionDone = Chunks.isEmpty();
+    return true;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::GetNextLine(GFieldTokenizer& fields) {
+
+    // per-line interval data
+    const GTextIndex&       index  = CurrentIndex();
+    const GTextIndexFormat& format = index.Format();
+    GFieldView lineRefName;
+    qint32     lineBegin = 0;
+    qint32     lineEnd   = 0;
+
+    // while region data remains
+    while ( !IsRegionDone ) {
+
+        // move to next chunk if necessary
+        if ( (CurrentChunk < 0) || (Tell() >= Chunks.at(CurrentChunk).Stop) ) {
+            ++CurrentChunk;
+            if ( CurrentChunk >= Chunks.size() ) { break; }
+            if ( !Seek(Chunks.at(CurrentChunk).Start) ) { break; }
+        }
+
+        // get line data, stop if EOF
+        if ( !ReadLine() ) { break; }
+        fields.SetLine(Buffer.constData(), BufferLength);
+
+        // skip lines on other references (before tokenizing rest of line) & non-interval lines
+        if ( fields.Field(format.SequenceColumn - 1) != RefName ) { continue; }
+        if ( !GTextIndex::ParseInterval(fields, format, lineRefName, lineBegin, lineEnd) ) { continue; }
+
+        // if line starts beyond region
+        if ( lineBegin >= End ) {
+            // no more overlapping entries possible in sorted files, so just stop checking
+            if ( index.IsSorted() ) { break; }
+            continue;
+        }
+
+        // return line if it overlaps region
+        if ( lineEnd > Begin ) { return true; }
+    }
+
+    // region exhausted
+    IsRegionDone = true;
+    fields.SetLine(0, 0);
+    return false;
+}
+
+bool GIndexedTextFile::GIndexedTextFilePrivate::ReadLine(void) {
+
+    // plain text
+    if ( !IsCompressed ) { return GTextIndex::ReadLine(File, Buffer, BufferLength); }
+
+    // BGZF-compressed text - scan uncompressed block(s) for end of line
+    BufferLength = 0;
+    while ( true ) {
+
+        // load next block if current one is used up, stop at EOF
+        if ( Bgzf.BlockOffset >= Bgzf.BlockLength ) {
+            if ( Bgzf.ReadBlock() != 0 ) { return false; }
+            if ( Bgzf.BlockLength == 0 ) { return ( BufferLength > 0 ); }
+        }
+
+        // copy data up to (and including) newline, if found
+        const char* data      = Bgzf.UncompressedBlock + Bgzf.BlockOffset;
+        const int   available = Bgzf.BlockLength - Bgzf.BlockOffset;
+        const char* newline   = (const char*)memchr(data, '\n', available);
+        const int   length    = ( newline ? (newline - data + 1) : available );
+        if ( Buffer.size() < (BufferLength + length) ) { Buffer.resize( qMax(BufferLength + length, Buffer.size() * 2) ); }
+        memcpy(Buffer.data() + BufferLength, data, length);
+        BufferLength     += length;
+        Bgzf.BlockOffset += length;
+
+        // move to next block address once this one is used up (keeps Tell() in sync with index offsets)
+        if ( Bgzf.BlockOffset == Bgzf.BlockLength ) {
+            Bgzf.BlockAddress = ftell(Bgzf.Stream);
+            Bgzf.BlockOffset  = 0;
+            Bgzf.BlockLength  = 0;
+        }
+
+        // return line if complete
+        if ( newline ) { return true; }
+    }
+}
+
+// note - offsets are virtual file offsets for BGZF-compressed data
+bool GIndexedTextFile::GIndexedTextFilePrivate::Seek(qint64 offset) {
+    if ( IsCompressed ) { return Bgzf.Seek(offset); }
+    return File.seek(offset);
+}
+
+qint64 GIndexedTextFile::GIndexedTextFilePrivate::Tell(void) {
+    if ( IsCompressed ) { return Bgzf.Tell(); }
+    return File.pos();
+}
@@ -0,0 +1,97 @@
+// ***************************************************************************
+// GIndexedTextFile.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Provides region-based line access to tab-delimited text files, using a
+// GTextIndex to seek directly to lines overlapping the requested region.
+// ***************************************************************************
+
+#ifndef G_INDEXEDTEXTFILE_H
+#define G_INDEXEDTEXTFILE_H
+
+#include <QList>
+#include "SessionManager/FileManager/TextIO/GTextIndex.h"
+class QByteArray;
+class QString;
+
+namespace Gambit {
+namespace FileIO {
+
+class GFieldTokenizer;
+
+class GIndexedTextFile {
+
+    // constructor/destructor
+    public:
+        GIndexedTextFile(const GTextIndexFormat& format);
+        ~GIndexedTextFile(void);
+
+    // file handling
+    public:
+        void Close(void);
+        bool IsOpen(void) const;
+        // note - opening does not build a missing interval index (see BuildIndex()), so never blocks on a full scan
+        bool Open(const QString& filename);
+        // opens another handle on same file, sharing this file's index (for concurrent queries)
+        // returns 0 if not open or file can't be re-opened - note: this file must stay open while clone is in use
+        GIndexedTextFile* Clone(void) const;
+
+    // data access
+    public:
+        // retrieves header lines (leading lines starting with format's meta character)
+        // note - resets any current region
+        bool ReadHeader(QList<QByteArray>& lines);
+        // sets region for subsequent GetNextLine() calls (Gambit coordinates: 1-based, closed)
+        bool SetRegion(const QString& refName, qint32 left, qint32 right);
+        // sets region to cover all lines for reference
+        bool SetReference(const QString& refName);
+        // retrieves next line overlapping current region, returns false once region is exhausted
+        // note - fields refer to internal line buffer, only valid until next call
+        bool GetNextLine(GFieldTokenizer& fields);
+        // returns index data for file
+        // note - empty until index is ready
+        const GTextIndex& Index(void) const;
+
+    // index building
+    public:
+        // returns whether interval index is available (loaded on Open(), or built since)
+        bool IsIndexReady(void) const;
+        // builds (& saves) interval index by scanning whole file, passing each interval line to visitor (if given)
+        // returns success/fail
+        // note - meant for a background thread: uses its own file handle, but no other index access
+        //        (queries, Clone()) may happen until it is done
+        bool BuildIndex(GTextLineVisitor* visitor = 0);
+
+    // raw data access (for parallel parsing)
+    public:
+        // maps whole (plain text) file into memory, returns 0 if compressed or mapping fails
+        const char* MapData(qint64& size);
+        // releases any data mapped by MapData()
+        void UnmapData(void);
+
+    private:
+        struct GIndexedTextFilePrivate;
+        GIndexedTextFilePrivate* d;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_INDEXEDTEXTFILE_H
@@ -0,0 +1,297 @@
+// ***************************************************************************
+// GIndexedTextReader.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Base for readers of indexed, tab-delimited annotation files (BED, GFF, VCF).
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtConcurrentRun>
+#include <QtDebug>
+#include "DataStructures/GGenomicDataSet.h"
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+#include "SessionManager/FileManager/TextIO/GIndexedTextReader.h"
+#include "SessionManager/FileManager/TextIO/GParallelTextParser.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+GIndexedTextReader::GIndexedTextReader(const GTextIndexFormat& format)
+    : GAbstractFileReader()
+    , m_file(format)
+    , m_isOpen(false)
+    , m_type(GFileInfo::File_Gene)
+    , m_isStoreUsed(false)
+{ }
+
+GIndexedTextReader::~GIndexedTextReader(void) {
+    Close();
+}
+
+bool GIndexedTextReader::Close(void) {
+    m_indexLoader.waitForFinished();
+    m_storeLoader.waitForFinished();
+    m_store.Clear();
+    m_isStoreUsed = false;
+    m_namesLoader.waitForFinished();
+    m_names.Clear();
+    m_handles.Clear();
+    if ( m_isOpen ) { CloseFormat(); }
+    m_file.Close();
+    m_isOpen = false;
+    return true;
+}
+
+bool GIndexedTextReader::Open(const GFileInfo& fileInfo) {
+
+    // skip if reader already opened
+    if ( m_isOpen ) { return false; }
+
+    // set type
+    m_type     = fileInfo.Type;
+    m_filename = fileInfo.Filename;
+
+    // open file (loads any existing interval index)
+    if ( !m_file.Open(m_filename) ) { return false; }
+    m_isOpen = true;
+
+    // any format-specific setup (e.g. header data)
+    OpenFormat();
+
+    // data of small enough files is held in memory
+    // note - larger files are not, regions are read straight from file
+    m_isStoreUsed = ( QFileInfo(m_filename).size() <= GAnnotationStore::MAX_FILE_SIZE );
+
+    // store file's reference names & load name index
+    // (if interval index must be built first, that is done in background, collecting names in same pass)
+    if ( m_file.IsIndexReady() ) {
+        LoadIndex();
+        m_namesLoader = QtConcurrent::run(this, &GIndexedTextReader::LoadNames);
+    } else {
+        m_indexLoader = QtConcurrent::run(this, &GIndexedTextReader::LoadIndex);
+    }
+
+    // start loading data into memory (once index is ready)
+    if ( m_isStoreUsed ) { m_storeLoader = QtConcurrent::run(this, &GIndexedTextReader::LoadStore); }
+    return true;
+}
+
+bool GIndexedTextReader::LoadData(GGenomicDataSet& data) {
+
+    // skip if reader not open
+    if ( !m_isOpen ) { return false; }
+
+    // wait for any background index building
+    m_indexLoader.waitForFinished();
+
+    // resolve region to file's own reference name (file may use an alias, e.g. '1' for 'chr1')
+    GGenomicDataRegion region = data.Region;
+    region.RefName = m_references.FileName(region);
+    if ( region.RefName.isEmpty() ) { return true; }
+
+    // use in-memory data if available (waits for any background loading to finish)
+    if ( m_isStoreUsed && IsStoreRequest(data) ) {
+        m_storeLoader.waitForFinished();
+        data.Genes = m_store.Genes(region);
+        data.Snps  = m_store.Snps(region);
+        return true;
+    }
+
+    // otherwise read region from file (using query handle, opened on first use)
+    GPooledHandle<GIndexedTextFile> file(m_handles);
+    if ( file.IsNull() ) { file.Set( m_file.Clone() ); }
+    if ( file.IsNull() || !file->SetRegion(region.RefName, region.LeftBound, region.RightBound) ) { return true; }
+    LoadRegion(*file.Get(), region, data);
+    return true;
+}
+
+bool GIndexedTextReader::LoadReferences(GReferenceList& references) {
+    Q_UNUSED(references);
+    return false;
+}
+
+bool GIndexedTextReader::FindNames(const QString& prefix, int maxCount, GFeatureNameList& names) {
+
+    // skip if name index not ready (never blocks on index building)
+    if ( !m_isOpen || !m_indexLoader.isFinished() || !m_namesLoader.isFinished() ) { return false; }
+    m_names.FindPrefix(prefix, maxCount, names);
+    return true;
+}
+
+void GIndexedTextReader::SetReferenceDictionary(const GReferenceDictionary* dictionary) {
+    m_references.SetSession(dictionary);
+}
+
+bool GIndexedTextReader::IsStoreRequest(const GGenomicDataSet& data) const {
+    Q_UNUSED(data);
+    return true;
+}
+
+void GIndexedTextReader::LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data) {
+
+    // parse lines overlapping region
+    GFieldTokenizer  fields;
+    GAnnotationBatch batch;
+    while ( file.GetNextLine(fields) ) { ParseLine(region.RefName, fields, batch); }
+
+    // keep entries contained in region (same rule as GAnnotationStore)
+    for ( int i = 0; i < batch.Genes.size(); ++i ) {
+        const GGene& gGene = batch.Genes.at(i).second;
+        if ( (gGene.Start >= region.LeftBound) && (gGene.Stop <= region.RightBound) ) { data.Genes.append(gGene); }
+    }
+    for ( int i = 0; i < batch.Snps.size(); ++i ) {
+        const GSnp& gSnp = batch.Snps.at(i).second;
+        if ( (gSnp.Position >= region.LeftBound) && (gSnp.Position <= region.RightBound) ) { data.Snps.append(gSnp); }
+    }
+}
+
+void GIndexedTextReader::LoadIndex(void) {
+
+    // build index if not loaded on opening, collecting feature names in same pass (unless cached)
+    // note - on failure, file is left with no references (queries return no data)
+    if ( !m_file.IsIndexReady() ) {
+        const QString namesFilename = GAnnotationStore::CacheFilename(m_filename, (int)m_type, ".gni");
+        if ( m_names.Load(namesFilename, m_filename) ) { m_file.BuildIndex(); }
+        else {
+            BeginNames(namesFilename);
+            m_file.BuildIndex(this);
+            FinishNames(namesFilename);
+        }
+    }
+
+    // store file's reference names, for resolving requested regions
+    m_references.SetFileReferences(m_file.Index().ReferenceNames());
+}
+
+void GIndexedTextReader::LoadNames(void) {
+
+    // use index cached by an earlier session, if still valid
+    const QString cacheFilename = GAnnotationStore::CacheFilename(m_filename, (int)m_type, ".gni");
+    if ( m_names.Load(cacheFilename, m_filename) ) { return; }
+
+    // otherwise read all entry names
+    // note - uses its own file handle, main one may be in use by store loading
+    GIndexedTextFile* file = m_file.Clone();
+    if ( file == 0 ) { return; }
+    BeginNames(cacheFilename);
+    GFieldTokenizer fields;
+    foreach ( const QString& refName, file->Index().ReferenceNames() ) {
+        if ( !file->SetReference(refName) ) { continue; }
+        while ( file->GetNextLine(fields) ) { ParseNames(refName, fields, m_names); }
+    }
+    delete file;
+    FinishNames(cacheFilename);
+}
+
+void GIndexedTextReader::VisitLine(const QString& refName, GFieldTokenizer& fields) {
+    ParseNames(refName, fields, m_names);
+}
+
+// prepares name index for building
+// note - only files up to store's size limit are indexed in memory, larger ones are sorted on disk
+void GIndexedTextReader::BeginNames(const QString& cacheFilename) {
+    if ( !m_isStoreUsed ) { m_names.BeginDiskBuild(cacheFilename); }
+}
+
+// sorts names & caches them for later sessions, then maps cache file (releasing built table)
+void GIndexedTextReader::FinishNames(const QString& cacheFilename) {
+    bool isSaved;
+    if ( m_isStoreUsed ) {
+        m_names.Finalize();
+        isSaved = m_names.Save(cacheFilename, m_filename);
+    } else {
+        isSaved = m_names.FinishDiskBuild(m_filename);
+    }
+    if ( isSaved ) { m_names.Load(cacheFilename, m_filename); }
+}
+
+void GIndexedTextReader::LoadStore(void) {
+
+    // use data cached by an earlier session, if still valid
+    const QString cacheFilename = GAnnotationStore::CacheFilename(m_filename, (int)m_type);
+    if ( m_store.Load(cacheFilename, m_filename) ) { return; }
+
+    // otherwise wait for any background index building
+    m_indexLoader.waitForFinished();
+
+    // read all entries, then sort, index & cache them for later sessions
+    BuildStore(m_store);
+    m_store.Finalize();
+    m_store.Save(cacheFilename, m_filename);
+}
+
+void GIndexedTextReader::BuildStore(GAnnotationStore& store) {
+
+    // large (plain text) files are parsed in parallel, one line-aligned byte range per thread
+    qint64 dataSize = 0;
+    const char* data = ( (QFileInfo(m_filename).size() >= GParallelTextParser::MIN_FILE_SIZE) ? m_file.MapData(dataSize) : 0 );
+    if ( data ) {
+        const QList<GAnnotationBatch> batches = GParallelTextParser::Run(this, &GIndexedTextReader::ParseRange, data, dataSize);
+        foreach ( const GAnnotationBatch& batch, batches ) { store.AddBatch(batch); }
+        m_file.UnmapData();
+        return;
+    }
+
+    // otherwise read entries reference by reference
+    GFieldTokenizer fields;
+    foreach ( const QString& refName, m_file.Index().ReferenceNames() ) {
+        if ( !m_file.SetReference(refName) ) { continue; }
+        GAnnotationBatch batch;
+        while ( m_file.GetNextLine(fields) ) { ParseLine(refName, fields, batch); }
+        store.AddBatch(batch);
+    }
+}
+
+// parses entries in byte range of (mapped) file data
+// note - runs concurrently with other ranges
+GAnnotationBatch GIndexedTextReader::ParseRange(const char* data, GTextIndexChunk range) {
+
+    GAnnotationBatch batch;
+
+    // initialize field parsing variables
+    GFieldTokenizer fields;
+    GFieldView line;
+    GFieldView refName;
+    qint32 begin = 0;
+    qint32 end   = 0;
+
+    // current reference name (string shared by all of its entries)
+    QByteArray currentName;
+    QString    currentRefName;
+
+    // while range data exists
+    qint64 position = range.Start;
+    while ( GParallelTextParser::NextLine(data, range.Stop, position, line) ) {
+
+        // skip header lines, comments, & any non-interval entries
+        fields.SetLine(line);
+        if ( !GTextIndex::ParseInterval(fields, m_file.Index().Format(), refName, begin, end) ) { continue; }
+
+        // update current reference name
+        if ( currentRefName.isNull() || (refName != currentName) ) {
+            currentName    = refName.ToByteArray();
+            currentRefName = refName.ToString();
+        }
+
+        // store line's entries
+        ParseLine(currentRefName, fields, batch);
+    }
+
+    return batch;
+}
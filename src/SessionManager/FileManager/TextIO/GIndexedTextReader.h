@@ -0,0 +1,134 @@
+// ***************************************************************************
+// GIndexedTextReader.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Base for readers of indexed, tab-delimited annotation files (BED, GFF, VCF).
+// Handles the shared file lifecycle - interval index, concurrent query handles,
+// in-memory store (for files up to store's size limit) & feature name index (any size),
+// loaded in background & cached for later sessions. Derived readers only supply their format's line parsing.
+// ***************************************************************************
+
+#ifndef G_INDEXEDTEXTREADER_H
+#define G_INDEXEDTEXTREADER_H
+
+#include <QFuture>
+#include <QString>
+#include "DataStructures/GFileInfo.h"
+#include "DataStructures/GReferenceDictionary.h"
+#include "SessionManager/FileManager/GAbstractFileReader.h"
+#include "SessionManager/FileManager/TextIO/GAnnotationStore.h"
+#include "SessionManager/FileManager/TextIO/GHandlePool.h"
+#include "SessionManager/FileManager/TextIO/GIndexedTextFile.h"
+#include "SessionManager/FileManager/TextIO/GNameIndex.h"
+
+namespace Gambit {
+namespace FileIO {
+
+class GFieldTokenizer;
+
+class GIndexedTextReader : public GAbstractFileReader, private GTextLineVisitor {
+
+    // constructor/destructor
+    // note - derived readers must call Close() in their own destructor,
+    //        as background loading may still be using their parse methods
+    public:
+        GIndexedTextReader(const GTextIndexFormat& format);
+        virtual ~GIndexedTextReader(void);
+
+    // GAbstractFileReader implementation
+    public:
+        bool Close(void);
+        bool LoadData(GGenomicDataSet& data);
+        bool Open(const GFileInfo& fileInfo);
+        bool LoadReferences(GReferenceList& references);
+        bool FindNames(const QString& prefix, int maxCount, GFeatureNameList& names);
+        void SetReferenceDictionary(const GReferenceDictionary* dictionary);
+
+    // format-specific parsing
+    // note - may run concurrently for different parts of file
+    protected:
+        // appends entries (Gambit coordinates) parsed from data line
+        virtual void ParseLine(const QString& refName, GFieldTokenizer& fields, GAnnotationBatch& batch) const =0;
+        // adds any searchable names from data line
+        virtual void ParseNames(const QString& refName, GFieldTokenizer& fields, GNameIndex& names) const =0;
+
+    // optional format-specific steps
+    protected:
+        // called after file is opened (before any background loading starts), & before it is closed
+        virtual void OpenFormat(void) { }
+        virtual void CloseFormat(void) { }
+        // fills store with all entries in file (default uses ParseLine() on every line)
+        virtual void BuildStore(GAnnotationStore& store);
+        // returns whether request can be answered from store (if used), instead of reading file
+        virtual bool IsStoreRequest(const GGenomicDataSet& data) const;
+        // loads entries contained in region straight from file (for files too large for store)
+        // file is set to region already, region uses file's own reference name
+        virtual void LoadRegion(GIndexedTextFile& file, const GGenomicDataRegion& region, GGenomicDataSet& data);
+
+    // accessors for derived readers
+    protected:
+        GIndexedTextFile& File(void) { return m_file; }
+        const QString& Filename(void) const { return m_filename; }
+        GFileInfo::FileType Type(void) const { return m_type; }
+
+    // GTextLineVisitor implementation (collects names while index is built)
+    private:
+        void VisitLine(const QString& refName, GFieldTokenizer& fields);
+
+    // 'internal' methods
+    private:
+        void LoadIndex(void);
+        void LoadNames(void);
+        void BeginNames(const QString& cacheFilename);
+        void FinishNames(const QString& cacheFilename);
+        void LoadStore(void);
+        GAnnotationBatch ParseRange(const char* data, GTextIndexChunk range);
+
+    // data members
+    private:
+        GIndexedTextFile    m_file;
+        bool                m_isOpen;
+        GFileInfo::FileType m_type;
+        QString             m_filename;
+        GReferenceMapper    m_references;
+
+        // interval index building (for files without a usable index), runs in background
+        // note - file's reference names come from index, so all queries wait for this first
+        //        feature names are collected in same pass (unless cached)
+        QFuture<void> m_indexLoader;
+
+        // query file handles (share main file's index), so regions can be loaded concurrently
+        GHandlePool<GIndexedTextFile> m_handles;
+
+        // in-memory data (for files small enough), loaded in background
+        GAnnotationStore m_store;
+        QFuture<void>    m_storeLoader;
+        bool             m_isStoreUsed;
+
+        // feature name index, loaded in background (built with interval index, if that is built)
+        // note - kept in mapped cache file, so files of any size are searchable
+        GNameIndex    m_names;
+        QFuture<void> m_namesLoader;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_INDEXEDTEXTREADER_H
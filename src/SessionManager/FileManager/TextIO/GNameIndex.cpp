@@ -0,0 +1,576 @@
+// ***************************************************************************
+// GNameIndex.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Sorted table of feature names (genes, SNP IDs) for a single file, supporting
+// case-insensitive prefix lookup.
+// 
+// Cache file layout: fixed header, entry array, names (concatenated in entry
+// order), reference names & source file path. Entries are fixed-size & sorted
+// by (ASCII case-folded) name, so lookups are a binary search directly on the
+// mapped file.
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtDebug>
+#include <algorithm>
+#include <cstring>
+#include "SessionManager/FileManager/TextIO/GNameIndex.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// cache file identifiers
+// note - version must be bumped whenever table layout (or how readers pick names) changes
+const quint32 GNameIndex::CACHE_MAGIC   = 0x474E4901; // "GNI\1"
+const quint32 GNameIndex::CACHE_VERSION = 100;
+
+// cache is only valid on machines with same byte order
+static const quint32 CACHE_BYTE_ORDER = 0x01020304;
+
+// name data is kept in a single QByteArray while building in memory
+static const qint64 MAX_NAMES_LENGTH = 0x7FFFFFFF;
+
+// name offsets in table are 32-bit (limits disk builds)
+static const quint64 MAX_TABLE_NAMES_LENGTH = 0xFFFFFFFF;
+
+// disk builds write pending names out as a sorted run once they take up this much memory
+static const qint64 MAX_RUN_LENGTH = 64 * 1024 * 1024;
+
+namespace Gambit {
+namespace FileIO {
+
+// cache file header
+struct GNameIndexHeader {
+    quint32 Magic;
+    quint32 Version;
+    quint32 ByteOrder;
+    quint32 EntrySize;
+    qint64  FileSize;
+    quint32 FileModified;
+    quint32 EntryCount;
+    quint64 NamesLength;
+    quint32 RefNamesLength;
+    quint32 PathLength;
+};
+
+// ASCII case-folding comparison (non-ASCII UTF-8 bytes compare as-is)
+static inline
+int CompareNames(const char* lhs, int lhsLength, const char* rhs, int rhsLength) {
+    const int length = qMin(lhsLength, rhsLength);
+    for ( int i = 0; i < length; ++i ) {
+        uchar l = (uchar)lhs[i];
+        uchar r = (uchar)rhs[i];
+        if ( (l >= 'A') && (l <= 'Z') ) { l += ('a' - 'A'); }
+        if ( (r >= 'A') && (r <= 'Z') ) { r += ('a' - 'A'); }
+        if ( l != r ) { return ( (int)l - (int)r ); }
+    }
+    return ( lhsLength - rhsLength );
+}
+
+// orders pending entries by name, then reference & position
+struct GNameLessThan {
+
+    const GNameIndexEntry* Entries;
+    int                    Count;
+    const QByteArray*      Names;
+
+    GNameLessThan(const QVector<GNameIndexEntry>& entries, const QByteArray& names)
+        : Entries(entries.constData())
+        , Count(entries.size())
+        , Names(&names)
+    { }
+
+    int Length(quint32 index) const {
+        const int end = ( ((int)index + 1 < Count) ? (int)Entries[index + 1].NameOffset : Names->size() );
+        return ( end - (int)Entries[index].NameOffset );
+    }
+
+    bool operator()(quint32 lhs, quint32 rhs) const {
+        const int result = CompareNames(Names->constData() + Entries[lhs].NameOffset, Length(lhs),
+                                        Names->constData() + Entries[rhs].NameOffset, Length(rhs));
+        if ( result != 0 ) { return ( result < 0 ); }
+        if ( Entries[lhs].RefId != Entries[rhs].RefId ) { return ( Entries[lhs].RefId < Entries[rhs].RefId ); }
+        return ( Entries[lhs].Start < Entries[rhs].Start );
+    }
+};
+
+// returns pending entries' indexes in sorted order
+static
+QVector<quint32> SortedOrder(const QVector<GNameIndexEntry>& entries, const QByteArray& names) {
+    QVector<quint32> order(entries.size());
+    for ( int i = 0; i < order.size(); ++i ) { order[i] = i; }
+    qSort(order.begin(), order.end(), GNameLessThan(entries, names));
+    return order;
+}
+
+// reads back a sorted run file (disk builds)
+// note - run entries hold their name's length in NameOffset, name data follows each entry
+struct GNameRunReader {
+
+    QFile           File;
+    GNameIndexEntry Entry;
+    QByteArray      Name;
+
+    GNameRunReader(const QString& filename)
+        : File(filename)
+    { }
+
+    // reads next entry, returns false at end of run
+    bool Next(void) {
+        if ( File.read((char*)&Entry, sizeof(GNameIndexEntry)) != (qint64)sizeof(GNameIndexEntry) ) { return false; }
+        Name.resize(Entry.NameOffset);
+        return ( File.read(Name.data(), Name.size()) == (qint64)Name.size() );
+    }
+};
+
+// orders runs by their current entry, reversed (so heap gives smallest entry first)
+struct GNameRunGreater {
+
+    const QList<GNameRunReader*>* Runs;
+
+    GNameRunGreater(const QList<GNameRunReader*>& runs)
+        : Runs(&runs)
+    { }
+
+    bool operator()(int lhs, int rhs) const {
+        const GNameRunReader* l = Runs->at(lhs);
+        const GNameRunReader* r = Runs->at(rhs);
+        const int result = CompareNames(r->Name.constData(), r->Name.size(), l->Name.constData(), l->Name.size());
+        if ( result != 0 ) { return ( result < 0 ); }
+        if ( r->Entry.RefId != l->Entry.RefId ) { return ( r->Entry.RefId < l->Entry.RefId ); }
+        return ( r->Entry.Start < l->Entry.Start );
+    }
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+GNameIndex::GNameIndex(void)
+    : m_isFull(false)
+    , m_runCount(0)
+    , m_runNamesLength(0)
+    , m_cacheFile(0)
+    , m_cacheData(0)
+    , m_entries(0)
+    , m_count(0)
+    , m_names(0)
+    , m_namesLength(0)
+{ }
+
+GNameIndex::~GNameIndex(void) {
+    Clear();
+}
+
+void GNameIndex::AddName(const QString& refName, const QString& name, qint32 start, qint32 stop) {
+
+    // skip unnamed features
+    if ( name.isEmpty() ) { return; }
+    if ( m_isFull ) { return; }
+    const QByteArray nameData = name.toUtf8();
+    const bool isDiskBuild = !m_cacheFilename.isEmpty();
+    const quint64 namesLength = m_runNamesLength + (quint64)m_pendingNames.size() + (quint64)nameData.size();
+    if ( namesLength > (isDiskBuild ? MAX_TABLE_NAMES_LENGTH : (quint64)MAX_NAMES_LENGTH) ) {
+        qDebug() << "GNameIndex::AddName() => too many names, remaining names will not be indexed";
+        m_isFull = true;
+        return;
+    }
+
+    // lookup reference ID, adding new reference if necessary
+    QHash<QString, quint32>::const_iterator refIter = m_refLookup.constFind(refName);
+    quint32 refId;
+    if ( refIter != m_refLookup.constEnd() ) { refId = refIter.value(); }
+    else {
+        refId = m_refNames.size();
+        m_refNames.append(refName);
+        m_refLookup.insert(refName, refId);
+    }
+
+    // store entry
+    GNameIndexEntry entry;
+    entry.NameOffset = m_pendingNames.size();
+    entry.RefId      = refId;
+    entry.Start      = start;
+    entry.Stop       = stop;
+    m_pendingEntries.append(entry);
+    m_pendingNames.append(nameData);
+
+    // disk builds - write out pending names once they take up enough memory
+    const qint64 pendingLength = (qint64)m_pendingNames.size() + (qint64)m_pendingEntries.size() * sizeof(GNameIndexEntry);
+    if ( isDiskBuild && (pendingLength >= MAX_RUN_LENGTH) && !WriteRun() ) { m_isFull = true; }
+}
+
+void GNameIndex::Clear(void) {
+
+    // unmap any cache file
+    if ( m_cacheFile ) {
+        if ( m_cacheData ) { m_cacheFile->unmap(m_cacheData); }
+        m_cacheFile->close();
+        delete m_cacheFile;
+        m_cacheFile = 0;
+        m_cacheData = 0;
+    }
+
+    // remove any runs left by an unfinished disk build
+    RemoveRuns();
+    m_cacheFilename.clear();
+    m_runCount       = 0;
+    m_runNamesLength = 0;
+
+    // clear data
+    m_pendingEntries.clear();
+    m_pendingNames.clear();
+    m_refLookup.clear();
+    m_isFull = false;
+    m_builtEntries.clear();
+    m_builtNames.clear();
+    m_entries     = 0;
+    m_count       = 0;
+    m_names       = 0;
+    m_namesLength = 0;
+    m_refNames.clear();
+}
+
+quint32 GNameIndex::Count(void) const {
+    return m_count;
+}
+
+void GNameIndex::Finalize(void) {
+
+    // sort entry order
+    const int numEntries = m_pendingEntries.size();
+    const QVector<quint32> order = SortedOrder(m_pendingEntries, m_pendingNames);
+
+    // rebuild entries & names in sorted order
+    const GNameLessThan pending(m_pendingEntries, m_pendingNames);
+    m_builtEntries.resize(numEntries);
+    m_builtNames.clear();
+    m_builtNames.reserve(m_pendingNames.size());
+    for ( int i = 0; i < numEntries; ++i ) {
+        const quint32 index = order.at(i);
+        GNameIndexEntry& entry = m_builtEntries[i];
+        entry = m_pendingEntries.at(index);
+        entry.NameOffset = m_builtNames.size();
+        m_builtNames.append(m_pendingNames.constData() + m_pendingEntries.at(index).NameOffset, pending.Length(index));
+    }
+
+    // pending data no longer needed once table is built
+    m_pendingEntries.clear();
+    m_pendingNames.clear();
+    m_refLookup.clear();
+
+    // set current table
+    m_entries     = m_builtEntries.constData();
+    m_count       = numEntries;
+    m_names       = m_builtNames.constData();
+    m_namesLength = m_builtNames.size();
+}
+
+void GNameIndex::BeginDiskBuild(const QString& cacheFilename) {
+    Clear();
+    m_cacheFilename = cacheFilename;
+}
+
+bool GNameIndex::FinishDiskBuild(const QString& dataFilename) {
+
+    // skip if no disk build started
+    if ( m_cacheFilename.isEmpty() ) { return false; }
+    const QString cacheFilename = m_cacheFilename;
+    const QString tempFilename  = cacheFilename + ".tmp";
+
+    // write out any remaining names
+    bool isOk = WriteRun();
+
+    // open runs, at their first entries
+    QList<GNameRunReader*> runs;
+    QVector<int> heap;
+    foreach ( const QString& runFilename, m_runFilenames ) {
+        GNameRunReader* run = new GNameRunReader(runFilename);
+        runs.append(run);
+        if ( !run->File.open(QIODevice::ReadOnly) ) { isOk = false; }
+        else if ( run->Next() ) { heap.append(runs.size() - 1); }
+    }
+    const GNameRunGreater greater(runs);
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    // build header
+    const QFileInfo  dataInfo(dataFilename);
+    const QByteArray refNameData = m_refNames.join(QString(QChar('\n'))).toUtf8();
+    const QByteArray pathData    = dataInfo.absoluteFilePath().toUtf8();
+    GNameIndexHeader header;
+    FillHeader(header, dataInfo, m_runCount, m_runNamesLength, refNameData.size(), pathData.size());
+
+    // open temp file twice - one handle writes entries (after header), the other names (after all entries)
+    // note - other sessions never see partial cache files
+    const qint64 namesOffset = (qint64)sizeof(GNameIndexHeader) + (qint64)m_runCount * sizeof(GNameIndexEntry);
+    QFile entriesFile(tempFilename);
+    QFile namesFile(tempFilename);
+    isOk = ( isOk && QDir().mkpath(QFileInfo(cacheFilename).absolutePath()) &&
+             entriesFile.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+             (entriesFile.write((const char*)&header, sizeof(GNameIndexHeader)) == (qint64)sizeof(GNameIndexHeader)) &&
+             namesFile.open(QIODevice::ReadWrite) && namesFile.seek(namesOffset) );
+
+    // merge runs, writing entries in name order
+    quint32 numEntries  = 0;
+    quint64 namesLength = 0;
+    while ( isOk && !heap.isEmpty() ) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        GNameRunReader* run = runs.at(heap.last());
+        GNameIndexEntry entry = run->Entry;
+        entry.NameOffset = (quint32)namesLength;
+        isOk = ( (entriesFile.write((const char*)&entry, sizeof(GNameIndexEntry)) == (qint64)sizeof(GNameIndexEntry)) &&
+                 (namesFile.write(run->Name) == run->Name.size()) );
+        ++numEntries;
+        namesLength += run->Name.size();
+        if ( run->Next() ) { std::push_heap(heap.begin(), heap.end(), greater); }
+        else { heap.pop_back(); }
+    }
+
+    // finish with reference names & data file path
+    isOk = ( isOk && (numEntries == m_runCount) && (namesLength == m_runNamesLength) &&
+             (namesFile.write(refNameData) == refNameData.size()) &&
+             (namesFile.write(pathData) == pathData.size()) );
+    entriesFile.close();
+    namesFile.close();
+    isOk = ( isOk && (entriesFile.error() == QFile::NoError) && (namesFile.error() == QFile::NoError) );
+
+    // clean up runs & build data
+    qDeleteAll(runs);
+    Clear();
+
+    // replace any existing cache file
+    if ( !isOk ) {
+        qDebug() << "GNameIndex::FinishDiskBuild() => could not write cache file:" << tempFilename;
+        QFile::remove(tempFilename);
+        return false;
+    }
+    QFile::remove(cacheFilename);
+    return QFile::rename(tempFilename, cacheFilename);
+}
+
+// sorts pending names & writes them to next run file (disk builds)
+bool GNameIndex::WriteRun(void) {
+
+    const int numEntries = m_pendingEntries.size();
+    if ( numEntries == 0 ) { return true; }
+    const QVector<quint32> order = SortedOrder(m_pendingEntries, m_pendingNames);
+    const GNameLessThan pending(m_pendingEntries, m_pendingNames);
+
+    // write entries in sorted order, each followed by its name
+    const QString runFilename = m_cacheFilename + QString(".run%1").arg(m_runFilenames.size());
+    QFile runFile(runFilename);
+    bool isOk = ( QDir().mkpath(QFileInfo(runFilename).absolutePath()) &&
+                  runFile.open(QIODevice::WriteOnly | QIODevice::Truncate) );
+    for ( int i = 0; isOk && (i < numEntries); ++i ) {
+        const quint32 index = order.at(i);
+        GNameIndexEntry entry = m_pendingEntries.at(index);
+        const char* name   = m_pendingNames.constData() + entry.NameOffset;
+        const int   length = pending.Length(index);
+        entry.NameOffset = length;
+        isOk = ( (runFile.write((const char*)&entry, sizeof(GNameIndexEntry)) == (qint64)sizeof(GNameIndexEntry)) &&
+                 (runFile.write(name, length) == length) );
+    }
+    runFile.close();
+    isOk = ( isOk && (runFile.error() == QFile::NoError) );
+
+    // pending names are dropped either way (a failed run is not merged)
+    if ( isOk ) {
+        m_runFilenames.append(runFilename);
+        m_runCount       += numEntries;
+        m_runNamesLength += m_pendingNames.size();
+    } else {
+        qDebug() << "GNameIndex::WriteRun() => could not write run file:" << runFilename;
+        QFile::remove(runFilename);
+    }
+    m_pendingEntries.clear();
+    m_pendingNames.clear();
+    return isOk;
+}
+
+void GNameIndex::RemoveRuns(void) {
+    foreach ( const QString& runFilename, m_runFilenames ) { QFile::remove(runFilename); }
+    m_runFilenames.clear();
+}
+
+void GNameIndex::FindPrefix(const QString& prefix, int maxCount, GFeatureNameList& names) const {
+
+    // skip if no data
+    if ( (m_count == 0) || (maxCount <= 0) ) { return; }
+    const QByteArray key = prefix.toUtf8();
+
+    // find first name not less than prefix
+    quint32 low  = 0;
+    quint32 high = m_count;
+    while ( low < high ) {
+        const quint32 mid = low + (high - low) / 2;
+        if ( CompareNames(m_names + m_entries[mid].NameOffset, NameLength(mid), key.constData(), key.size()) < 0 ) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // append entries while name still starts with prefix
+    int numFound = 0;
+    for ( quint32 i = low; (i < m_count) && (numFound < maxCount); ++i, ++numFound ) {
+
+        const GNameIndexEntry& entry = m_entries[i];
+        const char* name = m_names + entry.NameOffset;
+        const int nameLength = NameLength(i);
+        if ( (nameLength < key.size()) || (CompareNames(name, key.size(), key.constData(), key.size()) != 0) ) { break; }
+
+        GFeatureName feature;
+        feature.Name    = QString::fromUtf8(name, nameLength);
+        feature.RefName = ( ((int)entry.RefId < m_refNames.size()) ? m_refNames.at(entry.RefId) : QString() );
+        feature.Start   = entry.Start;
+        feature.Stop    = entry.Stop;
+        names.append(feature);
+    }
+}
+
+int GNameIndex::NameLength(quint32 index) const {
+    const quint64 begin = m_entries[index].NameOffset;
+    const quint64 end   = ( (index + 1 < m_count) ? (quint64)m_entries[index + 1].NameOffset : m_namesLength );
+    if ( (begin > end) || (end > m_namesLength) ) { return 0; }
+    return (int)(end - begin);
+}
+
+bool GNameIndex::Load(const QString& cacheFilename, const QString& dataFilename) {
+
+    // clear any existing data
+    Clear();
+
+    // open & map cache file
+    QFile* cacheFile = new QFile(cacheFilename);
+    if ( !cacheFile->exists() || !cacheFile->open(QIODevice::ReadOnly) ) {
+        delete cacheFile;
+        return false;
+    }
+    const qint64 cacheSize = cacheFile->size();
+    uchar* cacheData = ( (cacheSize >= (qint64)sizeof(GNameIndexHeader)) ? cacheFile->map(0, cacheSize) : 0 );
+    if ( cacheData == 0 ) {
+        delete cacheFile;
+        return false;
+    }
+
+    // validate 'magic number', version, byte order, entry layout & table size
+    GNameIndexHeader header;
+    memcpy(&header, cacheData, sizeof(GNameIndexHeader));
+    const qint64 tableSize = (qint64)sizeof(GNameIndexHeader) +
+                             (qint64)header.EntryCount * (qint64)sizeof(GNameIndexEntry) +
+                             (qint64)header.NamesLength +
+                             (qint64)header.RefNamesLength +
+                             (qint64)header.PathLength;
+    bool isValid = ( (header.Magic     == GNameIndex::CACHE_MAGIC)   &&
+                     (header.Version   == GNameIndex::CACHE_VERSION) &&
+                     (header.ByteOrder == CACHE_BYTE_ORDER)          &&
+                     (header.EntrySize == sizeof(GNameIndexEntry))   &&
+                     (header.NamesLength <= (quint64)cacheSize)      &&
+                     (tableSize == cacheSize) );
+
+    // make sure cache is not stale
+    const char* entryData   = (const char*)cacheData + sizeof(GNameIndexHeader);
+    const char* nameData    = entryData + (qint64)header.EntryCount * sizeof(GNameIndexEntry);
+    const char* refNameData = nameData + header.NamesLength;
+    const char* pathData    = refNameData + header.RefNamesLength;
+    if ( isValid ) {
+        const QFileInfo dataInfo(dataFilename);
+        isValid = ( (header.FileSize     == dataInfo.size()) &&
+                    (header.FileModified == dataInfo.lastModified().toTime_t()) &&
+                    (QString::fromUtf8(pathData, header.PathLength) == dataInfo.absoluteFilePath()) );
+    }
+
+    // clean up if cache not usable
+    if ( !isValid ) {
+        cacheFile->unmap(cacheData);
+        cacheFile->close();
+        delete cacheFile;
+        return false;
+    }
+
+    // set current table (kept mapped until cleared)
+    m_cacheFile   = cacheFile;
+    m_cacheData   = cacheData;
+    m_entries     = (const GNameIndexEntry*)entryData;
+    m_count       = header.EntryCount;
+    m_names       = nameData;
+    m_namesLength = header.NamesLength;
+    if ( header.RefNamesLength > 0 ) {
+        m_refNames = QString::fromUtf8(refNameData, header.RefNamesLength).split(QChar('\n'));
+    }
+    return true;
+}
+
+bool GNameIndex::Save(const QString& cacheFilename, const QString& dataFilename) const {
+
+    // make sure cache directory exists
+    const QFileInfo cacheInfo(cacheFilename);
+    if ( !QDir().mkpath(cacheInfo.absolutePath()) ) { return false; }
+
+    // write to temp file first, so that other sessions never see partial cache files
+    const QString tempFilename = cacheFilename + ".tmp";
+    QFile cacheFile(tempFilename);
+    if ( !cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ) {
+        qDebug() << "GNameIndex::Save() => could not open cache file:" << tempFilename;
+        return false;
+    }
+
+    // build header
+    const QFileInfo  dataInfo(dataFilename);
+    const QByteArray refNameData = m_refNames.join(QString(QChar('\n'))).toUtf8();
+    const QByteArray pathData    = dataInfo.absoluteFilePath().toUtf8();
+    GNameIndexHeader header;
+    FillHeader(header, dataInfo, m_count, m_namesLength, refNameData.size(), pathData.size());
+
+    // write header & table
+    const qint64 entriesLength = (qint64)m_count * sizeof(GNameIndexEntry);
+    bool isOk = ( (cacheFile.write((const char*)&header, sizeof(GNameIndexHeader)) == (qint64)sizeof(GNameIndexHeader)) &&
+                  (cacheFile.write((const char*)m_entries, entriesLength) == entriesLength) &&
+                  (cacheFile.write(m_names, m_namesLength) == (qint64)m_namesLength) &&
+                  (cacheFile.write(refNameData) == refNameData.size()) &&
+                  (cacheFile.write(pathData) == pathData.size()) );
+    cacheFile.close();
+
+    // check for write errors
+    if ( !isOk || (cacheFile.error() != QFile::NoError) ) {
+        qDebug() << "GNameIndex::Save() => could not write cache file:" << tempFilename;
+        QFile::remove(tempFilename);
+        return false;
+    }
+
+    // replace any existing cache file
+    QFile::remove(cacheFilename);
+    return QFile::rename(tempFilename, cacheFilename);
+}
+
+void GNameIndex::FillHeader(GNameIndexHeader& header, const QFileInfo& dataInfo, quint32 count,
+                            quint64 namesLength, int refNamesLength, int pathLength)
+{
+    memset(&header, 0, sizeof(GNameIndexHeader));
+    header.Magic          = GNameIndex::CACHE_MAGIC;
+    header.Version        = GNameIndex::CACHE_VERSION;
+    header.ByteOrder      = CACHE_BYTE_ORDER;
+    header.EntrySize      = sizeof(GNameIndexEntry);
+    header.FileSize       = dataInfo.size();
+    header.FileModified   = dataInfo.lastModified().toTime_t();
+    header.EntryCount     = count;
+    header.NamesLength    = namesLength;
+    header.RefNamesLength = refNamesLength;
+    header.PathLength     = pathLength;
+}
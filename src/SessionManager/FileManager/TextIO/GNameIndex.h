@@ -0,0 +1,135 @@
+// ***************************************************************************
+// GNameIndex.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Sorted table of feature names (genes, SNP IDs) for a single file, supporting
+// case-insensitive prefix lookup. The finalized table (entries, then names in
+// the same sorted order) is saved to a binary cache file, and later sessions
+// query it straight from the memory-mapped file without loading it.
+// ***************************************************************************
+
+#ifndef G_NAMEINDEX_H
+#define G_NAMEINDEX_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+#include "DataStructures/GFeatureName.h"
+class QFile;
+class QFileInfo;
+
+namespace Gambit {
+namespace FileIO {
+
+struct GNameIndexHeader;
+
+// name table entry
+// note - name length is implied by next entry's offset (names are stored in entry order)
+struct GNameIndexEntry {
+    quint32 NameOffset;
+    quint32 RefId;
+    qint32  Start;
+    qint32  Stop;
+};
+
+class GNameIndex {
+
+    // constructor/destructor
+    public:
+        GNameIndex(void);
+        ~GNameIndex(void);
+
+    // building index
+    public:
+        // stores feature name (Gambit coordinates), empty names are ignored
+        void AddName(const QString& refName, const QString& name, qint32 start, qint32 stop);
+        // clears all data (and unmaps any cache file)
+        void Clear(void);
+        // sorts names, must be called after all names are added
+        void Finalize(void);
+
+    // building index on disk (for files of any size)
+    // note - names added after BeginDiskBuild() are sorted in batches & written to run files beside cache file,
+    //        so memory use is bounded; FinishDiskBuild() then merges runs into cache file (instead of Finalize() & Save())
+    public:
+        void BeginDiskBuild(const QString& cacheFilename);
+        bool FinishDiskBuild(const QString& dataFilename);
+
+    // name lookup
+    public:
+        // returns number of names stored
+        quint32 Count(void) const;
+        // appends (up to maxCount) entries whose name starts with prefix (ignoring case), in name order
+        void FindPrefix(const QString& prefix, int maxCount, GFeatureNameList& names) const;
+
+    // binary cache
+    public:
+        // maps cache file, fails if cache is stale (or from another source file)
+        bool Load(const QString& cacheFilename, const QString& dataFilename);
+        // saves (finalized) table to cache file
+        bool Save(const QString& cacheFilename, const QString& dataFilename) const;
+
+    // cache file identifiers
+    private:
+        static const quint32 CACHE_MAGIC;
+        static const quint32 CACHE_VERSION;
+
+    // 'internal' methods
+    private:
+        int  NameLength(quint32 index) const;
+        bool WriteRun(void);
+        void RemoveRuns(void);
+        static void FillHeader(GNameIndexHeader& header, const QFileInfo& dataInfo, quint32 count,
+                               quint64 namesLength, int refNamesLength, int pathLength);
+
+    // data members
+    private:
+        // names added since last Finalize()
+        QVector<GNameIndexEntry> m_pendingEntries;
+        QByteArray               m_pendingNames;
+        QHash<QString, quint32>  m_refLookup;
+        bool                     m_isFull;
+
+        // disk build data - sorted runs written so far
+        QString     m_cacheFilename;
+        QStringList m_runFilenames;
+        quint32     m_runCount;
+        quint64     m_runNamesLength;
+
+        // finalized table - either built in memory, or mapped from cache file
+        QVector<GNameIndexEntry> m_builtEntries;
+        QByteArray               m_builtNames;
+        QFile*                   m_cacheFile;
+        uchar*                   m_cacheData;
+
+        // current table
+        const GNameIndexEntry* m_entries;
+        quint32                m_count;
+        const char*            m_names;
+        quint64                m_namesLength;
+        QStringList            m_refNames;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_NAMEINDEX_H
@@ -0,0 +1,61 @@
+// ***************************************************************************
+// GParallelTextParser.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Splits (memory-mapped) text data into line-aligned byte ranges & parses them
+// on the global thread pool, returning per-range results in file order.
+// ***************************************************************************
+
+
+#include <QtCore>
+#include "SessionManager/FileManager/TextIO/GParallelTextParser.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// files smaller than this are parsed on a single thread
+const qint64 GParallelTextParser::MIN_FILE_SIZE = 4 * 1024 * 1024;
+
+// RunOrdered() splits data into ranges of about this size (or one per thread, if larger)
+const qint64 GParallelTextParser::RANGE_SIZE = 4 * 1024 * 1024;
+
+GTextIndexChunkList GParallelTextParser::SplitLines(const char* data, qint64 size, int count) {
+
+    GTextIndexChunkList ranges;
+    if ( (data == 0) || (size <= 0) ) { return ranges; }
+    if ( count < 1 ) { count = 1; }
+
+    // move each (evenly spaced) split point forward, to just past next newline
+    qint64 start = 0;
+    for ( int i = 1; (i <= count) && (start < size); ++i ) {
+        qint64 stop = size;
+        if ( i < count ) {
+            const qint64 splitPoint = (size / count) * i;
+            if ( splitPoint > start ) {
+                const char* newline = (const char*)memchr(data + splitPoint - 1, '\n', (size_t)(size - splitPoint + 1));
+                stop = ( newline ? (newline - data) + 1 : size );
+            } else { continue; }
+        }
+        if ( stop > start ) {
+            ranges.append( GTextIndexChunk(start, stop) );
+            start = stop;
+        }
+    }
+    return ranges;
+}
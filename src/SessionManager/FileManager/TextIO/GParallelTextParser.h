@@ -0,0 +1,258 @@
+// ***************************************************************************
+// GParallelTextParser.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Splits (memory-mapped) text data into line-aligned byte ranges & parses them
+// on the global thread pool, handing per-range results back in file order.
+// ***************************************************************************
+
+
+#ifndef G_PARALLELTEXTPARSER_H
+#define G_PARALLELTEXTPARSER_H
+
+#include <QList>
+#include <QMutex>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+#include <cstring>
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+#include "SessionManager/FileManager/TextIO/GTextIndex.h"
+
+namespace Gambit {
+namespace FileIO {
+
+class GParallelTextParser {
+
+    // parsing interface
+    public:
+        // splits data into (at most) 'count' byte ranges, each starting at beginning of a line
+        static GTextIndexChunkList SplitLines(const char* data, qint64 size, int count);
+        // reads next line in range (including any newline), advancing position past it
+        static bool NextLine(const char* data, qint64 stop, qint64& position, GFieldView& line);
+        // runs object's parse method on each range in parallel, returns results in file order
+        template<typename Result, typename Class>
+        static QList<Result> Run(Class* object,
+                                 Result (Class::*parse)(const char*, GTextIndexChunk),
+                                 const char* data,
+                                 qint64 size);
+        // runs object's parse method on ranges of (about) RANGE_SIZE bytes in parallel, passing each
+        // result to consumer in file order, as soon as it is ready
+        // note - only a few ranges are parsed ahead of consumer, so results never pile up for whole file
+        template<typename Result, typename Class, typename Consumer>
+        static void RunOrdered(Class* object,
+                               Result (Class::*parse)(const char*, GTextIndexChunk),
+                               const char* data,
+                               qint64 size,
+                               Consumer& consumer);
+
+    // files smaller than this are not worth splitting up
+    public:
+        static const qint64 MIN_FILE_SIZE;
+        static const qint64 RANGE_SIZE;
+};
+
+// collects results, in the order given
+template<typename Result>
+struct GParallelTextCollector {
+    QList<Result> Results;
+    void operator()(const Result& result) { Results.append(result); }
+};
+
+// pool task that helps parse a job's ranges
+template<typename Job>
+class GParallelTextHelper : public QRunnable {
+
+    public:
+        GParallelTextHelper(Job* job) : m_job(job) { setAutoDelete(true); }
+        void run(void) { m_job->HelpParse(); }
+
+    private:
+        Job* m_job;
+};
+
+// parses ranges in parallel, at most 'maxPending' ahead of the (in-order) consumer
+// note - helpers are only started if a pool thread is free right away, and the calling thread
+//        parses any range not yet claimed, so a busy (or re-entered) pool never stalls the job
+template<typename Result, typename Class>
+class GParallelTextJob {
+
+    public:
+        typedef Result (Class::*ParseMethod)(const char*, GTextIndexChunk);
+        GParallelTextJob(Class* object, ParseMethod parse, const char* data,
+                         const GTextIndexChunkList& ranges, int maxPending);
+
+    public:
+        // parses all ranges, passing each result to consumer in file order
+        template<typename Consumer>
+        void Run(Consumer& consumer);
+        // parses ranges until none left to claim (run by helper tasks)
+        void HelpParse(void);
+
+    // 'internal' methods (called with mutex locked)
+    private:
+        bool ParseNext(QMutexLocker& locker);
+        void StartHelpers(void);
+
+    private:
+        Class*       m_object;
+        ParseMethod  m_parse;
+        const char*  m_data;
+        GTextIndexChunkList m_ranges;
+        QVector<Result> m_results;
+        QVector<bool>   m_isDone;
+        int m_nextRange;
+        int m_windowEnd;
+        int m_maxPending;
+        int m_helperCount;
+        QMutex         m_mutex;
+        QWaitCondition m_changed;
+};
+
+inline
+bool GParallelTextParser::NextLine(const char* data, qint64 stop, qint64& position, GFieldView& line) {
+
+    if ( position >= stop ) { return false; }
+
+    // find end of line (or range)
+    const char* begin   = data + position;
+    const char* newline = (const char*)memchr(begin, '\n', (size_t)(stop - position));
+    const qint64 length = ( newline ? (newline - begin) + 1 : (stop - position) );
+
+    line = GFieldView(begin, (int)length);
+    position += length;
+    return true;
+}
+
+template<typename Result, typename Class>
+QList<Result> GParallelTextParser::Run(Class* object,
+                                       Result (Class::*parse)(const char*, GTextIndexChunk),
+                                       const char* data,
+                                       qint64 size)
+{
+    // parse one range per thread, all at once
+    // note - caller may itself be running in the pool (e.g. background store loading), but never
+    //        waits on queued tasks: it parses any range no free pool thread has picked up
+    const GTextIndexChunkList ranges = SplitLines(data, size, qMax(1, QThread::idealThreadCount()));
+    GParallelTextJob<Result, Class> job(object, parse, data, ranges, ranges.size());
+    GParallelTextCollector<Result> collector;
+    job.Run(collector);
+    return collector.Results;
+}
+
+template<typename Result, typename Class, typename Consumer>
+void GParallelTextParser::RunOrdered(Class* object,
+                                     Result (Class::*parse)(const char*, GTextIndexChunk),
+                                     const char* data,
+                                     qint64 size,
+                                     Consumer& consumer)
+{
+    const int threadCount = qMax(1, QThread::idealThreadCount());
+    const int rangeCount  = (int)qMax( (qint64)threadCount, size / RANGE_SIZE );
+    GParallelTextJob<Result, Class> job(object, parse, data, SplitLines(data, size, rangeCount), threadCount * 2);
+    job.Run(consumer);
+}
+
+template<typename Result, typename Class>
+GParallelTextJob<Result, Class>::GParallelTextJob(Class* object, ParseMethod parse, const char* data,
+                                                  const GTextIndexChunkList& ranges, int maxPending)
+    : m_object(object)
+    , m_parse(parse)
+    , m_data(data)
+    , m_ranges(ranges)
+    , m_results(ranges.size())
+    , m_isDone(ranges.size(), false)
+    , m_nextRange(0)
+    , m_windowEnd( qMin(qMax(1, maxPending), ranges.size()) )
+    , m_maxPending( qMax(1, maxPending) )
+    , m_helperCount(0)
+{ }
+
+template<typename Result, typename Class> template<typename Consumer>
+void GParallelTextJob<Result, Class>::Run(Consumer& consumer) {
+
+    QMutexLocker locker(&m_mutex);
+    for ( int i = 0; i < m_ranges.size(); ++i ) {
+
+        // parse (or wait for) next range in file order
+        StartHelpers();
+        while ( !m_isDone.at(i) ) {
+            if ( !ParseNext(locker) ) { m_changed.wait(&m_mutex); }
+        }
+
+        // take its result & let parsing move ahead
+        const Result result = m_results.at(i);
+        m_results[i] = Result();
+        m_windowEnd = qMin(i + 1 + m_maxPending, m_ranges.size());
+
+        locker.unlock();
+        consumer(result);
+        locker.relock();
+    }
+
+    // wait for helpers to finish up (they may still be checking for work)
+    while ( m_helperCount > 0 ) { m_changed.wait(&m_mutex); }
+}
+
+template<typename Result, typename Class>
+void GParallelTextJob<Result, Class>::HelpParse(void) {
+    QMutexLocker locker(&m_mutex);
+    while ( ParseNext(locker) ) { }
+    --m_helperCount;
+    m_changed.wakeAll();
+}
+
+// claims & parses next range in window, returns false if none left
+template<typename Result, typename Class>
+bool GParallelTextJob<Result, Class>::ParseNext(QMutexLocker& locker) {
+
+    if ( m_nextRange >= m_windowEnd ) { return false; }
+    const int index = m_nextRange++;
+
+    locker.unlock();
+    const Result result = (m_object->*m_parse)(m_data, m_ranges.at(index));
+    locker.relock();
+
+    m_results[index] = result;
+    m_isDone[index]  = true;
+    m_changed.wakeAll();
+    return true;
+}
+
+// starts helpers for unclaimed ranges in window, on free pool threads only
+template<typename Result, typename Class>
+void GParallelTextJob<Result, Class>::StartHelpers(void) {
+    const int wanted = qMin(m_windowEnd - m_nextRange, m_maxPending - 1);
+    while ( m_helperCount < wanted ) {
+        GParallelTextHelper<GParallelTextJob>* helper = new GParallelTextHelper<GParallelTextJob>(this);
+        if ( !QThreadPool::globalInstance()->tryStart(helper) ) {
+            delete helper;
+            break;
+        }
+        ++m_helperCount;
+    }
+}
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_PARALLELTEXTPARSER_H
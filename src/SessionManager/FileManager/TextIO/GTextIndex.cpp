@@ -0,0 +1,759 @@
+// ***************************************************************************
+// GTextIndex.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a binned/linear interval index over tab-delimited text data.
+// Index maps (reference, position bin) to the file offsets of overlapping lines,
+// using the same binning scheme as BAM (.bai) and tabix (.tbi) indexes.
+// Plain text indexes are built on first open and saved as a '.gti' sidecar,
+// bgzipped files use their standard tabix index.
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtDebug>
+#include <QtEndian>
+#include "SessionManager/FileManager/TextIO/GFieldTokenizer.h"
+#include "SessionManager/FileManager/TextIO/GParallelTextParser.h"
+#include "SessionManager/FileManager/TextIO/GTextIndex.h"
+#include "SessionManager/FileManager/FormatManagerPlugins/GBamFormatManager/BGZF.h"
+using namespace Gambit;
+using namespace Gambit::FileIO;
+
+// define static version data
+const quint32 GTextIndex::MAGIC_NUMBER    = 0x47544901; // "GTI\1"
+const quint32 GTextIndex::CURRENT_VERSION = 100;
+
+// index data for one byte range of a file (ranges are scanned in parallel, then merged in file order)
+struct Gambit::FileIO::GTextIndexPartial {
+
+    // contiguous block of lines on same reference
+    struct Run {
+        int    Ref;
+        qint32 FirstBegin;
+        qint32 LastBegin;
+    };
+
+    // data members
+    GTextIndex   Index;
+    QVector<Run> Runs;
+};
+
+// tabix constants
+static const char    TABIX_MAGIC[4]  = { 'T', 'B', 'I', 1 };
+static const quint32 TABIX_META_BIN  = 37450; // pseudo-bin holding summary data, not file chunks
+
+GTextIndex::GTextIndex(const GTextIndexFormat& format)
+    : m_format(format)
+    , m_isSorted(true)
+{ }
+
+GTextIndex::~GTextIndex(void) { }
+
+void GTextIndex::Clear(void) {
+    m_names.clear();
+    m_nameLookup.clear();
+    m_references.clear();
+    m_isSorted = true;
+}
+
+bool GTextIndex::Build(QFile& file, GTextLineVisitor* visitor) {
+
+    // clear any existing index data
+    Clear();
+
+    // check valid file
+    if ( !file.isOpen() ) { return false; }
+    if ( !file.seek(0) )  { return false; }
+
+    // large files are scanned in parallel (if file can be mapped), partial indexes are merged in file order
+    const qint64 fileSize = file.size();
+    if ( (visitor == 0) && (fileSize >= GParallelTextParser::MIN_FILE_SIZE) && (m_format.LinesToSkip == 0) ) {
+        uchar* data = file.map(0, fileSize);
+        if ( data ) {
+            const QList<GTextIndexPartial> partials =
+                GParallelTextParser::Run(this, &GTextIndex::ScanRange, (const char*)data, fileSize);
+            file.unmap(data);
+
+            int    lastRef   = -1;
+            qint32 lastBegin = -1;
+            foreach ( const GTextIndexPartial& partial, partials ) {
+                MergePartial(partial, lastRef, lastBegin);
+            }
+
+            FinalizeLinearOffsets();
+            file.seek(0);
+            return true;
+        }
+    }
+
+    // per-line parsing variables
+    QByteArray      buffer;
+    int             length = 0;
+    GFieldTokenizer fields;
+    GFieldView      refName;
+    qint32     begin = 0;
+    qint32     end   = 0;
+    qint32     lineNumber = 0;
+
+    // current reference data
+    QByteArray currentName;
+    QString    currentRefName;
+    int        currentRef = -1;
+    qint32     lastBegin  = -1;
+
+    // while data exists
+    while ( true ) {
+
+        // get line data & file offsets, stop if EOF
+        const qint64 lineStart = file.pos();
+        if ( !ReadLine(file, buffer, length) ) { break; }
+        const qint64 lineStop  = file.pos();
+        ++lineNumber;
+
+        // skip header lines, comments, & any non-interval entries
+        if ( lineNumber <= m_format.LinesToSkip ) { continue; }
+        fields.SetLine(buffer.constData(), length);
+        if ( !ParseInterval(fields, m_format, refName, begin, end) ) { continue; }
+
+        // if new reference found
+        if ( (currentRef == -1) || (refName != currentName) ) {
+
+            bool isNew = false;
+            currentName    = refName.ToByteArray();
+            currentRefName = refName.ToString();
+            currentRef     = ReferenceId(currentName, isNew);
+            lastBegin      = -1;
+
+            // if reference seen before, its entries are not contiguous
+            if ( !isNew ) { m_isSorted = false; }
+        }
+
+        // otherwise, check sort order
+        else if ( begin < lastBegin ) { m_isSorted = false; }
+        lastBegin = begin;
+
+        // store bin chunk & linear offset entries for this line
+        GTextReferenceIndex& refIndex = m_references[currentRef];
+        InsertChunk(refIndex.Bins[RegionToBin(begin, end)], lineStart, lineStop);
+        InsertLinearOffset(refIndex.Offsets, begin, end, lineStart);
+
+        // pass line on to any visitor
+        if ( visitor ) { visitor->VisitLine(currentRefName, fields); }
+    }
+
+    // clean up linear index, rewind file & return success
+    FinalizeLinearOffsets();
+    file.seek(0);
+    return true;
+}
+
+// builds partial index for lines in byte range (of mapped file data)
+// note - runs concurrently with other ranges, only reads this index's format
+GTextIndexPartial GTextIndex::ScanRange(const char* data, GTextIndexChunk range) {
+
+    GTextIndexPartial partial;
+    GTextIndex& index = partial.Index;
+    index.m_format = m_format;
+
+    // per-line parsing variables
+    GFieldTokenizer fields;
+    GFieldView      line;
+    GFieldView      refName;
+    qint32 begin = 0;
+    qint32 end   = 0;
+
+    // current reference data
+    QByteArray currentName;
+    int        currentRef = -1;
+
+    // while range data exists
+    qint64 position = range.Start;
+    while ( true ) {
+
+        // get line data & file offsets, stop if end of range
+        const qint64 lineStart = position;
+        if ( !GParallelTextParser::NextLine(data, range.Stop, position, line) ) { break; }
+        const qint64 lineStop = position;
+
+        // skip header lines, comments, & any non-interval entries
+        fields.SetLine(line);
+        if ( !ParseInterval(fields, m_format, refName, begin, end) ) { continue; }
+
+        // if new reference found, start new run
+        if ( (currentRef == -1) || (refName != currentName) ) {
+
+            bool isNew = false;
+            currentName = refName.ToByteArray();
+            currentRef  = index.ReferenceId(currentName, isNew);
+
+            // if reference seen before (in this range), its entries are not contiguous
+            if ( !isNew ) { index.m_isSorted = false; }
+
+            GTextIndexPartial::Run run = { currentRef, begin, begin };
+            partial.Runs.append(run);
+        }
+
+        // otherwise, check sort order
+        else if ( begin < partial.Runs.last().LastBegin ) { index.m_isSorted = false; }
+        partial.Runs.last().LastBegin = begin;
+
+        // store bin chunk & linear offset entries for this line
+        GTextReferenceIndex& refIndex = index.m_references[currentRef];
+        index.InsertChunk(refIndex.Bins[RegionToBin(begin, end)], lineStart, lineStop);
+        index.InsertLinearOffset(refIndex.Offsets, begin, end, lineStart);
+    }
+
+    return partial;
+}
+
+// merges partial index (from next byte range in file) into this index
+// note - lastRef & lastBegin carry reference/sort-order state across ranges
+void GTextIndex::MergePartial(const GTextIndexPartial& partial, int& lastRef, qint32& lastBegin) {
+
+    const GTextIndex& index = partial.Index;
+    if ( !index.m_isSorted ) { m_isSorted = false; }
+
+    // map partial's references to IDs here (in file order), checking that entries stay contiguous & sorted
+    QVector<int> ids(index.m_names.size());
+    foreach ( const GTextIndexPartial::Run& run, partial.Runs ) {
+        bool isNew = false;
+        const int id = ReferenceId(index.m_names.at(run.Ref).toLatin1(), isNew);
+        if ( id == lastRef ) {
+            if ( run.FirstBegin < lastBegin ) { m_isSorted = false; }
+        } else if ( !isNew ) { m_isSorted = false; }
+        ids[run.Ref] = id;
+        lastRef   = id;
+        lastBegin = run.LastBegin;
+    }
+
+    // merge each reference's index data
+    for ( int i = 0; i < index.m_references.size(); ++i ) {
+        const GTextReferenceIndex& partialIndex = index.m_references.at(i);
+        GTextReferenceIndex& refIndex = m_references[ids.at(i)];
+
+        // append chunks (ranges are merged in file order, so offsets only increase)
+        GTextIndexBinMap::const_iterator binIter = partialIndex.Bins.constBegin();
+        GTextIndexBinMap::const_iterator binEnd  = partialIndex.Bins.constEnd();
+        for ( ; binIter != binEnd; ++binIter ) {
+            GTextIndexChunkList& chunks = refIndex.Bins[binIter.key()];
+            foreach ( const GTextIndexChunk& chunk, binIter.value() ) {
+                InsertChunk(chunks, chunk.Start, chunk.Stop);
+            }
+        }
+
+        // keep minimum offset for each window ('-1' marks empty windows)
+        const GTextIndexOffsetList& partialOffsets = partialIndex.Offsets;
+        GTextIndexOffsetList& offsets = refIndex.Offsets;
+        const int oldSize = offsets.size();
+        if ( oldSize < partialOffsets.size() ) {
+            offsets.resize(partialOffsets.size());
+            for ( int j = oldSize; j < offsets.size(); ++j ) { offsets[j] = -1; }
+        }
+        for ( int j = 0; j < partialOffsets.size(); ++j ) {
+            const qint64 offset = partialOffsets.at(j);
+            if ( (offset != -1) && ((offsets.at(j) == -1) || (offset < offsets.at(j))) ) {
+                offsets[j] = offset;
+            }
+        }
+    }
+}
+
+GTextIndexChunkList GTextIndex::Chunks(const QString& refName, qint32 begin, qint32 end) const {
+
+    GTextIndexChunkList chunks;
+
+    // look up reference, skip if not found
+    QHash<QString, int>::const_iterator nameIter = m_nameLookup.constFind(refName);
+    if ( nameIter == m_nameLookup.constEnd() ) { return chunks; }
+    const GTextReferenceIndex& refIndex = m_references.at(nameIter.value());
+
+    // sanity check on coordinates
+    if ( begin < 0 ) { begin = 0; }
+    if ( end <= begin ) { end = begin + 1; }
+
+    // get minimum offset to consider from linear index
+    // (only valid if entries are position-sorted)
+    qint64 minOffset = 0;
+    if ( m_isSorted && !refIndex.Offsets.isEmpty() ) {
+        int window = (begin >> GTextIndex::MIN_SHIFT);
+        if ( window >= refIndex.Offsets.size() ) { window = refIndex.Offsets.size() - 1; }
+        minOffset = refIndex.Offsets.at(window);
+    }
+
+    // store all chunks, from all bins overlapping this region, that end beyond minOffset
+    const QVector<quint32> bins = RegionToBins(begin, end);
+    foreach ( quint32 bin, bins ) {
+        GTextIndexBinMap::const_iterator binIter = refIndex.Bins.constFind(bin);
+        if ( binIter == refIndex.Bins.constEnd() ) { continue; }
+        foreach ( const GTextIndexChunk& chunk, binIter.value() ) {
+            if ( chunk.Stop > minOffset ) { chunks.append(chunk); }
+        }
+    }
+    return MergeChunks(chunks);
+}
+
+GTextIndexChunkList GTextIndex::Chunks(const QString& refName) const {
+
+    GTextIndexChunkList chunks;
+
+    // look up reference, skip if not found
+    QHash<QString, int>::const_iterator nameIter = m_nameLookup.constFind(refName);
+    if ( nameIter == m_nameLookup.constEnd() ) { return chunks; }
+    const GTextReferenceIndex& refIndex = m_references.at(nameIter.value());
+
+    // store chunks from all bins
+    GTextIndexBinMap::const_iterator binIter = refIndex.Bins.constBegin();
+    GTextIndexBinMap::const_iterator binEnd  = refIndex.Bins.constEnd();
+    for ( ; binIter != binEnd; ++binIter ) {
+        foreach ( const GTextIndexChunk& chunk, binIter.value() ) {
+            chunks.append(chunk);
+        }
+    }
+    return MergeChunks(chunks);
+}
+
+// sorts chunks by offset & merges any overlapping/adjacent chunks
+GTextIndexChunkList GTextIndex::MergeChunks(GTextIndexChunkList& chunks) {
+
+    if ( chunks.isEmpty() ) { return chunks; }
+
+    qSort(chunks.begin(), chunks.end());
+    GTextIndexChunkList merged;
+    merged.append(chunks.first());
+    for ( int i = 1; i < chunks.size(); ++i ) {
+        const GTextIndexChunk& chunk = chunks.at(i);
+        GTextIndexChunk& last = merged.last();
+        if ( chunk.Start <= last.Stop ) {
+            if ( chunk.Stop > last.Stop ) { last.Stop = chunk.Stop; }
+        } else {
+            merged.append(chunk);
+        }
+    }
+    return merged;
+}
+
+bool GTextIndex::Load(const QString& indexFilename, const QString& dataFilename) {
+
+    // clear any existing index data
+    Clear();
+
+    // open index file
+    QFile indexFile(indexFilename);
+    if ( !indexFile.exists() ) { return false; }
+    if ( !indexFile.open(QIODevice::ReadOnly) ) { return false; }
+
+    // initialize data stream
+    QDataStream in(&indexFile);
+    in.setVersion(QDataStream::Qt_4_5);
+
+    // read and validate 'magic number' & version
+    quint32 magic;
+    quint32 version;
+    in >> magic >> version;
+    if ( (magic != GTextIndex::MAGIC_NUMBER) || (version > GTextIndex::CURRENT_VERSION) ) { return false; }
+
+    // make sure index is not stale
+    qint64  fileSize;
+    quint32 fileModified;
+    in >> fileSize >> fileModified;
+    QFileInfo dataInfo(dataFilename);
+    if ( (fileSize != dataInfo.size()) || (fileModified != dataInfo.lastModified().toTime_t()) ) { return false; }
+
+    // make sure index was built using same file layout
+    GTextIndexFormat format;
+    qint8 metaChar;
+    in >> format.Preset >> format.SequenceColumn >> format.BeginColumn >> format.EndColumn >> metaChar >> format.LinesToSkip;
+    format.MetaChar = (char)metaChar;
+    if ( (format.Preset         != m_format.Preset)         ||
+         (format.SequenceColumn != m_format.SequenceColumn) ||
+         (format.BeginColumn    != m_format.BeginColumn)    ||
+         (format.EndColumn      != m_format.EndColumn) )
+    {
+        return false;
+    }
+
+    // read reference names
+    in >> m_isSorted;
+    in >> m_names;
+    m_references.resize(m_names.size());
+
+    // read reference index data
+    for ( int i = 0; i < m_names.size(); ++i ) {
+        m_nameLookup.insert(m_names.at(i), i);
+        GTextReferenceIndex& refIndex = m_references[i];
+
+        // read bins
+        quint32 numBins;
+        in >> numBins;
+        for ( quint32 j = 0; j < numBins; ++j ) {
+
+            quint32 bin;
+            quint32 numChunks;
+            in >> bin >> numChunks;
+
+            GTextIndexChunkList& chunks = refIndex.Bins[bin];
+            chunks.reserve(numChunks);
+            for ( quint32 k = 0; k < numChunks; ++k ) {
+                qint64 start;
+                qint64 stop;
+                in >> start >> stop;
+                chunks.append( GTextIndexChunk(start, stop) );
+            }
+        }
+
+        // read linear offsets
+        in >> refIndex.Offsets;
+    }
+
+    // check for any read errors
+    if ( in.status() != QDataStream::Ok ) {
+        qDebug() << "GTextIndex::Load() => corrupt index file:" << indexFilename;
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool GTextIndex::LoadTabix(const QString& indexFilename) {
+
+    // clear any existing index data
+    Clear();
+
+    // make sure index file is readable (BgzfData::Open() exits on failure)
+    QFileInfo indexInfo(indexFilename);
+    if ( !indexInfo.exists() || !indexInfo.isReadable() ) { return false; }
+
+    // open (BGZF-compressed) index file & read contents
+    BamTools::BgzfData bgzf;
+    bgzf.Open(indexFilename.toStdString(), "rb");
+    const bool result = ReadTabix(bgzf);
+    bgzf.Close();
+
+    // check for any read errors
+    if ( !result ) {
+        qDebug() << "GTextIndex::LoadTabix() => corrupt index file:" << indexFilename;
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool GTextIndex::Save(const QString& indexFilename, const QString& dataFilename) const {
+
+    // open index file
+    QFile indexFile(indexFilename);
+    if ( !indexFile.open(QIODevice::WriteOnly) ) { return false; }
+
+    // initialize data stream
+    QDataStream out(&indexFile);
+    out.setVersion(QDataStream::Qt_4_5);
+
+    // save header - 'magic number', version, & data file stats
+    QFileInfo dataInfo(dataFilename);
+    out << GTextIndex::MAGIC_NUMBER << GTextIndex::CURRENT_VERSION;
+    out << (qint64)dataInfo.size() << (quint32)dataInfo.lastModified().toTime_t();
+
+    // save file layout
+    out << m_format.Preset << m_format.SequenceColumn << m_format.BeginColumn << m_format.EndColumn;
+    out << (qint8)m_format.MetaChar << m_format.LinesToSkip;
+
+    // save reference names
+    out << m_isSorted;
+    out << m_names;
+
+    // save reference index data
+    foreach ( const GTextReferenceIndex& refIndex, m_references ) {
+
+        // save bins
+        out << (quint32)refIndex.Bins.size();
+        GTextIndexBinMap::const_iterator binIter = refIndex.Bins.constBegin();
+        GTextIndexBinMap::const_iterator binEnd  = refIndex.Bins.constEnd();
+        for ( ; binIter != binEnd; ++binIter ) {
+            const GTextIndexChunkList& chunks = binIter.value();
+            out << binIter.key() << (quint32)chunks.size();
+            foreach ( const GTextIndexChunk& chunk, chunks ) {
+                out << chunk.Start << chunk.Stop;
+            }
+        }
+
+        // save linear offsets
+        out << refIndex.Offsets;
+    }
+
+    // clean up & return success
+    indexFile.close();
+    return ( out.status() == QDataStream::Ok );
+}
+
+QString GTextIndex::SidecarFilename(const QString& dataFilename) {
+    return dataFilename + QString(".gti");
+}
+
+QString GTextIndex::TabixFilename(const QString& dataFilename) {
+    return dataFilename + QString(".tbi");
+}
+
+bool GTextIndex::ParseInterval(GFieldTokenizer& fields,
+                               const GTextIndexFormat& format,
+                               GFieldView& refName,
+                               qint32& begin,
+                               qint32& end)
+{
+    // skip empty lines & comments
+    if ( fields.LineLength() == 0 ) { return false; }
+    if ( fields.Line()[0] == format.MetaChar ) { return false; }
+
+    // get reference name (missing column has no data)
+    refName = fields.Field(format.SequenceColumn - 1);
+    if ( refName.Data == 0 ) { return false; }
+
+    // get begin position
+    bool ok = false;
+    begin = fields.Field(format.BeginColumn - 1).ToInt(&ok);
+    if ( !ok || (begin < 0) ) { return false; }
+
+    // get end position, if available
+    bool hasEnd = false;
+    if ( format.EndColumn > 0 ) {
+        const GFieldView endField = fields.Field(format.EndColumn - 1);
+        if ( endField.Data != 0 ) {
+            end = endField.ToInt(&ok);
+            if ( !ok || (end < 0) ) { return false; }
+            hasEnd = true;
+        }
+    }
+
+    // convert begin to 0-based
+    if ( !format.IsZeroBased() ) { --begin; }
+
+    // determine end (VCF uses REF allele length for interval end)
+    if ( format.IsVcf() ) {
+        const int refAlleleColumn = 3;
+        end = begin + fields.Field(refAlleleColumn).Length;
+    } else if ( !hasEnd ) {
+        end = begin + 1;
+    }
+
+    // ensure non-empty interval
+    if ( begin < 0 ) { begin = 0; }
+    if ( end <= begin ) { end = begin + 1; }
+    return true;
+}
+
+bool GTextIndex::ReadLine(QIODevice& device, QByteArray& buffer, int& length) {
+
+    // make sure buffer has some room
+    const int initialBufferSize = 4096;
+    if ( buffer.size() < initialBufferSize ) { buffer.resize(initialBufferSize); }
+
+    // read until end of line (growing buffer for long lines)
+    length = 0;
+    while ( true ) {
+        const qint64 numBytesRead = device.readLine(buffer.data() + length, buffer.size() - length);
+        if ( numBytesRead <= 0 ) { return ( length > 0 ); }
+        length += (int)numBytesRead;
+
+        // done if newline found, or if read stopped short of filling buffer (EOF)
+        if ( buffer.at(length - 1) == '\n' ) { return true; }
+        if ( length < (buffer.size() - 1) )  { return true; }
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+// calculates bin for interval [begin, end)
+quint32 GTextIndex::RegionToBin(qint32 begin, qint32 end) {
+    --end;
+    if ( (begin>>14) == (end>>14) ) { return 4681 + (begin>>14); }
+    if ( (begin>>17) == (end>>17) ) { return  585 + (begin>>17); }
+    if ( (begin>>20) == (end>>20) ) { return   73 + (begin>>20); }
+    if ( (begin>>23) == (end>>23) ) { return    9 + (begin>>23); }
+    if ( (begin>>26) == (end>>26) ) { return    1 + (begin>>26); }
+    return 0;
+}
+
+// calculates all bins that may overlap interval [begin, end)
+QVector<quint32> GTextIndex::RegionToBins(qint32 begin, qint32 end) {
+
+    QVector<quint32> bins;
+    --end;
+
+    // bin '0' always a valid bin
+    bins.append(0);
+
+    // get rest of bins that contain this region
+    quint32 k;
+    for ( k =    1 + (begin>>26); k <=    1 + (quint32)(end>>26); ++k ) { bins.append(k); }
+    for ( k =    9 + (begin>>23); k <=    9 + (quint32)(end>>23); ++k ) { bins.append(k); }
+    for ( k =   73 + (begin>>20); k <=   73 + (quint32)(end>>20); ++k ) { bins.append(k); }
+    for ( k =  585 + (begin>>17); k <=  585 + (quint32)(end>>17); ++k ) { bins.append(k); }
+    for ( k = 4681 + (begin>>14); k <= 4681 + (quint32)(end>>14); ++k ) { bins.append(k); }
+    return bins;
+}
+
+// reads little-endian integer value from BGZF stream, returns success/fail
+template<typename T>
+static inline
+bool ReadValue(BamTools::BgzfData& bgzf, T& value) {
+    uchar buffer[sizeof(T)];
+    if ( bgzf.Read((char*)buffer, sizeof(T)) != (int)sizeof(T) ) { return false; }
+    value = qFromLittleEndian<T>(buffer);
+    return true;
+}
+
+bool GTextIndex::ReadTabix(BamTools::BgzfData& bgzf) {
+
+    // check 'magic number'
+    char magic[4];
+    if ( bgzf.Read(magic, 4) != 4 ) { return false; }
+    if ( memcmp(magic, TABIX_MAGIC, 4) != 0 ) { return false; }
+
+    // read file layout (replaces any preset format)
+    qint32 numReferences;
+    qint32 metaChar;
+    if ( !ReadValue(bgzf, numReferences)            ||
+         !ReadValue(bgzf, m_format.Preset)          ||
+         !ReadValue(bgzf, m_format.SequenceColumn)  ||
+         !ReadValue(bgzf, m_format.BeginColumn)     ||
+         !ReadValue(bgzf, m_format.EndColumn)       ||
+         !ReadValue(bgzf, metaChar)                 ||
+         !ReadValue(bgzf, m_format.LinesToSkip) )
+    {
+        return false;
+    }
+    m_format.MetaChar = (char)metaChar;
+    if ( numReferences < 0 ) { return false; }
+
+    // read reference names (concatenated, null-terminated strings)
+    qint32 namesLength;
+    if ( !ReadValue(bgzf, namesLength) || (namesLength < 0) ) { return false; }
+    QByteArray names(namesLength, '\0');
+    if ( bgzf.Read(names.data(), namesLength) != namesLength ) { return false; }
+    const QList<QByteArray> nameList = names.split('\0');
+    if ( nameList.size() < numReferences ) { return false; }
+    for ( int i = 0; i < numReferences; ++i ) {
+        bool isNew = false;
+        ReferenceId(nameList.at(i), isNew);
+    }
+
+    // read reference index data
+    for ( int i = 0; i < numReferences; ++i ) {
+        GTextReferenceIndex& refIndex = m_references[i];
+
+        // read bins
+        qint32 numBins;
+        if ( !ReadValue(bgzf, numBins) ) { return false; }
+        for ( qint32 j = 0; j < numBins; ++j ) {
+
+            quint32 bin;
+            qint32  numChunks;
+            if ( !ReadValue(bgzf, bin) || !ReadValue(bgzf, numChunks) ) { return false; }
+
+            GTextIndexChunkList chunks;
+            chunks.reserve(numChunks);
+            for ( qint32 k = 0; k < numChunks; ++k ) {
+                quint64 start;
+                quint64 stop;
+                if ( !ReadValue(bgzf, start) || !ReadValue(bgzf, stop) ) { return false; }
+                chunks.append( GTextIndexChunk((qint64)start, (qint64)stop) );
+            }
+
+            // store file chunks (skip summary pseudo-bin)
+            if ( bin != TABIX_META_BIN ) { refIndex.Bins.insert(bin, chunks); }
+        }
+
+        // read linear offsets
+        qint32 numOffsets;
+        if ( !ReadValue(bgzf, numOffsets) || (numOffsets < 0) ) { return false; }
+        refIndex.Offsets.resize(numOffsets);
+        for ( qint32 j = 0; j < numOffsets; ++j ) {
+            quint64 offset;
+            if ( !ReadValue(bgzf, offset) ) { return false; }
+            refIndex.Offsets[j] = (qint64)offset;
+        }
+    }
+
+    // tabix requires position-sorted input
+    m_isSorted = true;
+    return true;
+}
+
+int GTextIndex::ReferenceId(const QByteArray& refName, bool& isNew) {
+
+    // return existing ID if found
+    const QString name = QString::fromLatin1(refName.constData(), refName.size());
+    QHash<QString, int>::const_iterator nameIter = m_nameLookup.constFind(name);
+    if ( nameIter != m_nameLookup.constEnd() ) {
+        isNew = false;
+        return nameIter.value();
+    }
+
+    // otherwise store new reference entry
+    const int id = m_names.size();
+    m_names.append(name);
+    m_nameLookup.insert(name, id);
+    m_references.append( GTextReferenceIndex() );
+    isNew = true;
+    return id;
+}
+
+void GTextIndex::InsertChunk(GTextIndexChunkList& chunks, qint64 start, qint64 stop) {
+
+    // extend last chunk if contiguous
+    if ( !chunks.isEmpty() && (chunks.last().Stop == start) ) {
+        chunks.last().Stop = stop;
+    }
+
+    // otherwise create new chunk
+    else { chunks.append( GTextIndexChunk(start, stop) ); }
+}
+
+void GTextIndex::InsertLinearOffset(GTextIndexOffsetList& offsets, qint32 begin, qint32 end, qint64 offset) {
+
+    // get window indexes covered by interval
+    const int beginWindow = (begin >> GTextIndex::MIN_SHIFT);
+    const int endWindow   = ((end - 1) >> GTextIndex::MIN_SHIFT);
+
+    // resize vector if necessary ('-1' marks empty windows)
+    const int oldSize = offsets.size();
+    if ( oldSize <= endWindow ) {
+        offsets.resize(endWindow + 1);
+        for ( int i = oldSize; i <= endWindow; ++i ) { offsets[i] = -1; }
+    }
+
+    // store minimum offset for each window
+    for ( int i = beginWindow; i <= endWindow; ++i ) {
+        if ( (offsets.at(i) == -1) || (offset < offsets.at(i)) ) {
+            offsets[i] = offset;
+        }
+    }
+}
+
+void GTextIndex::FinalizeLinearOffsets(void) {
+
+    // fill empty windows with previous window offset (leading empty windows get 0)
+    for ( int i = 0; i < m_references.size(); ++i ) {
+        GTextIndexOffsetList& offsets = m_references[i].Offsets;
+        qint64 previous = 0;
+        for ( int j = 0; j < offsets.size(); ++j ) {
+            if ( offsets.at(j) == -1 ) { offsets[j] = previous; }
+            else { previous = offsets.at(j); }
+        }
+    }
+}
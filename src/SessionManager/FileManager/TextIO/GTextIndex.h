@@ -0,0 +1,211 @@
+// ***************************************************************************
+// GTextIndex.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a binned/linear interval index over tab-delimited text data.
+// Index maps (reference, position bin) to the file offsets of overlapping lines,
+// using the same binning scheme as BAM (.bai) and tabix (.tbi) indexes.
+// Plain text indexes are built on first open and saved as a '.gti' sidecar,
+// bgzipped files use their standard tabix index.
+// ***************************************************************************
+
+#ifndef G_TEXTINDEX_H
+#define G_TEXTINDEX_H
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+class QFile;
+class QIODevice;
+namespace BamTools { struct BgzfData; }
+
+namespace Gambit {
+namespace FileIO {
+
+class  GFieldTokenizer;
+struct GFieldView;
+struct GTextIndexPartial;
+
+// describes how interval data is laid out in each line (mirrors tabix conf)
+// note - column numbers are 1-based, EndColumn of 0 means 'no end column'
+struct GTextIndexFormat {
+
+    // preset values (low 16 bits), plus flag for 0-based (half-open) coordinates
+    enum Preset { Generic   = 0
+                , Sam       = 1
+                , Vcf       = 2
+                , ZeroBased = 0x10000
+    };
+
+    // data members
+    qint32 Preset;
+    qint32 SequenceColumn;
+    qint32 BeginColumn;
+    qint32 EndColumn;
+    char   MetaChar;
+    qint32 LinesToSkip;
+
+    // constructor
+    GTextIndexFormat(qint32 preset   = GTextIndexFormat::Generic,
+                     qint32 seqCol   = 1,
+                     qint32 beginCol = 2,
+                     qint32 endCol   = 0,
+                     char   metaChar = '#',
+                     qint32 skip     = 0)
+        : Preset(preset)
+        , SequenceColumn(seqCol)
+        , BeginColumn(beginCol)
+        , EndColumn(endCol)
+        , MetaChar(metaChar)
+        , LinesToSkip(skip)
+    { }
+
+    bool IsVcf(void) const       { return ( (Preset & 0xffff) == GTextIndexFormat::Vcf ); }
+    bool IsZeroBased(void) const { return ( (Preset & GTextIndexFormat::ZeroBased) != 0 ); }
+
+    // format presets for supported text formats
+    static GTextIndexFormat BedFormat(void) { return GTextIndexFormat(GTextIndexFormat::ZeroBased, 1, 2, 3, '#', 0); }
+    static GTextIndexFormat GffFormat(void) { return GTextIndexFormat(GTextIndexFormat::Generic,   1, 4, 5, '#', 0); }
+    static GTextIndexFormat VcfFormat(void) { return GTextIndexFormat(GTextIndexFormat::Vcf,       1, 2, 0, '#', 0); }
+};
+
+// contiguous range of (virtual) file offsets [Start, Stop)
+struct GTextIndexChunk {
+
+    // data members
+    qint64 Start;
+    qint64 Stop;
+
+    // constructor
+    GTextIndexChunk(qint64 start = 0, qint64 stop = 0)
+        : Start(start)
+        , Stop(stop)
+    { }
+};
+
+inline
+bool operator< (const GTextIndexChunk& lhs, const GTextIndexChunk& rhs) {
+    return ( lhs.Start < rhs.Start );
+}
+
+typedef QVector<GTextIndexChunk>          GTextIndexChunkList;
+typedef QHash<quint32, GTextIndexChunkList> GTextIndexBinMap;
+typedef QVector<qint64>                   GTextIndexOffsetList;
+
+// index data for a single reference sequence
+struct GTextReferenceIndex {
+    GTextIndexBinMap     Bins;
+    GTextIndexOffsetList Offsets;
+};
+
+// receives each interval line read while building an index (see GTextIndex::Build())
+class GTextLineVisitor {
+    public:
+        virtual ~GTextLineVisitor(void) { }
+        virtual void VisitLine(const QString& refName, GFieldTokenizer& fields) = 0;
+};
+
+class GTextIndex {
+
+    // constructor/destructor
+    public:
+        GTextIndex(const GTextIndexFormat& format = GTextIndexFormat());
+        ~GTextIndex(void);
+
+    // index access
+    public:
+        // clears all index data
+        void Clear(void);
+        // returns the (merged, sorted) chunks that may contain lines overlapping [begin, end)
+        // note - coordinates here are 0-based, half-open
+        GTextIndexChunkList Chunks(const QString& refName, qint32 begin, qint32 end) const;
+        // returns the (merged, sorted) chunks containing all lines for reference
+        GTextIndexChunkList Chunks(const QString& refName) const;
+        // returns whether file data was found in position-sorted order
+        bool IsSorted(void) const { return m_isSorted; }
+        // returns the layout used to interpret lines
+        const GTextIndexFormat& Format(void) const { return m_format; }
+        // returns reference names found in file (in file order)
+        const QStringList& ReferenceNames(void) const { return m_names; }
+
+    // index building & I/O
+    public:
+        // builds index by scanning (plain text) file, passing each interval line to visitor (if given)
+        // note - large files are scanned in parallel, in line-aligned byte ranges (unless lines are visited)
+        bool Build(QFile& file, GTextLineVisitor* visitor = 0);
+        // loads index from '.gti' sidecar, fails if stale relative to data file
+        bool Load(const QString& indexFilename, const QString& dataFilename);
+        // saves index to '.gti' sidecar
+        bool Save(const QString& indexFilename, const QString& dataFilename) const;
+        // loads standard tabix ('.tbi') index, file layout is taken from index header
+        bool LoadTabix(const QString& indexFilename);
+        // returns default sidecar filename for data file
+        static QString SidecarFilename(const QString& dataFilename);
+        // returns default tabix index filename for (bgzipped) data file
+        static QString TabixFilename(const QString& dataFilename);
+
+    // interval utilities
+    public:
+        // parses reference name & 0-based, half-open interval from (tokenized) line, returns success/fail
+        // note - reference name column is checked first, so callers can reject lines on other references early
+        static bool ParseInterval(GFieldTokenizer& fields, const GTextIndexFormat& format,
+                                  GFieldView& refName, qint32& begin, qint32& end);
+        // reads next line into (reused) buffer, returns success/fail
+        // note - buffer is only grown as needed, so steady-state reading does not allocate
+        static bool ReadLine(QIODevice& device, QByteArray& buffer, int& length);
+        // calculates bin for interval [begin, end)
+        static quint32 RegionToBin(qint32 begin, qint32 end);
+        // calculates all bins that may overlap interval [begin, end)
+        static QVector<quint32> RegionToBins(qint32 begin, qint32 end);
+
+    // 'internal' index building helpers
+    private:
+        bool ReadTabix(BamTools::BgzfData& bgzf);
+        GTextIndexPartial ScanRange(const char* data, GTextIndexChunk range);
+        void MergePartial(const GTextIndexPartial& partial, int& lastRef, qint32& lastBegin);
+        static GTextIndexChunkList MergeChunks(GTextIndexChunkList& chunks);
+        int  ReferenceId(const QByteArray& refName, bool& isNew);
+        void InsertChunk(GTextIndexChunkList& chunks, qint64 start, qint64 stop);
+        void InsertLinearOffset(GTextIndexOffsetList& offsets, qint32 begin, qint32 end, qint64 offset);
+        void FinalizeLinearOffsets(void);
+
+    // data members
+    private:
+        GTextIndexFormat             m_format;
+        QStringList                  m_names;
+        QHash<QString, int>          m_nameLookup;
+        QVector<GTextReferenceIndex> m_references;
+        bool                         m_isSorted;
+
+    // version data
+    private:
+        static const quint32 MAGIC_NUMBER;
+        static const quint32 CURRENT_VERSION;
+
+    // binning constants (same as BAM/tabix)
+    public:
+        static const int MIN_SHIFT = 14;
+        static const int DEPTH     = 5;
+};
+
+} // namespace FileIO
+} // namespace Gambit
+
+#endif // G_TEXTINDEX_H
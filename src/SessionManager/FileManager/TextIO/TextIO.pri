@@ -0,0 +1,23 @@
+# Shared tab-delimited text file support for annotation format plugins
+INCLUDEPATH += $$PWD/../../../
+HEADERS     += $$PWD/GAnnotationStore.h \
+               $$PWD/GFieldTokenizer.h \
+               $$PWD/GHandlePool.h \
+               $$PWD/GIndexedTextFile.h \
+               $$PWD/GIndexedTextReader.h \
+               $$PWD/GNameIndex.h \
+               $$PWD/GParallelTextParser.h \
+               $$PWD/GTextIndex.h \
+               $$PWD/../FormatManagerPlugins/GBamFormatManager/BGZF.h
+SOURCES     += $$PWD/GAnnotationStore.cpp \
+               $$PWD/GFieldTokenizer.cpp \
+               $$PWD/GIndexedTextFile.cpp \
+               $$PWD/GIndexedTextReader.cpp \
+               $$PWD/GNameIndex.cpp \
+               $$PWD/GParallelTextParser.cpp \
+               $$PWD/GTextIndex.cpp \
+               $$PWD/../FormatManagerPlugins/GBamFormatManager/BGZF.cpp
+
+# BGZF support uses native zlib on non-Windows platforms (bundled headers on Windows)
+!win32:LIBS += -lz
+win32:INCLUDEPATH += $$PWD/../FormatManagerPlugins/GBamFormatManager
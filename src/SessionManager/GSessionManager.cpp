@@ -29,8 +29,10 @@
 
 #include <QtGui>
 #include <QtDebug>
+#include <QtConcurrentRun>
 #include "SessionManager/GSessionManager.h"
 #include "SessionManager/DataManager/GDataManager.h"
+#include "SessionManager/DataManager/GRegionCache.h"
 #include "SessionManager/FileManager/GFileManager.h"
 #include "SessionManager/FileManager/GFilenameDialog.h"
 using namespace Gambit;
@@ -52,9 +54,24 @@ class GSessionManager::GSessionManagerPrivate {
         void OpenFiles(const GFileInfoList& files = GFileInfoList());
         void CloseFiles(const GFileInfoList& files = GFileInfoList());
         GGenomicDataSet LoadData(const GGenomicDataRegion& region);
+        // run on worker thread, only file & data managers are used
+        GGenomicDataSet ExtendData(GGenomicDataSet data, GGenomicDataRegion delta, GGenomicDataRegion keep);
+        // waits for any running extension, and discards its result
+        void CancelExtension(void);
+        // run on worker thread, loads region in pieces until done or cancelled
+        GGenomicDataSet PrefetchData(GGenomicDataRegion region);
+        // queues regions next to viewer's region, in likely order of use
+        void QueuePrefetch(const GGenomicDataRegion& region);
+        // stops prefetching (waits for current piece, caches whatever was loaded)
+        void CancelPrefetch(void);
+        // starts name search on worker thread
+        void StartSearch(const QString& prefix);
+        // waits for any running name search, and discards its result (& any queued search)
+        void CancelSearch(void);
 
     // internally used methods
     private:
+        const QString CacheContext(void);
         void          ClearCurrent(void);
         bool          ConfirmSaveFromUser(void);
         const QString GetLoadFilenameFromUser(void);
@@ -65,6 +82,36 @@ class GSessionManager::GSessionManagerPrivate {
         GDataManager* dataManager;
         GFileManager* fileManager;
 
+        // recently processed data sets
+        GRegionCache regionCache;
+
+        // data currently shown by viewer, and its pending extension
+        GGenomicDataSet viewerData;
+        QFutureWatcher<GGenomicDataSet> extendWatcher;
+        bool isExtending;
+
+        // background loading of regions next to viewer's, into region cache
+        QFutureWatcher<GGenomicDataSet> prefetchWatcher;
+        QList<GGenomicDataRegion> prefetchQueue;
+        QAtomicInt prefetchCancelled;
+        bool isPrefetching;
+        GGenomicDataRegion lastRegion;
+        int panDirection;   // of last viewer request: -1 left, 1 right, 0 unknown
+
+        // background name searches (one at a time, only latest queued prefix is kept)
+        QFutureWatcher<GFeatureNameList> searchWatcher;
+        QString searchPrefix;
+        QString queuedPrefix;
+        bool isSearching;
+        bool isSearchQueued;
+
+        // whether viewer shows genotypes (otherwise they are not loaded)
+        bool isGenotypesVisible;
+
+        static const int PREFETCH_PIECES;
+        static const int PREFETCH_RETRY_MS;
+        static const int MAX_NAME_MATCHES;
+
     // true internally used data members
     private:
         QString  filename;
@@ -78,6 +125,13 @@ class GSessionManager::GSessionManagerPrivate {
         static quint32 CURRENT_VERSION;
 };
 
+// prefetch settings
+const int GSessionManager::GSessionManagerPrivate::PREFETCH_PIECES   = 4;
+const int GSessionManager::GSessionManagerPrivate::PREFETCH_RETRY_MS = 250;
+
+// limit name matches to what a completion popup can reasonably show
+const int GSessionManager::GSessionManagerPrivate::MAX_NAME_MATCHES = 50;
+
 // define static version data
 quint32 GSessionManager::GSessionManagerPrivate::MAGIC_NUMBER    = 0x10311301;
 quint32 GSessionManager::GSessionManagerPrivate::FIRST_VERSION   = 100;
@@ -86,6 +140,13 @@ quint32 GSessionManager::GSessionManagerPrivate::CURRENT_VERSION = 100;
 GSessionManager::GSessionManagerPrivate::GSessionManagerPrivate(QObject* parentObj)
     : dataManager( new GDataManager )
     , fileManager( new GFileManager )
+    , isExtending(false)
+    , prefetchCancelled(0)
+    , isPrefetching(false)
+    , panDirection(0)
+    , isSearching(false)
+    , isSearchQueued(false)
+    , isGenotypesVisible(false)
     , filename("")
     , isSessionActive(false)
     , parent(parentObj)
@@ -93,6 +154,11 @@ GSessionManager::GSessionManagerPrivate::GSessionManagerPrivate(QObject* parentO
 
 GSessionManager::GSessionManagerPrivate::~GSessionManagerPrivate(void) {
 
+    // managers must not be in use
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
+
     // destroy data manager
     if ( dataManager ) {
         delete dataManager;
@@ -114,6 +180,11 @@ void GSessionManager::GSessionManagerPrivate::ClearCurrent(void) {
     }
 
     // clear data
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
+    regionCache.Clear();
+    viewerData = GGenomicDataSet();
     filename = "";
     fileManager->CloseAll();
 
@@ -127,6 +198,9 @@ void GSessionManager::GSessionManagerPrivate::Create(void) {
     if ( isSessionActive ) { qDebug() << "session is activated... why?"; ClearCurrent(); }
 
     // get new session data from user
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
     fileManager->OpenFiles();
     filename = GetSaveFilenameFromUser();
 
@@ -192,6 +266,9 @@ void GSessionManager::GSessionManagerPrivate::Load(void) {
     }
 
     // load session data into sub-managers
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
     fileManager->Load(loadStream, version);
 
     // clean up and set flag
@@ -251,20 +328,176 @@ void GSessionManager::GSessionManagerPrivate::Save(bool force) {
 }
 
 void GSessionManager::GSessionManagerPrivate::OpenFiles(const GFileInfoList& files) {
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
+    regionCache.Clear();
     fileManager->OpenFiles(files);
 }
 
 void GSessionManager::GSessionManagerPrivate::CloseFiles(const GFileInfoList& files) {
+    CancelPrefetch();
+    CancelSearch();
+    CancelExtension();
+    regionCache.Clear();
     fileManager->CloseFiles(files);
 }
 
+// cached data depends on open files & processing applied
+const QString GSessionManager::GSessionManagerPrivate::CacheContext(void) {
+    QString context = dataManager->ProcessingKey();
+    if ( isGenotypesVisible ) { context += "|genotypes"; }
+    foreach ( const GFileInfo& file, fileManager->GetOpenFiles() ) {
+        context += QString("|%1:%2").arg(file.ID).arg(file.Filename);
+    }
+    return context;
+}
+
 GGenomicDataSet GSessionManager::GSessionManagerPrivate::LoadData(const GGenomicDataRegion& region)
 {
-    GGenomicDataSet data = fileManager->LoadData(region);
-    dataManager->ProcessData(data);
+    // viewer requests come before any background work
+    CancelPrefetch();
+    CancelExtension();
+
+    // note panning direction (used to order prefetching)
+    if ( (region.RefId >= 0) && (region.RefId == lastRegion.RefId) ) {
+        const qint64 shift = ( (qint64)region.LeftBound + region.RightBound ) - ( (qint64)lastRegion.LeftBound + lastRegion.RightBound );
+        panDirection = ( (shift > 0) ? 1 : ((shift < 0) ? -1 : panDirection) );
+    } else { panDirection = 0; }
+    lastRegion = region;
+
+    // use cached data if available (trimmed down if cached region is larger)
+    regionCache.SetContext( CacheContext() );
+    GGenomicDataSet cached;
+    if ( regionCache.Find(region, cached) ) {
+        dataManager->TrimData(cached, region.LeftBound, region.RightBound);
+        viewerData = cached;
+        return viewerData;
+    }
+
+    // if region overlaps current data, load & process only the parts not already available
+    QList<GGenomicDataRegion> missing;
+    bool isMerged = dataManager->ReuseOverlap(viewerData, region, missing);
+    if ( isMerged ) {
+        foreach ( const GGenomicDataRegion& missingRegion, missing ) {
+            GGenomicDataSet delta = fileManager->LoadData(missingRegion);
+            if ( delta.Sequence.isEmpty() ) { continue; } // beyond reference end
+            if ( !dataManager->ExtendData(viewerData, delta) ) {
+                isMerged = false;
+                break;
+            }
+        }
+    }
+
+    // otherwise load whole region
+    if ( !isMerged ) {
+        viewerData = fileManager->LoadData(region);
+        dataManager->ProcessData(viewerData);
+    }
+
+    // store result for later requests
+    if ( region.RefId >= 0 ) { regionCache.Insert(region, viewerData); }
+    return viewerData;
+}
+
+GGenomicDataSet GSessionManager::GSessionManagerPrivate::ExtendData(GGenomicDataSet data, GGenomicDataRegion delta, GGenomicDataRegion keep)
+{
+    // load only new region, merge into current data
+    GGenomicDataSet deltaData = fileManager->LoadData(delta);
+    if ( dataManager->ExtendData(data, deltaData) ) {
+        dataManager->TrimData(data, keep.LeftBound, keep.RightBound);
+    }
+    return data;
+}
+
+GGenomicDataSet GSessionManager::GSessionManagerPrivate::PrefetchData(GGenomicDataRegion region)
+{
+    // run below normal priority, on an otherwise idle core
+    QThread* thread = QThread::currentThread();
+    const QThread::Priority priority = thread->priority();
+    thread->setPriority(QThread::LowestPriority);
+
+    // load & process region in pieces, so cancelling only waits for current piece
+    GGenomicDataSet data;
+    const qint32 pieceLength = qMax(1, (region.RightBound - region.LeftBound + 1) / PREFETCH_PIECES);
+    for ( qint32 left = region.LeftBound; left <= region.RightBound; left += pieceLength ) {
+        if ( (int)prefetchCancelled != 0 ) { break; }
+
+        // load piece, stop if beyond reference end
+        const GGenomicDataRegion piece(region.RefName, left, qMin(region.RightBound, left + pieceLength - 1), region.RefId);
+        GGenomicDataSet pieceData = fileManager->LoadData(piece);
+        if ( pieceData.Sequence.isEmpty() ) { break; }
+
+        // process first piece, merge the rest into it
+        if ( data.Sequence.isEmpty() ) {
+            data = pieceData;
+            dataManager->ProcessDataSilently(data);
+        } else if ( !dataManager->ExtendData(data, pieceData) ) { break; }
+    }
+
+    thread->setPriority(priority);
     return data;
 }
 
+void GSessionManager::GSessionManagerPrivate::QueuePrefetch(const GGenomicDataRegion& region) {
+
+    prefetchQueue.clear();
+    if ( region.RefId < 0 ) { return; }
+
+    // neighbors of same size on either side
+    const qint32 length = region.RightBound - region.LeftBound + 1;
+    const GGenomicDataRegion right(region.RefName, region.RightBound + 1, region.RightBound + length, region.RefId);
+    const GGenomicDataRegion left(region.RefName, qMax(1, region.LeftBound - length), region.LeftBound - 1, region.RefId);
+
+    // next in panning direction first (right if unknown)
+    QList<GGenomicDataRegion> neighbors;
+    if ( panDirection < 0 ) { neighbors << left << right; }
+    else { neighbors << right << left; }
+
+    // skip neighbors off reference start, or already cached
+    GGenomicDataSet cached;
+    foreach ( const GGenomicDataRegion& neighbor, neighbors ) {
+        if ( neighbor.RightBound < neighbor.LeftBound ) { continue; }
+        if ( regionCache.Find(neighbor, cached) ) { continue; }
+        prefetchQueue.append(neighbor);
+    }
+}
+
+void GSessionManager::GSessionManagerPrivate::CancelPrefetch(void) {
+
+    prefetchQueue.clear();
+    if ( !isPrefetching ) { return; }
+    isPrefetching = false;
+
+    // stop after current piece, keep what was loaded
+    prefetchCancelled = 1;
+    prefetchWatcher.waitForFinished();
+    const GGenomicDataSet data = prefetchWatcher.result();
+    if ( !data.Sequence.isEmpty() ) { regionCache.Insert(data.Region, data); }
+    prefetchWatcher.setFuture( QFuture<GGenomicDataSet>() );
+}
+
+void GSessionManager::GSessionManagerPrivate::StartSearch(const QString& prefix) {
+    searchPrefix = prefix;
+    isSearching  = true;
+    searchWatcher.setFuture( QtConcurrent::run(fileManager, &GFileManager::FindNames, prefix, MAX_NAME_MATCHES) );
+}
+
+void GSessionManager::GSessionManagerPrivate::CancelSearch(void) {
+    isSearchQueued = false;
+    if ( !isSearching ) { return; }
+    isSearching = false;
+    searchWatcher.waitForFinished();
+    searchWatcher.setFuture( QFuture<GFeatureNameList>() );
+}
+
+void GSessionManager::GSessionManagerPrivate::CancelExtension(void) {
+    if ( !isExtending ) { return; }
+    isExtending = false;
+    extendWatcher.waitForFinished();
+    extendWatcher.setFuture( QFuture<GGenomicDataSet>() );
+}
+
 bool GSessionManager::GSessionManagerPrivate::ConfirmSaveFromUser(void) {
 
     // set up message box
@@ -313,6 +546,11 @@ GSessionManager::GSessionManager(QObject* parent)
     connect(d->fileManager, SIGNAL(FilesClosed(GFileInfoList)),       this, SIGNAL(FilesClosed(GFileInfoList)));
     connect(d->fileManager, SIGNAL(FilesOpened(GFileInfoList)),       this, SIGNAL(FilesOpened(GFileInfoList)));
     connect(d->fileManager, SIGNAL(ReferencesLoaded(GReferenceList)), this, SIGNAL(ReferencesLoaded(GReferenceList)));
+
+    // handle finished background loads
+    connect(&d->extendWatcher,   SIGNAL(finished()), this, SLOT(FinishExtendData()));
+    connect(&d->prefetchWatcher, SIGNAL(finished()), this, SLOT(FinishPrefetch()));
+    connect(&d->searchWatcher,   SIGNAL(finished()), this, SLOT(FinishSearch()));
 }
 
 GSessionManager::~GSessionManager(void) {
@@ -344,4 +582,105 @@ void GSessionManager::LoadDataForViewer(const GGenomicDataRegion& region)
 {
     GGenomicDataSet data = d->LoadData(region);
     emit ViewerDataLoaded(data);
+
+    // start loading neighbors in background
+    d->QueuePrefetch(data.Region);
+    RunPrefetch();
+}
+
+void GSessionManager::ExtendDataForViewer(const GGenomicDataRegion& delta, const GGenomicDataRegion& keep)
+{
+    // one extension at a time (viewer waits for each result)
+    if ( d->isExtending ) {
+        qDebug() << "GSessionManager::ExtendDataForViewer() => extension already running";
+        return;
+    }
+
+    // load & merge on worker thread, from copy of current data
+    d->CancelPrefetch();
+    d->isExtending = true;
+    d->extendWatcher.setFuture( QtConcurrent::run(d, &GSessionManagerPrivate::ExtendData, d->viewerData, delta, keep) );
+}
+
+void GSessionManager::FinishExtendData(void)
+{
+    // skip results of cancelled extension
+    if ( !d->isExtending ) { return; }
+    d->isExtending = false;
+
+    // store & show merged data (unchanged if region could not be extended)
+    d->viewerData = d->extendWatcher.result();
+    d->regionCache.Insert(d->viewerData.Region, d->viewerData);
+    emit ViewerDataExtended(d->viewerData);
+}
+
+void GSessionManager::RunPrefetch(void)
+{
+    // one region at a time, never alongside viewer's own background load
+    if ( d->isPrefetching || d->isExtending || d->prefetchQueue.isEmpty() ) { return; }
+
+    // only use idle cores (try again later if none)
+    QThreadPool* pool = QThreadPool::globalInstance();
+    if ( pool->activeThreadCount() >= pool->maxThreadCount() ) {
+        QTimer::singleShot(GSessionManagerPrivate::PREFETCH_RETRY_MS, this, SLOT(RunPrefetch()));
+        return;
+    }
+
+    // start next region
+    d->prefetchCancelled = 0;
+    d->isPrefetching = true;
+    d->prefetchWatcher.setFuture( QtConcurrent::run(d, &GSessionManagerPrivate::PrefetchData, d->prefetchQueue.takeFirst()) );
+}
+
+void GSessionManager::FinishPrefetch(void)
+{
+    // skip results of cancelled prefetch (already stored)
+    if ( !d->isPrefetching ) { return; }
+    d->isPrefetching = false;
+
+    // store result, continue with next region
+    const GGenomicDataSet data = d->prefetchWatcher.result();
+    if ( !data.Sequence.isEmpty() ) { d->regionCache.Insert(data.Region, data); }
+    RunPrefetch();
+}
+
+void GSessionManager::SearchNames(const QString& prefix)
+{
+    // search runs alongside any background loading (name lookups never touch region data)
+    // note - while a search runs, only the latest prefix typed is queued
+    if ( d->isSearching ) {
+        d->queuedPrefix   = prefix;
+        d->isSearchQueued = true;
+        return;
+    }
+    d->StartSearch(prefix);
+}
+
+void GSessionManager::SetGenotypesVisible(bool ok)
+{
+    if ( ok == d->isGenotypesVisible ) { return; }
+
+    // file manager must not be in use
+    d->CancelPrefetch();
+    d->CancelExtension();
+
+    // current data was loaded with other setting, so is not reused
+    // (cached data is kept apart by cache context)
+    d->isGenotypesVisible = ok;
+    d->fileManager->SetGenotypesEnabled(ok);
+    d->viewerData = GGenomicDataSet();
+}
+
+void GSessionManager::FinishSearch(void)
+{
+    // skip results of cancelled search
+    if ( !d->isSearching ) { return; }
+    d->isSearching = false;
+
+    // report matches, continue with any queued search
+    emit NamesFound(d->searchPrefix, d->searchWatcher.result());
+    if ( d->isSearchQueued ) {
+        d->isSearchQueued = false;
+        d->StartSearch(d->queuedPrefix);
+    }
 }
@@ -31,6 +31,7 @@
 #define G_SESSIONMANAGER_H
 
 #include <QObject>
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GFileInfo.h"
 #include "DataStructures/GGenomicDataSet.h"
 #include "DataStructures/GReference.h"
@@ -50,10 +51,12 @@ class GSessionManager : public QObject {
     signals:
         void FilesClosed(GFileInfoList files);
         void FilesOpened(GFileInfoList files);
+        void NamesFound(QString prefix, GFeatureNameList names);
         void ReferencesLoaded(GReferenceList references);
         void SessionActivated(void);
         void SessionDeactivated(void);
         void ViewerDataLoaded(GGenomicDataSet data);
+        void ViewerDataExtended(GGenomicDataSet data);
 
     public slots:
 
@@ -64,11 +67,22 @@ class GSessionManager : public QObject {
 
         // Data access
         void LoadDataForViewer(const GGenomicDataRegion& region);
+        // loads (in background) & merges region adjacent to viewer's current data, then drops data outside keep
+        void ExtendDataForViewer(const GGenomicDataRegion& delta, const GGenomicDataRegion& keep);
+        void SearchNames(const QString& prefix);
+        // sets whether per-sample genotypes are loaded (only while viewer shows them)
+        void SetGenotypesVisible(bool ok);
 
         // FileManager public interface
         void OpenFiles(const GFileInfoList& files = GFileInfoList());
         void CloseFiles(const GFileInfoList& files = GFileInfoList());
 
+    private slots:
+        void FinishExtendData(void);
+        void FinishPrefetch(void);
+        void FinishSearch(void);
+        void RunPrefetch(void);
+
     private:
         struct GSessionManagerPrivate;
         GSessionManagerPrivate* d;
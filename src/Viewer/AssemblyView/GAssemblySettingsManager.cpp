@@ -38,10 +38,14 @@ struct GAssemblySettingsManager::GAssemblySettingsManagerPrivate {
     QAction* mergeAction;
     QAction* editAction;
     QAction* showBasesAction;
+    QAction* packedAction;
+    QAction* showGenotypesAction;
 
     bool isGroupsMerged;
     GViewSettingsMap viewModes;
     bool isBasesVisible;
+    bool isPackedRendering;
+    bool isGenotypesVisible;
 
     void Init(void);
     void SetGroupColorScheme(GVisibleAlignmentGroup* visibleGroup);
@@ -97,6 +101,12 @@ void GAssemblySettingsManager::GAssemblySettingsManagerPrivate::Init(void) {
     // initialize show bases flag
     isBasesVisible = false;
 
+    // initialize packed rendering flag (one item per group, instead of per alignment)
+    isPackedRendering = true;
+
+    // initialize show genotypes flag (genotypes are only loaded while shown)
+    isGenotypesVisible = false;
+
     // set up 'merge groups' action
     mergeAction = new QAction("Merge Groups", (QObject*)0);
     mergeAction->setCheckable(true);
@@ -108,6 +118,15 @@ void GAssemblySettingsManager::GAssemblySettingsManagerPrivate::Init(void) {
     // set up 'show bases' action
     showBasesAction = new QAction("Show Bases", (QObject*)0);
     showBasesAction->setCheckable(true);
+
+    // set up 'packed rendering' action
+    packedAction = new QAction("Packed Rendering", (QObject*)0);
+    packedAction->setCheckable(true);
+    packedAction->setChecked(isPackedRendering);
+
+    // set up 'show genotypes' action
+    showGenotypesAction = new QAction("Show Genotypes", (QObject*)0);
+    showGenotypesAction->setCheckable(true);
 }
 
 void GAssemblySettingsManager::GAssemblySettingsManagerPrivate::SetGroupColorScheme(GVisibleAlignmentGroup* group) {
@@ -124,6 +143,16 @@ void GAssemblySettingsManager::GAssemblySettingsManagerPrivate::SetGroupColorSch
     // set group header color scheme to current 'normal'
     group->SetColorScheme(normalSettings.currentColorScheme);
 
+    // packed groups choose each alignment's color scheme while painting
+    if ( group->IsPacked() ) {
+        group->SetPackedColorSchemes(normalSettings.currentColorScheme,
+                                     dimSettings.currentColorScheme,
+                                     highlightSettings.currentColorScheme,
+                                     dimSettings.alignmentFlag,
+                                     highlightSettings.alignmentFlag);
+        return;
+    }
+
     QList<GVisibleAlignmentItem*> items = group->AlignmentItems();
     foreach(GVisibleAlignmentItem* item, items) {
         if ( item == 0 ) { continue; }
@@ -159,6 +188,8 @@ GAssemblySettingsManager::GAssemblySettingsManager(QObject* parent)
     connect(d->mergeAction, SIGNAL(toggled(bool)), this, SLOT(SetMergeGroups(bool)));
     connect(d->editAction,  SIGNAL(triggered()),   this, SLOT(EditSettings()));
     connect(d->showBasesAction, SIGNAL(toggled(bool)), this, SLOT(SetShowBases(bool)));
+    connect(d->packedAction, SIGNAL(toggled(bool)), this, SLOT(SetPackedRendering(bool)));
+    connect(d->showGenotypesAction, SIGNAL(toggled(bool)), this, SLOT(SetShowGenotypes(bool)));
 }
 
 GAssemblySettingsManager::~GAssemblySettingsManager(void) {
@@ -170,7 +201,9 @@ QList<QAction*> GAssemblySettingsManager::Actions(void) {
     QList<QAction*> actions;
     actions << d->mergeAction
             << d->editAction
-            << d->showBasesAction;
+            << d->showBasesAction
+            << d->packedAction
+            << d->showGenotypesAction;
     return actions;
 }
 
@@ -182,6 +215,14 @@ bool GAssemblySettingsManager::IsBasesVisible(void) const {
     return d->isBasesVisible;
 }
 
+bool GAssemblySettingsManager::IsPackedRendering(void) const {
+    return d->isPackedRendering;
+}
+
+bool GAssemblySettingsManager::IsGenotypesVisible(void) const {
+    return d->isGenotypesVisible;
+}
+
 void GAssemblySettingsManager::SetAlignmentFlag(const GVisibleAlignmentItem::AlignmentItemViewMode& mode, const Gambit::GAlignment::GAlignmentOption& option, bool ok) {
     GAlignment::GAlignmentOptions& flag = d->viewModes[mode].alignmentFlag;
     if (ok) flag |= option;  // set flag
@@ -232,3 +273,26 @@ void GAssemblySettingsManager::SetShowBases(bool ok) {
     // emit change signal
     emit ShowBasesChanged(ok);
 }
+
+void GAssemblySettingsManager::SetPackedRendering(bool ok) {
+
+    // set flag
+    d->isPackedRendering = ok;
+
+    // emit change signal
+    emit PackedRenderingChanged(ok);
+}
+
+void GAssemblySettingsManager::SetShowGenotypes(bool ok) {
+
+    // set flag
+    d->isGenotypesVisible = ok;
+
+    // toggle action label
+    QString label = "Show Genotypes";
+    if (ok) { label = "Hide Genotypes"; }
+    d->showGenotypesAction->setText(label);
+
+    // emit change signal
+    emit ShowGenotypesChanged(ok);
+}
@@ -58,6 +58,8 @@ class GAssemblySettingsManager : public QObject {
     public:
         bool IsGroupsMerged(void) const;
         bool IsBasesVisible(void) const;
+        bool IsPackedRendering(void) const;
+        bool IsGenotypesVisible(void) const;
 
     public:
         void SetAlignmentFlag(const GVisibleAlignmentItem::AlignmentItemViewMode& mode,
@@ -73,11 +75,15 @@ class GAssemblySettingsManager : public QObject {
         void MergeGroupsChanged(bool ok);
         void ViewSettingsChanged(void);
         void ShowBasesChanged(bool ok);
+        void PackedRenderingChanged(bool ok);
+        void ShowGenotypesChanged(bool ok);
 
     private slots:
         void SetMergeGroups(bool ok);
         void EditSettings(void);
         void SetShowBases(bool ok);
+        void SetPackedRendering(bool ok);
+        void SetShowGenotypes(bool ok);
 
     // internals
     private:
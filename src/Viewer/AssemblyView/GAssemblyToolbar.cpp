@@ -67,8 +67,16 @@ struct GAssemblyToolbar::GAssemblyToolbarPrivate {
     QComboBox* rangeComboBox;
     QAction*   jumpAction;
 
+    QLabel*           locusLabel;
+    QLineEdit*        locusLineEdit;
+    QCompleter*       locusCompleter;
+    QStringListModel* locusModel;
+    GFeatureNameList  locusMatches;
+
     void Init(GAssemblyToolbar* parent);
     void GetBoundaryCoordinates(qint32& leftBound, qint32& rightBound);
+    bool FindLocusMatch(const QString& text, GFeatureName& feature);
+    static QString LocusText(const GFeatureName& feature);
 };
 
 void GAssemblyToolbar::GAssemblyToolbarPrivate::Init(GAssemblyToolbar* parent) {
@@ -105,6 +113,18 @@ void GAssemblyToolbar::GAssemblyToolbarPrivate::Init(GAssemblyToolbar* parent) {
 
     // set up 'jump' action
     jumpAction = new QAction("Jump", parentToolbar);
+
+    // set up feature name (locus) input field, completions are filled in as matches arrive
+    locusLabel     = new QLabel("Find: ");
+    locusLineEdit  = new QLineEdit;
+    locusLineEdit->setMaximumWidth(200);
+    locusLineEdit->setPalette(p);
+    locusLineEdit->setAutoFillBackground(true);
+    locusModel     = new QStringListModel(parentToolbar);
+    locusCompleter = new QCompleter(locusModel, parentToolbar);
+    locusCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    locusCompleter->setCompletionMode(QCompleter::PopupCompletion);
+    locusLineEdit->setCompleter(locusCompleter);
 }
 
 void GAssemblyToolbar::GAssemblyToolbarPrivate::GetBoundaryCoordinates(qint32& leftBound, qint32& rightBound ) {
@@ -132,6 +152,32 @@ void GAssemblyToolbar::GAssemblyToolbarPrivate::GetBoundaryCoordinates(qint32& l
     }
 }
 
+bool GAssemblyToolbar::GAssemblyToolbarPrivate::FindLocusMatch(const QString& text, GFeatureName& feature) {
+
+    // skip if no matches
+    if ( locusMatches.isEmpty() ) { return false; }
+
+    // look for selected completion, then for exact name
+    const QString name = text.trimmed();
+    foreach ( const GFeatureName& match, locusMatches ) {
+        if ( (LocusText(match) == name) || (QString::compare(match.Name, name, Qt::CaseInsensitive) == 0) ) {
+            feature = match;
+            return true;
+        }
+    }
+
+    // otherwise use best (first) prefix match
+    if ( locusMatches.first().Name.startsWith(name, Qt::CaseInsensitive) ) {
+        feature = locusMatches.first();
+        return true;
+    }
+    return false;
+}
+
+QString GAssemblyToolbar::GAssemblyToolbarPrivate::LocusText(const GFeatureName& feature) {
+    return QString("%1  (%2:%3-%4)").arg(feature.Name).arg(feature.RefName).arg(feature.Start).arg(feature.Stop);
+}
+
 
 GAssemblyToolbar::GAssemblyToolbar(const QList<QAction*>& actions, QWidget* parent)
     : QToolBar(parent)
@@ -146,6 +192,9 @@ GAssemblyToolbar::GAssemblyToolbar(const QList<QAction*>& actions, QWidget* pare
     // make connections
     connect(d->positionLineEdit, SIGNAL(returnPressed()),      this, SLOT(JumpTriggered()));
     connect(d->jumpAction,       SIGNAL(triggered()),          this, SLOT(JumpTriggered()));
+    connect(d->locusLineEdit,    SIGNAL(textEdited(QString)),  this, SLOT(LocusEdited(QString)));
+    connect(d->locusLineEdit,    SIGNAL(returnPressed()),      this, SLOT(LocusTriggered()));
+    connect(d->locusCompleter,   SIGNAL(activated(QString)),   this, SLOT(LocusActivated(QString)));
 
     // add components to toolbar
     addWidget(d->referenceLabel);
@@ -156,6 +205,9 @@ GAssemblyToolbar::GAssemblyToolbar(const QList<QAction*>& actions, QWidget* pare
     addWidget(d->rangeComboBox);
     addAction(d->jumpAction);
     addWidget( new GToolbarSeparator );
+    addWidget(d->locusLabel);
+    addWidget(d->locusLineEdit);
+    addWidget( new GToolbarSeparator );
 
     // add actions to toolbar
     foreach (QAction* action, actions) { addAction(action); }
@@ -189,6 +241,59 @@ void GAssemblyToolbar::JumpTriggered(void) {
     emit JumpRequested(region);
 }
 
+void GAssemblyToolbar::LocusActivated(const QString& text) {
+
+    // look up selected feature
+    GFeatureName feature;
+    if ( !d->FindLocusMatch(text, feature) ) { return; }
+
+    // center on feature, widening range if feature does not fit
+    qint32 range = d->rangeComboBox->currentText().toInt();
+    range = qMax(range, (feature.Stop - feature.Start) + 20);
+    const qint32 position   = feature.Start + (feature.Stop - feature.Start)/2;
+    const qint32 leftBound  = qMax(GAssemblyToolbar::DEFAULT_POSITION, position - (range/2));
+    const qint32 rightBound = leftBound + range;
+
+    // update toolbar to reflect feature location
+    SetSelectedReference(feature.RefName);
+    SetPosition(position);
+
+    // emit center-on & data jump requests
+    emit ViewCenterOnRequested(position);
+    GGenomicDataRegion region(feature.RefName, leftBound, rightBound);
+    emit JumpRequested(region);
+}
+
+void GAssemblyToolbar::LocusEdited(const QString& text) {
+
+    // request matches for new prefix (matches arrive in SetNameMatches)
+    const QString prefix = text.trimmed();
+    if ( prefix.isEmpty() ) {
+        d->locusMatches.clear();
+        d->locusModel->setStringList(QStringList());
+        return;
+    }
+    emit NameSearchRequested(prefix);
+}
+
+void GAssemblyToolbar::LocusTriggered(void) {
+    LocusActivated( d->locusLineEdit->text() );
+}
+
+void GAssemblyToolbar::SetNameMatches(const QString& prefix, const GFeatureNameList& names) {
+
+    // ignore stale results (user kept typing)
+    if ( prefix != d->locusLineEdit->text().trimmed() ) { return; }
+
+    // update completions
+    d->locusMatches = names;
+    QStringList completions;
+    foreach ( const GFeatureName& feature, names ) { completions.append( GAssemblyToolbarPrivate::LocusText(feature) ); }
+    d->locusModel->setStringList(completions);
+    d->locusCompleter->setCompletionPrefix(prefix);
+    if ( !completions.isEmpty() && d->locusLineEdit->hasFocus() ) { d->locusCompleter->complete(); }
+}
+
 void GAssemblyToolbar::SetPosition(qint32 position) {
     d->positionLineEdit->setText( QString::number(position) );
 }
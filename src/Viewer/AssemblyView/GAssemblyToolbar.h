@@ -30,6 +30,7 @@
 #include <QList>
 #include <QToolBar>
 #include "DataStructures/GAlignment.h"
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GGenomicDataRegion.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
 
@@ -49,9 +50,11 @@ class GAssemblyToolbar : public QToolBar {
         void SetRange(qint32 value);
         void SetReferenceNames(QStringList names);
         void SetSelectedReference(const QString& name);
+        void SetNameMatches(const QString& prefix, const GFeatureNameList& names);
 
     signals:
         void JumpRequested(const GGenomicDataRegion& region);
+        void NameSearchRequested(const QString& prefix);
         void ViewCenterOnRequested(qint32 position);
         void AlignmentOptionChangeRequested(const GVisibleAlignmentItem::AlignmentItemViewMode mode,
                                             const GAlignment::GAlignmentOption option,
@@ -59,6 +62,9 @@ class GAssemblyToolbar : public QToolBar {
 
     private slots:
         void JumpTriggered(void);
+        void LocusActivated(const QString& text);
+        void LocusEdited(const QString& text);
+        void LocusTriggered(void);
 
     private:
         struct GAssemblyToolbarPrivate;
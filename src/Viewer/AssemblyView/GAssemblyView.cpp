@@ -32,9 +32,13 @@
 #include "Utilities/flickcharm.h"
 #include "Viewer/GSnpInfoDialog.h"
 #include "Viewer/AssemblyView/GAssemblySettingsManager.h"
+#include "Viewer/AssemblyView/GFrameScheduler.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentGroup.h"
 #include "Viewer/AssemblyView/GVisibleCursorItem.h"
 #include "Viewer/AssemblyView/GVisibleGeneItem.h"
+#include "Viewer/AssemblyView/GVisibleGenotypeItem.h"
+#include "Viewer/AssemblyView/GVisibleRulerItem.h"
+#include "Viewer/AssemblyView/GVisibleSequenceItem.h"
 #include "Viewer/AssemblyView/GVisibleSnpItem.h"
 using namespace Gambit;
 using namespace Gambit::Viewer;
@@ -54,6 +58,11 @@ struct GAssemblyView::GAssemblyViewPrivate {
     // handles 'kinetic scrolling' effect
     FlickCharm flicker;
 
+    // paces all viewport repaints (scene changes, scrolling, cursor) to display frames
+    GFrameScheduler* frameScheduler;
+    bool isHorizontalScrollPending;
+    bool isVerticalScrollPending;
+
     // font/text data for all sequence(reference & alignments)
     // also used to size annotations correctly
     QFont font;
@@ -62,8 +71,20 @@ struct GAssemblyView::GAssemblyViewPrivate {
     int   fontSpacing;
 
     // range data
-    qint32 leftBound;
-    qint32 rightBound;
+    QString refName;
+    qint32  refId;
+    qint32  leftBound;
+    qint32  rightBound;
+
+    // incremental loading near data edges
+    GVisibleRulerItem* ruler;           // maps positions <-> columns for current data
+    bool   isExtensionPending;
+    bool   isExtendingLeft;
+    qint32 requestedBound;              // outer bound of pending request
+    bool   isAtLeftEnd;
+    bool   isAtRightEnd;
+    static const qint32 MIN_EXTENSION;  // bases per request
+    static const int    KEEP_VIEWPORTS; // kept on each side of view
 
     // display data
     qint32 centerOnPosition;
@@ -88,7 +109,10 @@ struct GAssemblyView::GAssemblyViewPrivate {
     void ClearCurrentData(void);
     void ShowBases(bool ok);
     void ShowData(const GGenomicDataSet& data);
+    void UpdateData(const GGenomicDataSet& data);
+    void RequestDataExtension(void);
     void MergeReadGroups(bool ok);
+    void RedrawAlignments(void);
     GAlleleList AllelesOverlappingPosition(qint32 position);
     void AdjustGroupLayout(void);
 
@@ -98,17 +122,24 @@ struct GAssemblyView::GAssemblyViewPrivate {
 
         // alignment group drawing
         void ShowAlignments(const GAlignmentList& alignments);
+        GVisibleAlignmentGroup* CreateGroup(const QString& label);
         void CreateNewAlignmentGroups(const GAlignmentList& alignments);
         void DrawAlignmentGroups(void);
 
         // coordinate & annotation track drawing
+        void ClearTracks(void);
+        void ShowTracks(const GGenomicDataSet& data);
         void ShowCoordinates(const GPaddingMap& padding);
         void ShowReferenceSequence(const QString& sequence);
         void ShowGenes(const GGeneList& genes);
         void ShowSnps(const GSnpList& snps);
+        void ShowGenotypes(const GGenotypeMatrix& genotypes, const GPaddingMap& padding);
         void UpdateTrackBackground(void);
 };
 
+const qint32 GAssemblyView::GAssemblyViewPrivate::MIN_EXTENSION  = 1000;
+const int    GAssemblyView::GAssemblyViewPrivate::KEEP_VIEWPORTS = 4;
+
 void GAssemblyView::GAssemblyViewPrivate::Init(void) {
 
     // initialize scene
@@ -123,9 +154,18 @@ void GAssemblyView::GAssemblyViewPrivate::Init(void) {
     CreateFont(); // sets font height/width
 
     // default data ranges
+    refId      = -1;
     leftBound  = 1;
     rightBound = 1;
 
+    // no data to extend yet
+    ruler              = 0;
+    isExtensionPending = false;
+    isExtendingLeft    = false;
+    requestedBound     = 0;
+    isAtLeftEnd        = false;
+    isAtRightEnd       = false;
+
     // default display data values
     centerOnPosition        = 0;
     isCenterOnSet           = false;
@@ -149,6 +189,14 @@ GAssemblyView::GAssemblyView(QWidget* parent)
     d->Init();
     setScene(d->scene);
 
+    // route all repaints through frame scheduler (see setViewportUpdateMode below)
+    d->frameScheduler = new GFrameScheduler(viewport(), this);
+    d->isHorizontalScrollPending = false;
+    d->isVerticalScrollPending   = false;
+    connect(d->scene, SIGNAL(changed(QList<QRectF>)), this, SLOT(CatchSceneChanged(QList<QRectF>)));
+    connect(d->frameScheduler, SIGNAL(FrameStarted()), this, SLOT(ApplyScrollChanges()));
+    connect(d->frameScheduler, SIGNAL(FramesDropped(int)), this, SLOT(ReportDroppedFrames(int)));
+
     // active FlickCharm for 'kinetic-scrolling'
     d->flicker.activateOn(this);
     connect(&d->flicker, SIGNAL(MouseMoved(QPoint)), this, SLOT(CatchMouseMove(QPoint)));  // *** implement this *** //
@@ -161,6 +209,8 @@ GAssemblyView::GAssemblyView(QWidget* parent)
     connect(d->settingsManager, SIGNAL(MergeGroupsChanged(bool)), this, SLOT(MergeReadGroups(bool)));
     connect(d->settingsManager, SIGNAL(ViewSettingsChanged()),    this, SLOT(ViewSettingsChanged()));
     connect(d->settingsManager, SIGNAL(ShowBasesChanged(bool)),   this, SLOT(ShowBases(bool)));
+    connect(d->settingsManager, SIGNAL(PackedRenderingChanged(bool)), this, SLOT(SetPackedRendering(bool)));
+    connect(d->settingsManager, SIGNAL(ShowGenotypesChanged(bool)),   this, SLOT(ShowGenotypes(bool)));
 
     // set up view background
     QPalette p = palette();
@@ -170,7 +220,7 @@ GAssemblyView::GAssemblyView(QWidget* parent)
     // set up attributes
     setAlignment(Qt::AlignTop | Qt::AlignLeft);
     setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
-    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
 }
 
 GAssemblyView::~GAssemblyView(void) {
@@ -182,8 +232,9 @@ QList<QAction*> GAssemblyView::SettingsActions(void) {
     return d->settingsManager->Actions();
 }
 
-void GAssemblyView::ClearCurrentData(void)                { d->ClearCurrentData(); }
-void GAssemblyView::ShowData(const GGenomicDataSet& data) { d->ShowData(data);     }
+void GAssemblyView::ClearCurrentData(void)                  { d->ClearCurrentData(); }
+void GAssemblyView::ShowData(const GGenomicDataSet& data)   { d->ShowData(data);     }
+void GAssemblyView::UpdateData(const GGenomicDataSet& data) { d->UpdateData(data);   }
 
 void GAssemblyView::SetCenterOn(qint32 position) {
     d->centerOnPosition = position;
@@ -209,23 +260,66 @@ void GAssemblyView::ZoomReset(void) {
 
 void GAssemblyView::AdjustGroupLayout(void) { d->AdjustGroupLayout(); }
 
+// scroll changes are applied once per frame (see ApplyScrollChanges)
 void GAssemblyView::CatchHorizontalScrollbarChange(int value) {
-    emit HorizontalScrollChanged( value, matrix().m11() );
+    Q_UNUSED(value);
+    d->isHorizontalScrollPending = true;
+    d->frameScheduler->InvalidateAll();
 }
 
 void GAssemblyView::CatchVerticalScrollbarChange(int value) {
+    Q_UNUSED(value);
+    d->isVerticalScrollPending = true;
+    d->frameScheduler->InvalidateAll();
+}
+
+void GAssemblyView::ApplyScrollChanges(void) {
 
-    if ( d->trackGroup ) {
-        QPointF trackPos = d->trackGroup->pos();
-        qreal yValue = value/matrix().m22();
-        d->trackGroup->setPos(trackPos.x(), yValue);
-        d->trackGroup->update();
+    // re-position group headers, fetch more data if near an edge
+    if ( d->isHorizontalScrollPending ) {
+        d->isHorizontalScrollPending = false;
+        emit HorizontalScrollChanged( horizontalScrollBar()->value(), matrix().m11() );
+        d->RequestDataExtension();
+    }
+
+    // keep track data at top of view
+    if ( d->isVerticalScrollPending ) {
+        d->isVerticalScrollPending = false;
+        if ( d->trackGroup ) {
+            QPointF trackPos = d->trackGroup->pos();
+            qreal yValue = verticalScrollBar()->value()/matrix().m22();
+            d->trackGroup->setPos(trackPos.x(), yValue);
+        }
+    }
+}
+
+// let user know when repaints can't keep up
+void GAssemblyView::ReportDroppedFrames(int count) {
+    emit StatusMessage( tr("Viewer repaint fell behind: %1 frame(s) dropped (%2 this session)")
+                        .arg(count)
+                        .arg(d->frameScheduler->DroppedFrames()) );
+}
+
+// map changed scene areas to viewport for next frame
+void GAssemblyView::CatchSceneChanged(const QList<QRectF>& rects) {
+    foreach ( const QRectF& rect, rects ) {
+        // pad for zero-width items (cursor) & antialiased edges
+        d->frameScheduler->Invalidate( mapFromScene(rect).boundingRect().adjusted(-2, -2, 2, 2) );
     }
 }
 
 void GAssemblyView::MergeReadGroups(bool ok) { d->MergeReadGroups(ok); }
+void GAssemblyView::SetPackedRendering(bool ok) { Q_UNUSED(ok); d->RedrawAlignments(); }
 void GAssemblyView::ShowBases(bool ok)       { d->ShowBases(ok); }
 
+void GAssemblyView::ShowGenotypes(bool ok) {
+
+    // genotypes are only loaded while shown, so current data is loaded again with new setting
+    emit GenotypesVisibilityChanged(ok);
+    if ( d->refName.isEmpty() ) { return; }
+    emit DataReloadRequested( GGenomicDataRegion(d->refName, d->leftBound, d->rightBound, d->refId) );
+}
+
 // do nothing here for now
 void GAssemblyView::CatchAlignmentClick(const GAlignment& alignment) { emit AlignmentClicked(alignment); }
 void GAssemblyView::CatchGeneClick(const GGene& gene)                { emit GeneClicked(gene); }
@@ -258,7 +352,6 @@ void GAssemblyView::MoveCursor(const QPoint& mousePos) {
     QPointF scenePos = mapToScene(mousePos);
     qreal xPos = scenePos.x();
     d->cursorItem->setPos(xPos, 0);
-    update();
 }
 
 // --------------------------------------------------------------------------------- //
@@ -310,18 +403,7 @@ void GAssemblyView::GAssemblyViewPrivate::ClearCurrentData(void) {
     groupMap.clear();
 
     // clear out coordinate/annotation track items
-    if ( trackGroup ) {
-        scene->destroyItemGroup(trackGroup);
-        trackGroup = 0;
-
-        while (!trackItems.isEmpty() ) {
-            QGraphicsItem* item = trackItems.takeFirst();
-            if ( item == NULL ) { continue; }
-            scene->removeItem(item);
-            delete item;
-            item = 0;
-        }
-    }
+    ClearTracks();
 
     // turn off scroll bars
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
@@ -333,19 +415,19 @@ void GAssemblyView::GAssemblyViewPrivate::ShowData(const GGenomicDataSet& data)
     // clear out current data
     ClearCurrentData();
 
-    // reset track boundary
-    nextAvailableTrackStart = 0;
-
     // set boundary positions
+    refName    = data.Region.RefName;
+    refId      = data.Region.RefId;
     leftBound  = data.Region.LeftBound;
     rightBound = data.Region.RightBound;
 
+    // new data may be extended in either direction
+    isExtensionPending = false;
+    isAtLeftEnd  = ( leftBound <= 1 );
+    isAtRightEnd = false;
+
     // draw coordinate & annotation components
-    ShowCoordinates(data.Padding);
-    ShowReferenceSequence(data.Sequence);
-    ShowGenes(data.Genes);
-    ShowSnps(data.Snps);
-    scene->update();
+    ShowTracks(data);
 
     // draw alignment groups
     ShowAlignments(data.Alignments);
@@ -367,69 +449,157 @@ void GAssemblyView::GAssemblyViewPrivate::ShowData(const GGenomicDataSet& data)
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
 }
 
-void GAssemblyView::GAssemblyViewPrivate::ShowCoordinates(const GPaddingMap& padding) {
+void GAssemblyView::GAssemblyViewPrivate::UpdateData(const GGenomicDataSet& data) {
 
-    // positional values
-    qint32 coordinate_X   = 0;
-    qint32 windowPosition = 0;
-    const qint32 interval = 10;
+    // nothing shown yet, or another reference
+    if ( (trackGroup == 0) || (ruler == 0) || (data.Region.RefId != refId) ) {
+        ShowData(data);
+        return;
+    }
 
-    // drawing size values
-    const qint32 label_Ypos      = nextAvailableTrackStart + 10;
-    const qint32 tickMark_height = 10;
-    const qint32 tickMark_Ypos   = label_Ypos + 20;
+    // note whether pending request made any progress (stop asking once reference end is reached)
+    if ( isExtensionPending ) {
+        isExtensionPending = false;
+        if ( isExtendingLeft ) {
+            if ( (data.Region.LeftBound > requestedBound) || (data.Region.LeftBound <= 1) ) { isAtLeftEnd = true; }
+        } else {
+            if ( data.Region.RightBound < requestedBound ) { isAtRightEnd = true; }
+        }
+    }
+
+    // note position at left of view, to keep it in place after update
+    const qint32 viewColumn     = qMax(0, (qint32)( (view->mapToScene(0, 0).x() - viewMargin) / fontWidth ));
+    const qint32 anchorPosition = ruler->PositionAtColumn(viewColumn);
+    const qint32 anchorColumn   = ruler->ColumnOf(anchorPosition);
 
-    // intialize label text stream (used for converting number to characters)
-    QString label;
-    QTextStream str(&label);
+    // rebuild coordinate & annotation tracks for new range
+    ClearTracks();
+    leftBound  = data.Region.LeftBound;
+    rightBound = data.Region.RightBound;
+    ShowTracks(data);
 
-    // iterate over data range
-    for (qint32 i = leftBound; i <= rightBound; ++i) {
+    // split new alignments by group (existing groups with no alignments left are emptied)
+    QMap<QString, GAlignmentList> groupAlignments;
+    if ( settingsManager->IsGroupsMerged() ) { groupAlignments.insert("Merged", data.Alignments); }
+    else {
+        foreach ( const QString& label, groupMap.keys() ) { groupAlignments.insert(label, GAlignmentList()); }
+        foreach ( const GAlignment& alignment, data.Alignments ) { groupAlignments[alignment.ReadGroup].append(alignment); }
+    }
 
-        // if genomic index has padding
-        if (padding.contains(i)) {
-            // increase window position marker by number of pads
-            windowPosition += padding.value(i);
+    // update existing groups (alignments kept keep their rows), draw new ones
+    QMap<QString, GAlignmentList>::const_iterator groupIter = groupAlignments.constBegin();
+    QMap<QString, GAlignmentList>::const_iterator groupEnd  = groupAlignments.constEnd();
+    for ( ; groupIter != groupEnd; ++groupIter ) {
+        GVisibleAlignmentGroup* group = groupMap.value(groupIter.key(), 0);
+        if ( group ) {
+            group->SetLeftBound(leftBound);
+            group->SetAlignments(groupIter.value());
+        } else {
+            group = CreateGroup(groupIter.key());
+            group->AddAlignments(groupIter.value());
+            settingsManager->SetGroupColorScheme(group);
+            group->SetLeftBound(leftBound);
+            group->Draw();
         }
+    }
+    AdjustGroupLayout();
+
+    // update scene attributes & track background
+    scene->setSceneRect( scene->itemsBoundingRect() );
+    UpdateTrackBackground();
 
-        // if position is at tick mark interval
-        if ( (i % interval) == 0 ) {
-
-            // x coordinate is data 'window position' * font width
-            coordinate_X = (windowPosition * fontWidth);
-
-            // label attributes
-            label.clear();
-            str << dec << i;
-
-            QGraphicsTextItem* tickMarkLabel = new QGraphicsTextItem(label);
-            tickMarkLabel->setFont(font);
-            tickMarkLabel->setDefaultTextColor(QColor(Qt::white));
-            tickMarkLabel->setPos( QPointF((coordinate_X + viewMargin/2), label_Ypos) );
-            tickMarkLabel->setZValue(5);
-
-            // add label to scene
-            scene->addItem(tickMarkLabel);
-            trackItems.append(tickMarkLabel);
-
-            // tick mark attributes
-            QPointF tickMark_Top( viewMargin, 0 );
-            QPointF tickMark_Bottom( viewMargin, tickMark_height);
-            QGraphicsLineItem* tickMarkLine = new QGraphicsLineItem( QLineF(tickMark_Top, tickMark_Bottom));
-            tickMarkLine->setPos( QPointF((coordinate_X + (fontWidth/2) ), tickMark_Ypos) );
-            tickMarkLine->setPen(QPen(QColor(Qt::white)));
-            tickMarkLine->setZValue(5);
-
-            // add tick mark to scene
-            scene->addItem(tickMarkLine);
-            trackItems.append(tickMarkLine);
+    // shift view by anchor's change in column (data added/removed on left), keep tracks at top
+    QScrollBar* horizontalBar = view->horizontalScrollBar();
+    horizontalBar->setValue( horizontalBar->value() + qRound((ruler->ColumnOf(anchorPosition) - anchorColumn) * fontWidth * view->matrix().m11()) );
+    trackGroup->setPos(0, view->verticalScrollBar()->value() / view->matrix().m22());
+    scene->update();
+}
+
+// requests adjacent region once view scrolls within a viewport of data edge
+void GAssemblyView::GAssemblyViewPrivate::RequestDataExtension(void) {
+
+    // skip if no data, or already waiting
+    if ( (ruler == 0) || isExtensionPending ) { return; }
+
+    // visible scene range (& in bases)
+    const qreal viewLeft  = view->mapToScene(0, 0).x();
+    const qreal viewWidth = view->viewport()->width() / view->matrix().m11();
+    const qreal dataWidth = ruler->boundingRect().width();
+    const qint32 viewBases = qMax(1, (qint32)(viewWidth / fontWidth));
+    const qint32 extension = qMax(MIN_EXTENSION, 2 * viewBases);
+
+    // region requested
+    GGenomicDataRegion delta(refName, 0, 0, refId);
+    if ( !isAtRightEnd && (viewLeft + (2 * viewWidth) >= dataWidth) ) {
+        isExtendingLeft  = false;
+        delta.LeftBound  = rightBound + 1;
+        delta.RightBound = rightBound + extension;
+        requestedBound   = delta.RightBound;
+    } else if ( !isAtLeftEnd && (viewLeft - viewWidth <= 0) ) {
+        isExtendingLeft  = true;
+        delta.LeftBound  = qMax(1, leftBound - extension);
+        delta.RightBound = leftBound - 1;
+        requestedBound   = delta.LeftBound;
+    } else { return; }
+
+    // keep data within a few viewports of view, evict the rest
+    const qint32 viewColumn = qMax(0, (qint32)( (viewLeft - viewMargin) / fontWidth ));
+    const qint32 keepMargin = qMax(KEEP_VIEWPORTS * viewBases, 4 * MIN_EXTENSION);
+    GGenomicDataRegion keep(refName, 0, 0, refId);
+    keep.LeftBound  = qMax(1, ruler->PositionAtColumn(viewColumn) - keepMargin);
+    keep.RightBound = ruler->PositionAtColumn(viewColumn + viewBases) + keepMargin;
+    if ( isExtendingLeft ) { keep.LeftBound  = qMin(keep.LeftBound,  delta.LeftBound);  }
+    else                   { keep.RightBound = qMax(keep.RightBound, delta.RightBound); }
+
+    isExtensionPending = true;
+    emit view->DataExtensionRequested(delta, keep);
+}
+
+void GAssemblyView::GAssemblyViewPrivate::ClearTracks(void) {
+
+    // clear out coordinate/annotation track items
+    if ( trackGroup ) {
+        scene->destroyItemGroup(trackGroup);
+        trackGroup = 0;
+
+        while (!trackItems.isEmpty() ) {
+            QGraphicsItem* item = trackItems.takeFirst();
+            if ( item == NULL ) { continue; }
+            scene->removeItem(item);
+            delete item;
+            item = 0;
         }
-        // increment window position marker
-        ++windowPosition;
     }
+    ruler = 0;
+}
+
+void GAssemblyView::GAssemblyViewPrivate::ShowTracks(const GGenomicDataSet& data) {
+
+    // reset track boundary
+    nextAvailableTrackStart = 0;
+
+    // draw coordinate & annotation components
+    ShowCoordinates(data.Padding);
+    ShowReferenceSequence(data.Sequence);
+    ShowGenes(data.Genes);
+    ShowSnps(data.Snps);
+    if ( settingsManager->IsGenotypesVisible() ) { ShowGenotypes(data.Genotypes, data.Padding); }
+    scene->update();
+}
+
+void GAssemblyView::GAssemblyViewPrivate::ShowCoordinates(const GPaddingMap& padding) {
+
+    // single ruler item paints labels & tick marks for exposed area only
+    ruler = new GVisibleRulerItem(leftBound, rightBound, padding, font, fontWidth, viewMargin);
+    ruler->setPos(0, nextAvailableTrackStart);
+    ruler->setZValue(5);
+
+    // add ruler to scene
+    scene->addItem(ruler);
+    trackItems.append(ruler);
 
     // save next track position
-    nextAvailableTrackStart = tickMark_Ypos + 10;
+    nextAvailableTrackStart += (int)GVisibleRulerItem::HEIGHT;
 }
 
 void GAssemblyView::GAssemblyViewPrivate::ShowReferenceSequence(const QString& sequence) {
@@ -437,11 +607,9 @@ void GAssemblyView::GAssemblyViewPrivate::ShowReferenceSequence(const QString& s
     // skip if nothing to draw
     if ( sequence.isEmpty() ) { return; }
 
-    // create new text item
-    QGraphicsTextItem* item = new QGraphicsTextItem(sequence);
-    item->setFont(font);
-    item->setPos( viewMargin/2, nextAvailableTrackStart );
-    item->setDefaultTextColor( QColor(Qt::white) );
+    // create new sequence item (columns line up with alignment bases)
+    GVisibleSequenceItem* item = new GVisibleSequenceItem(sequence, font, fontHeight, fontWidth, QColor(Qt::white));
+    item->setPos( viewMargin, nextAvailableTrackStart );
     item->setZValue(5);
 
     // save sequence as track item
@@ -554,6 +722,47 @@ void GAssemblyView::GAssemblyViewPrivate::ShowSnps(const GSnpList& snps) {
     nextAvailableTrackStart += (rows.size() * (snpSpacer*fontHeight)) + 10;
 }
 
+void GAssemblyView::GAssemblyViewPrivate::ShowGenotypes(const GGenotypeMatrix& genotypes, const GPaddingMap& padding) {
+
+    // skip if nothing to draw
+    if ( genotypes.IsEmpty() ) { return; }
+
+    // calculate X coordinate for each site
+    // note - like SNP padding offsets, includes all pads at genomic positions up to & including site
+    QList<qreal> siteX;
+    GPaddingMap::const_iterator padIter = padding.constBegin();
+    GPaddingMap::const_iterator padEnd  = padding.constEnd();
+    qint32 paddingOffset = 0;
+    qint32 lastPosition  = 0;
+    foreach ( const qint32 position, genotypes.Positions ) {
+
+        // restart padding scan if sites out of order
+        if ( position < lastPosition ) {
+            padIter = padding.constBegin();
+            paddingOffset = 0;
+        }
+        lastPosition = position;
+
+        for ( ; (padIter != padEnd) && (padIter.key() <= position); ++padIter ) {
+            paddingOffset += padIter.value();
+        }
+        siteX.append( ((position + paddingOffset - leftBound)*fontWidth) + viewMargin );
+    }
+
+    // create visible item
+    GVisibleGenotypeItem* item = new GVisibleGenotypeItem(genotypes, siteX, fontHeight, fontWidth);
+    if ( item == NULL ) { return; }
+    item->setZValue(5);
+    item->setPos(0, nextAvailableTrackStart);
+
+    // add genotype item to scene
+    scene->addItem(item);
+    trackItems.append(item);
+
+    // save next track position
+    nextAvailableTrackStart += (int)item->boundingRect().height() + 10;
+}
+
 void GAssemblyView::GAssemblyViewPrivate::UpdateTrackBackground(void) {
 
     scene->update();
@@ -589,32 +798,33 @@ void GAssemblyView::GAssemblyViewPrivate::ShowAlignments(const GAlignmentList& a
     AdjustGroupLayout();
 }
 
-void GAssemblyView::GAssemblyViewPrivate::CreateNewAlignmentGroups(const GAlignmentList& alignments) {
+// creates empty group, adds it to scene & group map
+GVisibleAlignmentGroup* GAssemblyView::GAssemblyViewPrivate::CreateGroup(const QString& label) {
 
     // get current 'normal' color scheme for creating groups
     const GColorScheme& colorScheme = settingsManager->NormalColorScheme();
 
-    // if 'merge groups' active, create single alignment group
-    if ( settingsManager->IsGroupsMerged() ) {
-
-        // create group
-        QString groupLabel = "Merged";
-        GVisibleAlignmentGroup* visibleGroup = new GVisibleAlignmentGroup(groupLabel, colorScheme, font, fontHeight, fontWidth, leftBound);
-        connect(visibleGroup, SIGNAL(GroupExpanded()),  view, SLOT(AdjustGroupLayout()));
-        connect(visibleGroup, SIGNAL(GroupCollapsed()), view, SLOT(AdjustGroupLayout()));
-        connect(view, SIGNAL(HorizontalScrollChanged(int,qreal)), visibleGroup, SLOT(MoveHeaderToPosition(int, qreal)));
+    // create group
+    GVisibleAlignmentGroup* visibleGroup = new GVisibleAlignmentGroup(label, colorScheme, font, fontHeight, fontWidth, leftBound, settingsManager->IsPackedRendering());
+    connect(visibleGroup, SIGNAL(GroupExpanded()),  view, SLOT(AdjustGroupLayout()));
+    connect(visibleGroup, SIGNAL(GroupCollapsed()), view, SLOT(AdjustGroupLayout()));
+    connect(view, SIGNAL(HorizontalScrollChanged(int,qreal)), visibleGroup, SLOT(MoveHeaderToPosition(int, qreal)));
 
-        // set bases-visible flag
-        visibleGroup->SetBasesVisible( settingsManager->IsBasesVisible() );
+    // set bases-visible flag
+    visibleGroup->SetBasesVisible( settingsManager->IsBasesVisible() );
 
-        // add alignments to group
-        visibleGroup->AddAlignments(alignments);
+    // add group to scene, store group data
+    scene->addItem(visibleGroup);
+    groupMap.insert(label, visibleGroup);
+    return visibleGroup;
+}
 
-        // add group to scene
-        scene->addItem(visibleGroup);
+void GAssemblyView::GAssemblyViewPrivate::CreateNewAlignmentGroups(const GAlignmentList& alignments) {
 
-        // store group data
-        groupMap.insert(groupLabel, visibleGroup);
+    // if 'merge groups' active, create single alignment group
+    if ( settingsManager->IsGroupsMerged() ) {
+        GVisibleAlignmentGroup* visibleGroup = CreateGroup("Merged");
+        visibleGroup->AddAlignments(alignments);
     }
 
     // else split by read group text
@@ -630,18 +840,7 @@ void GAssemblyView::GAssemblyViewPrivate::CreateNewAlignmentGroups(const GAlignm
             }
 
             // else create new group
-            else {
-                visibleGroup = new GVisibleAlignmentGroup(label, colorScheme, font, fontHeight, fontWidth, leftBound);
-                connect(visibleGroup, SIGNAL(GroupExpanded()),  view, SLOT(AdjustGroupLayout()));
-                connect(visibleGroup, SIGNAL(GroupCollapsed()), view, SLOT(AdjustGroupLayout()));
-                connect(view, SIGNAL(HorizontalScrollChanged(int,qreal)), visibleGroup, SLOT(MoveHeaderToPosition(int, qreal)));
-
-                // set bases-visible flag
-                visibleGroup->SetBasesVisible( settingsManager->IsBasesVisible() );
-
-                scene->addItem(visibleGroup);
-                groupMap.insert(label, visibleGroup);
-            }
+            else { visibleGroup = CreateGroup(label); }
 
             // store alignment in visible group
             visibleGroup->AddAlignment(alignment);
@@ -717,8 +916,11 @@ GAlleleList GAssemblyView::GAssemblyViewPrivate::AllelesOverlappingPosition(qint
 }
 
 void GAssemblyView::GAssemblyViewPrivate::MergeReadGroups(bool ok) {
-
     Q_UNUSED(ok);
+    RedrawAlignments();
+}
+
+void GAssemblyView::GAssemblyViewPrivate::RedrawAlignments(void) {
 
     // get current alignments
     GAlignmentList alignments;
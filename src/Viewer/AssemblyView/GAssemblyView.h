@@ -30,8 +30,10 @@
 
 #include <QList>
 #include <QGraphicsView>
+#include <QRectF>
 #include "DataStructures/GAlignment.h"
 #include "DataStructures/GAllele.h"
+#include "DataStructures/GGenomicDataRegion.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
 class QAction;
 class QString;
@@ -62,13 +64,24 @@ class GAssemblyView : public QGraphicsView {
         void MouseOverAlleles(GAlleleList alleles);
         void HorizontalScrollChanged(int value, qreal horizontalScaleFactor);
         void VerticalScrollChanged(int value, qreal verticalScaleFactor);
+        // view scrolled near an edge of current data - requests adjacent region (delta), data outside keep may go
+        void DataExtensionRequested(const GGenomicDataRegion& delta, const GGenomicDataRegion& keep);
+        // short user-visible message (e.g. repaints falling behind)
+        void StatusMessage(const QString& message);
+        // genotype track shown/hidden - genotypes are only loaded while shown
+        void GenotypesVisibilityChanged(bool visible);
+        // current data must be loaded again (e.g. after genotypes are shown)
+        void DataReloadRequested(const GGenomicDataRegion& region);
 
     public slots:
         void ClearCurrentData(void);
         void SetCenterOn(qint32 position);
         void MergeReadGroups(bool ok);
+        void SetPackedRendering(bool ok);
         void ShowBases(bool ok);
+        void ShowGenotypes(bool ok);
         void ShowData(const GGenomicDataSet& data);
+        void UpdateData(const GGenomicDataSet& data);
         void ZoomIn(void);
         void ZoomOut(void);
         void ZoomReset(void);
@@ -82,6 +95,9 @@ class GAssemblyView : public QGraphicsView {
         void CatchGeneClick(const GGene& gene);
         void CatchSnpClick(const GSnp& snp);
         void CatchMouseMove(const QPoint& mousePos);
+        void CatchSceneChanged(const QList<QRectF>& rects);
+        void ApplyScrollChanges(void);
+        void ReportDroppedFrames(int count);
 
     private:
         void ShowSnpInfoDialog(const GSnp& snp);
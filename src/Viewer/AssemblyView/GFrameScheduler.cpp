@@ -0,0 +1,98 @@
+// ***************************************************************************
+// GFrameScheduler.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Coalesces viewport invalidations (scene changes, scrolling, cursor) into at
+// most one partial repaint per display frame. Reports frames dropped by slow
+// repaints.
+// ***************************************************************************
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GFrameScheduler.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+GFrameScheduler::GFrameScheduler(QWidget* viewport, QObject* parent)
+    : QObject(parent)
+    , m_viewport(viewport)
+    , m_isAllDirty(false)
+    , m_frameInterval(16)   // ~60 fps
+    , m_droppedFrames(0)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(RunFrame()));
+    m_lastFrame.start();
+}
+
+GFrameScheduler::~GFrameScheduler(void) { }
+
+int GFrameScheduler::DroppedFrames(void) const {
+    return m_droppedFrames;
+}
+
+void GFrameScheduler::SetFrameInterval(int msecs) {
+    m_frameInterval = qMax(1, msecs);
+}
+
+void GFrameScheduler::Invalidate(const QRect& rect) {
+    if ( m_isAllDirty || rect.isEmpty() ) { ScheduleFrame(); return; }
+    m_dirtyRegion += rect;
+    ScheduleFrame();
+}
+
+void GFrameScheduler::InvalidateAll(void) {
+    m_isAllDirty = true;
+    m_dirtyRegion = QRegion();
+    ScheduleFrame();
+}
+
+// start frame timer (if not already running), no sooner than one interval after last frame
+void GFrameScheduler::ScheduleFrame(void) {
+    if ( m_timer.isActive() ) { return; }
+    if ( !m_isAllDirty && m_dirtyRegion.isEmpty() ) { return; }
+    m_firstDirty.start();
+    m_timer.start( qMax(0, m_frameInterval - m_lastFrame.elapsed()) );
+}
+
+void GFrameScheduler::RunFrame(void) {
+
+    m_lastFrame.start();
+
+    // let listeners apply coalesced moves (may add to dirty region)
+    emit FrameStarted();
+
+    // take dirty area, reset for next frame
+    const QRegion region = ( m_isAllDirty ? QRegion(m_viewport->rect()) : (m_dirtyRegion & m_viewport->rect()) );
+    m_isAllDirty = false;
+    m_dirtyRegion = QRegion();
+    if ( region.isEmpty() ) { return; }
+
+    // repaint now, so frame cost can be measured
+    m_viewport->repaint(region);
+
+    // frame is late if first invalidation waited more than one interval (plus frame) to reach screen
+    const int latency = m_firstDirty.elapsed();
+    const int dropped = (latency / m_frameInterval) - 1;
+    if ( dropped > 0 ) {
+        m_droppedFrames += dropped;
+        emit FramesDropped(dropped);
+    }
+}
@@ -0,0 +1,86 @@
+// ***************************************************************************
+// GFrameScheduler.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Coalesces viewport invalidations (scene changes, scrolling, cursor) into at
+// most one partial repaint per display frame. Reports frames dropped by slow
+// repaints.
+// ***************************************************************************
+
+#ifndef G_FRAMESCHEDULER_H
+#define G_FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QRect>
+#include <QRegion>
+#include <QTime>
+#include <QTimer>
+class QWidget;
+
+namespace Gambit {
+namespace Viewer {
+
+class GFrameScheduler : public QObject {
+
+    Q_OBJECT
+
+    // constructors & destructors
+    public:
+        GFrameScheduler(QWidget* viewport, QObject* parent = 0);
+        ~GFrameScheduler(void);
+
+    // settings & statistics
+    public:
+        int  DroppedFrames(void) const;
+        void SetFrameInterval(int msecs);
+
+    // mark viewport areas for next frame
+    public slots:
+        void Invalidate(const QRect& rect);
+        void InvalidateAll(void);
+
+    signals:
+        // emitted before each repaint, last chance to move items for this frame
+        void FrameStarted(void);
+        // emitted when a frame finishes later than its deadline
+        void FramesDropped(int count);
+
+    // internal methods
+    private slots:
+        void RunFrame(void);
+    private:
+        void ScheduleFrame(void);
+
+    // data members
+    private:
+        QWidget* m_viewport;
+        QRegion  m_dirtyRegion;
+        bool     m_isAllDirty;
+        QTimer   m_timer;
+        QTime    m_lastFrame;     // start of last frame
+        QTime    m_firstDirty;    // first invalidation since last frame
+        int      m_frameInterval;
+        int      m_droppedFrames;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_FRAMESCHEDULER_H
@@ -0,0 +1,171 @@
+// ***************************************************************************
+// GGlyphAtlas.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Pre-rendered base glyphs (one row per text color) for blitting sequence text.
+// Glyphs are queued during paint and drawn in a single batch by Flush().
+// ***************************************************************************
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GGlyphAtlas.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+const QString GGlyphAtlas::GLYPHS    = QString("ACGTN-*acgtn");
+const int     GGlyphAtlas::MAX_SCALE = 4;
+
+GGlyphAtlas::GGlyphAtlas(const QFont& font, int fontHeight, int fontWidth, int scale)
+    : m_font(font)
+    , m_fontHeight(fontHeight)
+    , m_fontWidth(fontWidth)
+    , m_scale(scale)
+    , m_isPixmapDirty(false)
+    , m_usePixmap( QThread::currentThread() == qApp->thread() )
+{ }
+
+GGlyphAtlas::~GGlyphAtlas(void) { }
+
+GGlyphAtlas* GGlyphAtlas::Instance(const QFont& font, int fontHeight, int fontWidth, const qreal& levelOfDetail) {
+
+    const int scale = ScaleFor(levelOfDetail);
+
+    static QHash<QString, GGlyphAtlas*> atlases;
+    const QString key = QString("%1|%2|%3|%4").arg(font.key()).arg(fontHeight).arg(fontWidth).arg(scale);
+    GGlyphAtlas* atlas = atlases.value(key, 0);
+    if ( atlas == 0 ) {
+        atlas = new GGlyphAtlas(font, fontHeight, fontWidth, scale);
+        atlases.insert(key, atlas);
+    }
+    return atlas;
+}
+
+// render at next whole device scale so zoomed-in glyphs stay sharp
+int GGlyphAtlas::ScaleFor(const qreal& levelOfDetail) {
+    return qBound( 1, (int)(levelOfDetail + 0.99), MAX_SCALE );
+}
+
+bool GGlyphAtlas::IsThreadedTextSupported(void) {
+#if QT_VERSION >= 0x040800
+    return QFontDatabase::supportsThreadedFontRendering();
+#else
+    return false;
+#endif
+}
+
+// returns atlas row for color, rendering it on first use
+int GGlyphAtlas::ColorRow(const QColor& color) {
+    const QRgb rgb = color.rgba();
+    QHash<QRgb, int>::const_iterator found = m_colorRows.constFind(rgb);
+    if ( found != m_colorRows.constEnd() ) { return found.value(); }
+    RenderRow(color);
+    return m_colorRows.value(rgb);
+}
+
+void GGlyphAtlas::RenderRow(const QColor& color) {
+
+    // grow image by one row, keeping existing rows (queued sources stay valid)
+    const int cellWidth  = m_fontWidth  * m_scale;
+    const int cellHeight = m_fontHeight * m_scale;
+    const int row = m_colorRows.size();
+    QImage image( GLYPHS.length() * cellWidth, (row + 1) * cellHeight, QImage::Format_ARGB32_Premultiplied );
+    image.fill(0);
+
+    QPainter painter(&image);
+    if ( !m_image.isNull() ) { painter.drawImage(0, 0, m_image); }
+
+    // draw glyphs on same baseline as sequence text (cell top + height - 4)
+    painter.scale(m_scale, m_scale);
+    painter.setFont(m_font);
+    painter.setPen(color);
+    for ( int i = 0; i < GLYPHS.length(); ++i ) {
+        painter.drawText( i * m_fontWidth, (row * m_fontHeight) + m_fontHeight - 4, QString(GLYPHS.at(i)) );
+    }
+    painter.end();
+
+    m_image = image;
+    m_isPixmapDirty = true;
+    m_colorRows.insert(color.rgba(), row);
+}
+
+bool GGlyphAtlas::Queue(const QChar& base, const QColor& color, const qreal& x, const qreal& y) {
+
+    const int column = GLYPHS.indexOf(base);
+    if ( column < 0 ) { return false; }
+
+    const int row = ColorRow(color);
+    const QRectF source( column * m_fontWidth * m_scale, row * m_fontHeight * m_scale,
+                         m_fontWidth * m_scale, m_fontHeight * m_scale );
+
+#if QT_VERSION >= 0x040700
+    // fragment position is its center
+    const qreal inverse = 1.0 / m_scale;
+    m_queue.append( QPainter::PixmapFragment::create( QPointF(x + m_fontWidth/2.0, y + m_fontHeight/2.0),
+                                                      source, inverse, inverse) );
+#else
+    m_queueTargets.append( QRectF(x, y, m_fontWidth, m_fontHeight) );
+    m_queueSources.append(source);
+#endif
+    return true;
+}
+
+void GGlyphAtlas::Flush(QPainter* painter) {
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    // off GUI thread, draw straight from image
+    if ( !m_usePixmap ) {
+#if QT_VERSION >= 0x040700
+        for ( int i = 0; i < m_queue.size(); ++i ) {
+            const QPainter::PixmapFragment& f = m_queue.at(i);
+            const QSizeF size(f.width * f.scaleX, f.height * f.scaleY);
+            painter->drawImage( QRectF(QPointF(f.x - size.width()/2, f.y - size.height()/2), size),
+                                m_image, QRectF(f.sourceLeft, f.sourceTop, f.width, f.height) );
+        }
+        m_queue.clear();
+#else
+        for ( int i = 0; i < m_queueTargets.size(); ++i ) {
+            painter->drawImage( m_queueTargets.at(i), m_image, m_queueSources.at(i) );
+        }
+        m_queueTargets.clear();
+        m_queueSources.clear();
+#endif
+        return;
+    }
+
+    // upload any newly rendered rows
+    if ( m_isPixmapDirty ) {
+        m_pixmap = QPixmap::fromImage(m_image);
+        m_isPixmapDirty = false;
+    }
+
+#if QT_VERSION >= 0x040700
+    if ( !m_queue.isEmpty() ) {
+        painter->drawPixmapFragments( m_queue.constData(), m_queue.size(), m_pixmap );
+        m_queue.clear();
+    }
+#else
+    for ( int i = 0; i < m_queueTargets.size(); ++i ) {
+        painter->drawPixmap( m_queueTargets.at(i), m_pixmap, m_queueSources.at(i) );
+    }
+    m_queueTargets.clear();
+    m_queueSources.clear();
+#endif
+}
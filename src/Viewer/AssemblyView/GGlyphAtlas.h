@@ -0,0 +1,99 @@
+// ***************************************************************************
+// GGlyphAtlas.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Pre-rendered base glyphs (one row per text color) for blitting sequence text.
+// Glyphs are queued during paint and drawn in a single batch by Flush().
+// ***************************************************************************
+
+#ifndef G_GLYPHATLAS_H
+#define G_GLYPHATLAS_H
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+namespace Gambit {
+namespace Viewer {
+
+class GGlyphAtlas {
+
+    // constructors & destructors
+    public:
+        GGlyphAtlas(const QFont& font, int fontHeight, int fontWidth, int scale = 1);
+        ~GGlyphAtlas(void);
+
+    // shared atlas for font & device scale (created on first request)
+    // note - GUI thread only
+    public:
+        static GGlyphAtlas* Instance(const QFont& font, int fontHeight, int fontWidth, const qreal& levelOfDetail = 1.0);
+        // atlas scale used for a view's level of detail
+        static int ScaleFor(const qreal& levelOfDetail);
+        // returns whether text (& so atlases) can be rendered off GUI thread
+        static bool IsThreadedTextSupported(void);
+
+    // glyph drawing
+    public:
+        // queues base glyph with cell top-left at (x,y), returns false if base has no glyph
+        bool Queue(const QChar& base, const QColor& color, const qreal& x, const qreal& y);
+        // draws all queued glyphs in one batch
+        void Flush(QPainter* painter);
+
+    // internal methods
+    private:
+        int  ColorRow(const QColor& color);
+        void RenderRow(const QColor& color);
+
+    // data members
+    private:
+        QFont m_font;
+        int   m_fontHeight;
+        int   m_fontWidth;
+        int   m_scale;
+
+        QImage           m_image;
+        QPixmap          m_pixmap;
+        bool             m_isPixmapDirty;
+        bool             m_usePixmap;     // QPixmap only allowed in GUI thread
+        QHash<QRgb, int> m_colorRows;
+
+#if QT_VERSION >= 0x040700
+        QVector<QPainter::PixmapFragment> m_queue;
+#else
+        QVector<QRectF> m_queueTargets;
+        QVector<QRectF> m_queueSources;
+#endif
+
+    // static constants
+    private:
+        static const QString GLYPHS;
+        static const int     MAX_SCALE;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_GLYPHATLAS_H
@@ -0,0 +1,144 @@
+// ***************************************************************************
+// GTileCache.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Bounded (LRU) cache of pre-rendered view tiles. Tiles are rendered off the
+// GUI thread on a dedicated worker pool by a GTileRenderer.
+// ***************************************************************************
+
+#include <QtCore>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GTileCache.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+const int GTileCache::MAX_BYTES = 128 * 1024 * 1024;
+
+// renders queued tiles on worker pool, until queue is empty
+class GTileCache::GTileWorker : public QRunnable {
+
+    public:
+        GTileWorker(GTileCache* cache)
+            : Cache(cache)
+        { }
+
+        void run(void) {
+            GTileRequest request;
+            while ( Cache->Take(request) ) {
+                Cache->Finish( request, request.Renderer->RenderTile(request.Rect, request.Scale) );
+            }
+        }
+
+    private:
+        GTileCache* Cache;
+};
+
+GTileCache::GTileCache(int maxBytes)
+    : m_tiles(maxBytes)
+    , m_workerCount(0)
+{
+    // leave a core for the GUI thread
+    m_pool.setMaxThreadCount( qMax(1, QThread::idealThreadCount() - 1) );
+}
+
+GTileCache::~GTileCache(void) {
+    m_pool.waitForDone();
+}
+
+GTileCache* GTileCache::Instance(void) {
+    static GTileCache cache;
+    return &cache;
+}
+
+bool GTileCache::Find(const QString& key, QImage& tile) {
+    QMutexLocker locker(&m_mutex);
+    QImage* cached = m_tiles.object(key);
+    if ( cached == 0 ) { return false; }
+    tile = *cached;
+    return true;
+}
+
+void GTileCache::Request(const QString& key, const GTileRenderer* renderer, const QRectF& rect, const qreal& scale) {
+
+    QMutexLocker locker(&m_mutex);
+    if ( m_tiles.contains(key) || m_pending.contains(key) ) { return; }
+
+    // queue tile
+    GTileRequest request;
+    request.Key      = key;
+    request.Renderer = renderer;
+    request.Rect     = rect;
+    request.Scale    = scale;
+    m_queue.append(request);
+    m_pending.insert(key);
+
+    // start another worker if a pool thread is free (workers never wait in pool's own queue)
+    if ( m_workerCount < m_pool.maxThreadCount() ) {
+        ++m_workerCount;
+        m_pool.start( new GTileWorker(this) );
+    }
+}
+
+void GTileCache::WaitFor(const GTileRenderer* renderer) {
+
+    QMutexLocker locker(&m_mutex);
+
+    // drop renderer's queued tiles
+    for ( int i = 0; i < m_queue.size(); ) {
+        if ( m_queue.at(i).Renderer == renderer ) {
+            m_pending.remove( m_queue.at(i).Key );
+            m_queue.removeAt(i);
+        } else { ++i; }
+    }
+
+    // wait for those already being rendered
+    while ( m_runningCounts.contains(renderer) ) {
+        m_jobsDone.wait(&m_mutex);
+    }
+}
+
+// takes next queued tile (marking it running), returns false (retiring worker) if none left
+bool GTileCache::Take(GTileRequest& request) {
+
+    QMutexLocker locker(&m_mutex);
+    if ( m_queue.isEmpty() ) {
+        --m_workerCount;
+        return false;
+    }
+
+    request = m_queue.takeFirst();
+    ++m_runningCounts[request.Renderer];
+    return true;
+}
+
+void GTileCache::Finish(const GTileRequest& request, const QImage& tile) {
+
+    QMutexLocker locker(&m_mutex);
+    m_pending.remove(request.Key);
+    if ( !tile.isNull() ) {
+        m_tiles.insert( request.Key, new QImage(tile), tile.byteCount() );
+    }
+
+    // wake WaitFor() when renderer has no tiles running
+    if ( --m_runningCounts[request.Renderer] == 0 ) {
+        m_runningCounts.remove(request.Renderer);
+        m_jobsDone.wakeAll();
+    }
+}
@@ -0,0 +1,106 @@
+// ***************************************************************************
+// GTileCache.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Bounded (LRU) cache of pre-rendered view tiles. Tiles are rendered off the
+// GUI thread on a dedicated worker pool by a GTileRenderer.
+// ***************************************************************************
+
+#ifndef G_TILECACHE_H
+#define G_TILECACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QRectF>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+namespace Gambit {
+namespace Viewer {
+
+// implemented by items that can paint any rect of themselves from any thread
+// note - renderer data must not change while its tiles are pending (see GTileCache::WaitFor)
+class GTileRenderer {
+    public:
+        virtual ~GTileRenderer(void) { }
+        virtual QImage RenderTile(const QRectF& rect, const qreal& scale) const = 0;
+};
+
+class GTileCache {
+
+    // constructors & destructors
+    public:
+        GTileCache(int maxBytes = MAX_BYTES);
+        ~GTileCache(void);
+
+    // shared cache for all views
+    public:
+        static GTileCache* Instance(void);
+
+    // tile access
+    public:
+        // returns true (and tile) if cached
+        bool Find(const QString& key, QImage& tile);
+        // queues tile rendering, unless already cached or pending
+        void Request(const QString& key, const GTileRenderer* renderer, const QRectF& rect, const qreal& scale);
+        // drops renderer's queued tiles & waits for its running ones (never for queued work)
+        // call before changing renderer data, or destroying renderer
+        void WaitFor(const GTileRenderer* renderer);
+
+    // queued tile
+    private:
+        struct GTileRequest {
+            QString              Key;
+            const GTileRenderer* Renderer;
+            QRectF               Rect;
+            qreal                Scale;
+        };
+
+    // internal methods
+    private:
+        class GTileWorker;
+        bool Take(GTileRequest& request);
+        void Finish(const GTileRequest& request, const QImage& tile);
+
+    // data members
+    private:
+        QMutex         m_mutex;
+        QWaitCondition m_jobsDone;
+        QThreadPool    m_pool;
+        QCache<QString, QImage>          m_tiles;
+        QSet<QString>                    m_pending;       // queued or running
+        QList<GTileRequest>              m_queue;         // not yet taken by a worker
+        QHash<const GTileRenderer*, int> m_runningCounts;
+        int                              m_workerCount;
+
+    // static constants
+    public:
+        static const int MAX_BYTES;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_TILECACHE_H
@@ -30,6 +30,7 @@
 #include "Viewer/AssemblyView/GVisibleAlignmentGroup.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentGroupHeader.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
+#include "Viewer/AssemblyView/GVisiblePackedAlignments.h"
 #include "DataStructures/GColorScheme.h"
 using namespace Gambit;
 using namespace Gambit::Viewer;
@@ -46,9 +47,11 @@ struct GVisibleAlignmentGroup::GVisibleAlignmentGroupPrivate {
     GVisibleAlignmentGroupHeader* headerWidget;
     QGraphicsProxyWidget*         headerProxy;
     QList<GVisibleAlignmentItem*> alignmentItems;
+    GVisiblePackedAlignments*     packedItem;       // used instead of alignment items, if packed
 
     bool isModified;
     bool isBasesVisible;
+    bool isCollapsed;
 
     const qreal ALIGNMENT_HEIGHT;
     const qreal SPACER;
@@ -67,8 +70,12 @@ struct GVisibleAlignmentGroup::GVisibleAlignmentGroupPrivate {
         , fontHeight(some_fontHeight)
         , fontWidth(some_fontWidth)
         , leftBound(some_leftBound)
+        , headerWidget(0)
+        , headerProxy(0)
+        , packedItem(0)
         , isModified(false)
         , isBasesVisible(false)
+        , isCollapsed(false)
         , ALIGNMENT_HEIGHT(15)
         , SPACER(2)
         , VIEW_MARGIN(5)
@@ -84,11 +91,18 @@ GVisibleAlignmentGroup::GVisibleAlignmentGroup(const QString& readGroup,
                                                const int&     fontHeight,
                                                const int&     fontWidth,
                                                const qint32&  leftBound,
+                                               bool           isPacked,
                                                QGraphicsItem* parent)
     : QGraphicsItemGroup(parent)
 {   
     d = new GVisibleAlignmentGroupPrivate(readGroup, colorScheme, font, fontHeight, fontWidth, leftBound);
 
+    // packed groups store all alignments in a single item
+    if ( isPacked ) {
+        d->packedItem = new GVisiblePackedAlignments(font, fontHeight, fontWidth);
+        addToGroup(d->packedItem);
+    }
+
     // group header widget and alignment items handle their own mouse events
     setZValue(-10);
     setHandlesChildEvents(false);
@@ -112,6 +126,16 @@ QRectF GVisibleAlignmentGroup::boundingRect(void) const {
         bottomRight_Y = d->headerProxy->size().height();
     }
 
+    // packed alignments are bounded by a single item
+    if ( d->packedItem ) {
+        if ( d->packedItem->isVisible() ) {
+            const QRectF packedRect = d->packedItem->boundingRect().translated( d->packedItem->pos() );
+            bottomRight_X = qMax(bottomRight_X, packedRect.right());
+            bottomRight_Y = qMax(bottomRight_Y, packedRect.bottom());
+        }
+        return QRectF(0, 0, bottomRight_X, bottomRight_Y);
+    }
+
     foreach (GVisibleAlignmentItem* gvaItem, d->alignmentItems) {
 
         // skip invalid or non-visible items
@@ -145,11 +169,18 @@ void GVisibleAlignmentGroup::SetReadGroup(QString& readGroup) {
 
 void GVisibleAlignmentGroup::MoveHeaderToPosition(int value, qreal horizontalScaleFactor) {
     if ( d->headerProxy == 0 ) { return; }
-    prepareGeometryChange();
-    d->headerProxy->setPos(value/horizontalScaleFactor, 0);
+    // note - group bounds don't depend on header position, so no prepareGeometryChange() needed
+    const QPointF headerPos(value/horizontalScaleFactor, 0);
+    if ( d->headerProxy->pos() == headerPos ) { return; }
+    d->headerProxy->setPos(headerPos);
 }
 
 void GVisibleAlignmentGroup::AddAlignment(GAlignment& alignment) {
+    if ( d->packedItem ) {
+        d->packedItem->AddAlignment(alignment);
+        d->isModified = true;
+        return;
+    }
     GVisibleAlignmentItem* item = new GVisibleAlignmentItem(alignment, d->isBasesVisible, d->font, d->fontHeight, d->fontWidth);
     item->SetColorScheme(d->colorScheme);
     AddAlignmentItem(item);
@@ -164,10 +195,33 @@ void GVisibleAlignmentGroup::AddAlignments(GAlignmentList alignments) {
 void GVisibleAlignmentGroup::AddAlignmentItem(GVisibleAlignmentItem* item) {
     if ( item == 0 ) { return; }
     addToGroup(item);
+    item->setVisible(!d->isCollapsed);
     d->alignmentItems.append(item);
     d->isModified = true;
 }
 
+void GVisibleAlignmentGroup::SetAlignments(const GAlignmentList& alignments) {
+
+    // packed item re-uses rows of alignments it already has
+    if ( d->packedItem ) {
+        d->packedItem->SetAlignments(alignments);
+        d->isModified = true;
+    }
+
+    // otherwise replace alignment items
+    else {
+        foreach (GVisibleAlignmentItem* item, d->alignmentItems) {
+            if ( item == 0 ) { continue; }
+            removeFromGroup(item);
+            delete item;
+        }
+        d->alignmentItems.clear();
+        AddAlignments(alignments);
+    }
+
+    // re-draw alignments, if already drawn (header is kept)
+    if ( d->headerWidget ) { DrawAlignments(); }
+}
 
 
 void GVisibleAlignmentGroup::Clear(void) {
@@ -182,6 +236,7 @@ void GVisibleAlignmentGroup::Clear(void) {
 
     // clear item list
     d->alignmentItems.clear();
+    if ( d->packedItem ) { d->packedItem->Clear(); }
 
     // delete header proxy widget (and embedded widget)
     if ( d->headerProxy ) {
@@ -202,6 +257,14 @@ void GVisibleAlignmentGroup::DrawAlignments(void) {
     // prepare QGraphicsItem for boundingRect() change
     prepareGeometryChange();
 
+    // packed alignments are laid out by their item
+    if ( d->packedItem ) {
+        d->packedItem->setPos(0, d->headerWidget->size().height());
+        d->packedItem->Layout(d->leftBound, d->ALIGNMENT_HEIGHT+d->SPACER, d->VIEW_MARGIN, d->SPACER);
+        d->isModified = false;
+        return;
+    }
+
     // iterate over all alignment items in group
     foreach(GVisibleAlignmentItem* gvaItem, d->alignmentItems) {
 
@@ -271,6 +334,8 @@ void GVisibleAlignmentGroup::Expand(void) {
     prepareGeometryChange();
 
     // show all alignment items
+    d->isCollapsed = false;
+    if ( d->packedItem ) { d->packedItem->show(); }
     foreach (GVisibleAlignmentItem* item, d->alignmentItems) {
         if ( item == 0 ) { continue; }
         item->show();
@@ -286,6 +351,8 @@ void GVisibleAlignmentGroup::Collapse(void) {
     prepareGeometryChange();
 
     // hide all alignment items
+    d->isCollapsed = true;
+    if ( d->packedItem ) { d->packedItem->hide(); }
     foreach (GVisibleAlignmentItem* item, d->alignmentItems) {
         if ( item == 0 ) { continue; }
         item->hide();
@@ -303,6 +370,17 @@ GAlleleList GVisibleAlignmentGroup::AllelesOverlappingPosition(qint32 position)
 
     GAlleleList alleles;
 
+    // iterate over packed alignments
+    if ( d->packedItem ) {
+        foreach (const GAlignment& alignment, d->packedItem->Alignments()) {
+            GAllele allele;
+            if ( AlleleAt(allele, alignment, position) ) {
+                alleles.append(allele);
+            }
+        }
+        return alleles;
+    }
+
     // iterate over alignment items in group
     foreach(GVisibleAlignmentItem* item, d->alignmentItems) {
 
@@ -323,6 +401,7 @@ GAlleleList GVisibleAlignmentGroup::AllelesOverlappingPosition(qint32 position)
 }
 
 GAlignmentList GVisibleAlignmentGroup::Alignments(void) {
+    if ( d->packedItem ) { return d->packedItem->Alignments(); }
     GAlignmentList alignments;
     foreach (GVisibleAlignmentItem* item, d->alignmentItems) {
         if ( item == 0 ) { continue; }
@@ -347,8 +426,23 @@ void GVisibleAlignmentGroup::SetColorScheme(const GColorScheme& colorScheme) {
     update();
 }
 
+bool GVisibleAlignmentGroup::IsPacked(void) const {
+    return ( d->packedItem != 0 );
+}
+
+void GVisibleAlignmentGroup::SetPackedColorSchemes(const GColorScheme& normal,
+                                                   const GColorScheme& dimmed,
+                                                   const GColorScheme& highlighted,
+                                                   const GAlignment::GAlignmentOptions& dimmedFlags,
+                                                   const GAlignment::GAlignmentOptions& highlightedFlags)
+{
+    if ( d->packedItem == 0 ) { return; }
+    d->packedItem->SetColorSchemes(normal, dimmed, highlighted, dimmedFlags, highlightedFlags);
+}
+
 void GVisibleAlignmentGroup::SetBasesVisible(bool ok) {
     d->isBasesVisible = ok;
+    if ( d->packedItem ) { d->packedItem->SetBasesVisible(ok); }
     foreach (GVisibleAlignmentItem* item, d->alignmentItems) {
         if ( item == NULL ) { continue; }
         item->SetBasesVisible(ok);
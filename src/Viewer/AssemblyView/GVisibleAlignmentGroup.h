@@ -43,6 +43,7 @@ namespace Viewer {
 
 class GVisibleAlignmentItem;
 class GVisibleAlignmentGroupHeader;
+class GVisiblePackedAlignments;
 
 class GVisibleAlignmentGroup : public QObject, public QGraphicsItemGroup {
 
@@ -55,7 +56,8 @@ class GVisibleAlignmentGroup : public QObject, public QGraphicsItemGroup {
                                const int&          fontHeight,
                                const int&          fontWidth,
                                const qint32&       leftBound,
-                               QGraphicsItem*      parent = 0);
+                               bool                isPacked = false,
+                               QGraphicsItem*      parent   = 0);
         ~GVisibleAlignmentGroup(void);
 
         QRectF boundingRect(void) const;
@@ -65,6 +67,13 @@ class GVisibleAlignmentGroup : public QObject, public QGraphicsItemGroup {
         void SetReadGroup(QString& readGroup);
         void SetColorScheme(const GColorScheme& colorScheme);
         void SetBasesVisible(bool ok);
+        // packed groups draw all alignments from a single item (no per-alignment items)
+        bool IsPacked(void) const;
+        void SetPackedColorSchemes(const GColorScheme& normal,
+                                   const GColorScheme& dimmed,
+                                   const GColorScheme& highlighted,
+                                   const GAlignment::GAlignmentOptions& dimmedFlags,
+                                   const GAlignment::GAlignmentOptions& highlightedFlags);
 
     public slots:
         void MoveHeaderToPosition(int value, qreal horizontalScaleFactor);
@@ -82,6 +91,8 @@ class GVisibleAlignmentGroup : public QObject, public QGraphicsItemGroup {
         const QList<GVisibleAlignmentItem*>& AlignmentItems(void);
         void Clear(void);
         void SetAlignmentItems(const QList<GVisibleAlignmentItem*>& items);
+        // replaces group's alignments & re-draws (packed groups keep existing alignments in place)
+        void SetAlignments(const GAlignmentList& alignments);
         void SetLeftBound(qint32 left);
 
     public slots:
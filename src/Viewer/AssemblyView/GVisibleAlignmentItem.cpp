@@ -26,6 +26,7 @@
 
 #include <QtGui>
 #include <QtDebug>
+#include "Viewer/AssemblyView/GGlyphAtlas.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
 using namespace Gambit;
 using namespace Gambit::Viewer;
@@ -38,7 +39,13 @@ const QString GVisibleAlignmentItem::TOOLTIP_TEMPLATE = "<h4>%1</h4>"
                                                         "Strand: %3<br>"
                                                         "Length: %4<br>"
                                                         "Read Group: %5<br>"
-                                                        "MapQuality: %6";
+                                                        "MapQuality: %6<br>"
+                                                        "File: %7";
+
+// minimum on-screen pixels per base for each detail level
+const qreal GVisibleAlignmentItem::TEXT_MIN_PIXELS  = 6.0;
+const qreal GVisibleAlignmentItem::TICKS_MIN_PIXELS = 1.5;
+const qreal GVisibleAlignmentItem::RECTS_MIN_PIXELS = 0.25;
 
 GVisibleAlignmentItem::GVisibleAlignmentItem(const GAlignment& alignment,
                                              bool basesVisible,
@@ -53,18 +60,29 @@ GVisibleAlignmentItem::GVisibleAlignmentItem(const GAlignment& alignment,
     , m_fontWidth(fontWidth)
 {
     setCacheMode(QGraphicsItem::DeviceCoordinateCache);
-    QString tooltipText = TOOLTIP_TEMPLATE.arg(m_alignment.Name)
-                                          .arg(QString::number(m_alignment.Position))
-                                          .arg((m_alignment.IsReverseComplement ? "-" : "+"))
-                                          .arg(QString::number(m_alignment.Length))
-                                          .arg(m_alignment.ReadGroup)
-                                          .arg(m_alignment.MapQuality);
-    setToolTip(tooltipText);
+    setToolTip( ToolTipText(m_alignment) );
     setZValue(-10);
 }
 
 GVisibleAlignmentItem::~GVisibleAlignmentItem(void) { }
 
+QString GVisibleAlignmentItem::ToolTipText(const GAlignment& alignment) {
+    return TOOLTIP_TEMPLATE.arg(alignment.Name)
+                           .arg(QString::number(alignment.Position))
+                           .arg((alignment.IsReverseComplement ? "-" : "+"))
+                           .arg(QString::number(alignment.Length))
+                           .arg(alignment.ReadGroup)
+                           .arg(alignment.MapQuality)
+                           .arg(QFileInfo(alignment.SourceFilename).fileName());
+}
+
+GVisibleAlignmentItem::AlignmentDetailLevel GVisibleAlignmentItem::DetailLevel(const qreal& pixelsPerBase) {
+    if ( pixelsPerBase >= TEXT_MIN_PIXELS )  { return BaseText; }
+    if ( pixelsPerBase >= TICKS_MIN_PIXELS ) { return MismatchTicks; }
+    if ( pixelsPerBase >= RECTS_MIN_PIXELS ) { return ReadRects; }
+    return CoverageSummary;
+}
+
 QRectF GVisibleAlignmentItem::boundingRect(void) const {
     qreal rectWidth  = (m_alignment.PaddedBases.length() * m_fontWidth) + 2;
     qreal rectHeight = m_fontHeight + 2;
@@ -84,6 +102,25 @@ void GVisibleAlignmentItem::paint(QPainter* painter, const QStyleOptionGraphicsI
         backgroundColor = m_colorScheme.ForwardBackground;
     }
 
+    // when zoomed out, skip text & gradient (coverage summary is only available in packed mode)
+    const qreal pixelsPerBase = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()) * m_fontWidth;
+    const AlignmentDetailLevel detail = DetailLevel(pixelsPerBase);
+    if ( detail != BaseText ) {
+        const QString& sequence = m_alignment.PaddedBases;
+        painter->fillRect( QRectF(-1, -1, (sequence.length()*m_fontWidth), m_fontHeight), backgroundColor );
+        if ( detail == MismatchTicks ) {
+            for (int index = 0; index < sequence.length(); ++index) {
+                const QChar base = sequence.at(index);
+                if ( (base == QLatin1Char('-')) ||
+                     ((base != QLatin1Char('N')) && (base != QLatin1Char('*')) && m_alignment.Mismatches.contains(index))
+                   ) {
+                    painter->fillRect( QRectF(index*m_fontWidth - 1, -1, m_fontWidth, m_fontHeight), m_colorScheme.MismatchText );
+                }
+            }
+        }
+        return;
+    }
+
     // set up background color (gradient)
     QLinearGradient gradient(0,0,0,m_fontHeight);
     gradient.setSpread(QGradient::ReflectSpread);
@@ -103,43 +140,48 @@ void GVisibleAlignmentItem::paint(QPainter* painter, const QStyleOptionGraphicsI
     // perform the actual background drawing
     painter->drawRect( QRectF(-1, -1, ( m_alignment.PaddedBases.length()*m_fontWidth ), m_fontHeight) );
 
-    // draw alignment text (GAlignment::Bases)
+    // draw alignment text (GAlignment::Bases), blitted from glyph atlas
+    // (drawText only for bases without a pre-rendered glyph)
+    GGlyphAtlas* atlas = GGlyphAtlas::Instance(m_font, m_fontHeight, m_fontWidth, pixelsPerBase / m_fontWidth);
     painter->setFont(m_font);
-    QString sequence = m_alignment.PaddedBases;
-    QString base;
+    const QString& sequence = m_alignment.PaddedBases;
     int length = sequence.length();
     int xPos = 0;
     int yPos = m_fontHeight - 4;
     for (int index = 0; index < length; ++index) {
 
         // get current base
-        base = sequence.at(index);
+        const QChar base = sequence.at(index);
+
+        // choose text color
+        const QColor* color = 0;
 
         // if base is padding
-        if ( (base == GVisibleAlignmentItem::PADDING_BASE) ) {
-            painter->setPen(m_colorScheme.PaddingText);
-            painter->drawText(xPos, yPos, base);
+        if ( base == PADDING_BASE.at(0) ) {
+            color = &m_colorScheme.PaddingText;
         }
 
         // if base is mismatched from reference - (deletion or mismatch, but not N)
-        else if ( (base == GVisibleAlignmentItem::DELETION_BASE) ||
-                  (m_alignment.Mismatches.contains(index) && (base != GVisibleAlignmentItem::N_BASE))
+        else if ( (base == DELETION_BASE.at(0)) ||
+                  (m_alignment.Mismatches.contains(index) && (base != N_BASE.at(0)))
                 ) {
-            painter->setPen(m_colorScheme.MismatchText);
-            painter->drawText(xPos, yPos, base);
+            color = &m_colorScheme.MismatchText;
         }
 
         // 'normal' base - but draw only if flag set
-        else {
-            if ( m_basesVisible ) {
-                painter->setPen(m_colorScheme.NormalText);
-                painter->drawText(xPos, yPos, base);
-            }
+        else if ( m_basesVisible ) {
+            color = &m_colorScheme.NormalText;
+        }
+
+        if ( (color != 0) && !atlas->Queue(base, *color, xPos, 0) ) {
+            painter->setPen(*color);
+            painter->drawText(xPos, yPos, QString(base));
         }
 
         // move painter over for next character
         xPos += m_fontWidth;
     }
+    atlas->Flush(painter);
 }
 
 void GVisibleAlignmentItem::mousePressEvent(QGraphicsSceneMouseEvent *event) {
@@ -47,6 +47,9 @@ class GVisibleAlignmentItem : public QObject, public QGraphicsItem {
 
     public: enum AlignmentItemViewMode { Normal = 0, Dimmed, Highlighted };
 
+    // rendering detail, chosen by zoom level (most detailed first)
+    public: enum AlignmentDetailLevel { BaseText = 0, MismatchTicks, ReadRects, CoverageSummary };
+
     // constructors & destructors
     public:
         GVisibleAlignmentItem(const GAlignment& alignment,
@@ -67,6 +70,14 @@ class GVisibleAlignmentItem : public QObject, public QGraphicsItem {
         void SetColorScheme(GColorScheme& colorScheme);
         const GAlignment& alignment(void) { return m_alignment; }
 
+    // tooltip text for any alignment
+    public:
+        static QString ToolTipText(const GAlignment& alignment);
+
+    // detail level for a given on-screen width of one base
+    public:
+        static AlignmentDetailLevel DetailLevel(const qreal& pixelsPerBase);
+
     // handle user interaction
     protected:
         void mousePressEvent(QGraphicsSceneMouseEvent*);
@@ -90,6 +101,9 @@ class GVisibleAlignmentItem : public QObject, public QGraphicsItem {
         static const QString N_BASE;
         static const QString PADDING_BASE;
         static const QString TOOLTIP_TEMPLATE;
+        static const qreal   TEXT_MIN_PIXELS;
+        static const qreal   TICKS_MIN_PIXELS;
+        static const qreal   RECTS_MIN_PIXELS;
 };
 
 inline
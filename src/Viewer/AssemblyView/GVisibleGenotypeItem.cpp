@@ -0,0 +1,149 @@
+// ***************************************************************************
+// GVisibleGenotypeItem.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a 'visible' genotype heatmap (sites x samples) that is displayed in the GAssemblyView.
+// Manages drawing and shows per-call info on hover.
+// ***************************************************************************
+
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GVisibleGenotypeItem.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+const int GVisibleGenotypeItem::SAMPLE_HEIGHT = 4;
+const int GVisibleGenotypeItem::MAX_HEIGHT    = 200;
+
+const QString GVisibleGenotypeItem::TOOLTIP_TEMPLATE = "<h4>%1</h4>"
+                                                       "Position: %2<br>"
+                                                       "Genotype: %3<br>"
+                                                       "ALT alleles in region: %4";
+
+GVisibleGenotypeItem::GVisibleGenotypeItem(const GGenotypeMatrix& genotypes,
+                                           const QList<qreal>&    siteX,
+                                           const int&             fontHeight,
+                                           const int&             fontWidth)
+    : QGraphicsItem()
+    , m_genotypes(genotypes)
+    , m_siteX(siteX)
+    , m_fontHeight(fontHeight)
+    , m_fontWidth(fontWidth)
+{
+    // samples are scaled down to fit in max height, if necessary
+    m_height = qMin( m_genotypes.SampleCount() * SAMPLE_HEIGHT, MAX_HEIGHT );
+
+    // per-sample summary (used in tooltips)
+    m_alleleCounts = m_genotypes.AlleleCounts();
+
+    // build call image
+    CreateImage();
+
+    // show visible genotypes
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setAcceptsHoverEvents(true);
+}
+
+GVisibleGenotypeItem::~GVisibleGenotypeItem(void) { }
+
+QRectF GVisibleGenotypeItem::boundingRect(void) const {
+    if ( m_siteX.isEmpty() ) { return QRectF(); }
+    return QRectF( 0, 0, m_siteX.last() + m_fontWidth, m_height );
+}
+
+void GVisibleGenotypeItem::CreateImage(void) {
+
+    const int numSites   = m_genotypes.SiteCount();
+    const int numSamples = m_genotypes.SampleCount();
+    if ( (numSites == 0) || (numSamples == 0) ) { return; }
+
+    // colors, indexed by genotype call
+    const QRgb colors[4] = { QColor(Qt::darkGray).rgb()     // HomRef
+                           , QColor("orange").rgb()         // Het
+                           , QColor(Qt::red).rgb()          // HomAlt
+                           , QColor(40, 40, 40).rgb()       // Missing
+                           };
+
+    // fill image straight from packed calls (site by site)
+    m_image = QImage(numSites, numSamples, QImage::Format_RGB32);
+    for ( int site = 0; site < numSites; ++site ) {
+        const quint32* words = m_genotypes.SiteCalls(site);
+        for ( int sample = 0; sample < numSamples; ++sample ) {
+            const quint32 word = words[sample / GGenotypeMatrix::CALLS_PER_WORD];
+            const quint32 call = ( word >> ((sample % GGenotypeMatrix::CALLS_PER_WORD) * 2) ) & 0x3;
+            ((QRgb*)m_image.scanLine(sample))[site] = colors[call];
+        }
+    }
+}
+
+void GVisibleGenotypeItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+
+    Q_UNUSED(widget);
+
+    if ( m_image.isNull() ) { return; }
+
+    // only draw columns in exposed area
+    const QRectF exposed = option->exposedRect;
+    int site = SiteAt(exposed.left());
+    if ( site < 0 ) { site = 0; }
+    const int numSites   = m_siteX.size();
+    const int numSamples = m_genotypes.SampleCount();
+    for ( ; site < numSites; ++site ) {
+        const qreal x = m_siteX.at(site);
+        if ( x > exposed.right() ) { break; }
+        painter->drawImage( QRectF(x, 0, m_fontWidth, m_height), m_image, QRectF(site, 0, 1, numSamples) );
+    }
+}
+
+// returns index of last site starting at or before x (-1 if none)
+int GVisibleGenotypeItem::SiteAt(qreal x) const {
+    QList<qreal>::const_iterator iter = qUpperBound(m_siteX.constBegin(), m_siteX.constEnd(), x);
+    return (int)(iter - m_siteX.constBegin()) - 1;
+}
+
+void GVisibleGenotypeItem::hoverMoveEvent(QGraphicsSceneHoverEvent* event) {
+
+    // determine site & sample under cursor
+    const QPointF pos = event->pos();
+    const int site = SiteAt(pos.x());
+    const int numSamples = m_genotypes.SampleCount();
+    int sample = (int)( (pos.y() * numSamples) / m_height );
+    if ( sample >= numSamples ) { sample = numSamples - 1; }
+
+    // clear tooltip if not over a site column
+    if ( (site < 0) || (sample < 0) || (pos.x() >= m_siteX.at(site) + m_fontWidth) ) {
+        setToolTip(QString());
+        return;
+    }
+
+    // set tooltip for call
+    QString genotype;
+    switch ( m_genotypes.At(site, sample) ) {
+        case GGenotypeMatrix::HomRef : genotype = "hom-ref"; break;
+        case GGenotypeMatrix::Het    : genotype = "het";     break;
+        case GGenotypeMatrix::HomAlt : genotype = "hom-alt"; break;
+        default                      : genotype = "missing"; break;
+    }
+    setToolTip( TOOLTIP_TEMPLATE.arg(m_genotypes.SampleNames.at(sample))
+                                .arg(m_genotypes.Positions.at(site))
+                                .arg(genotype)
+                                .arg(m_alleleCounts.at(sample)) );
+}
@@ -0,0 +1,87 @@
+// ***************************************************************************
+// GVisibleGenotypeItem.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a 'visible' genotype heatmap (sites x samples) that is displayed in the GAssemblyView.
+// Manages drawing and shows per-call info on hover.
+// ***************************************************************************
+
+
+#ifndef G_VISIBLEGENOTYPEITEM_H
+#define G_VISIBLEGENOTYPEITEM_H
+
+#include <QObject>
+#include <QGraphicsItem>
+#include <QImage>
+#include <QList>
+#include <QVector>
+#include "DataStructures/GGenotypeMatrix.h"
+class QGraphicsSceneHoverEvent;
+
+namespace Gambit {
+namespace Viewer {
+
+class GVisibleGenotypeItem : public QObject, public QGraphicsItem {
+
+    Q_OBJECT
+
+    // constructors & destructors
+    public:
+        // siteX - x coordinate (relative to item) of each site's column
+        GVisibleGenotypeItem(const GGenotypeMatrix& genotypes,
+                             const QList<qreal>&    siteX,
+                             const int&             fontHeight = 10,
+                             const int&             fontWidth  = 10);
+        ~GVisibleGenotypeItem(void);
+
+    // QGraphicsItem implementation
+    public:
+        QRectF boundingRect(void) const;
+        void   paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*);
+
+    // handle user interaction
+    protected:
+        void hoverMoveEvent(QGraphicsSceneHoverEvent*);
+
+    // internal methods
+    private:
+        void CreateImage(void);
+        int  SiteAt(qreal x) const;
+
+    // data members
+    private:
+        GGenotypeMatrix m_genotypes;
+        QList<qreal>    m_siteX;
+        QVector<qint32> m_alleleCounts;
+        QImage          m_image;     // one pixel per call: width = sites, height = samples
+        int             m_fontHeight;
+        int             m_fontWidth;
+        qreal           m_height;
+
+    private:
+        static const int     SAMPLE_HEIGHT;
+        static const int     MAX_HEIGHT;
+        static const QString TOOLTIP_TEMPLATE;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_VISIBLEGENOTYPEITEM_H
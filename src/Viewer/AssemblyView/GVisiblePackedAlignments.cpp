@@ -0,0 +1,551 @@
+// ***************************************************************************
+// GVisiblePackedAlignments.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a group's alignments as a single 'visible' item. Alignments are
+// packed into rows, and only rows & columns in the exposed area are painted.
+// Detail drops with zoom: base text, mismatch ticks, plain reads, and finally
+// a binned coverage/mismatch summary computed once per layout. Painted areas
+// are cached as tiles, rendered ahead of scrolling on GTileCache workers.
+// Clicks and tooltips are resolved by row lookup on demand.
+// ***************************************************************************
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GGlyphAtlas.h"
+#include "Viewer/AssemblyView/GVisiblePackedAlignments.h"
+#include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+// tile edge, in device pixels
+const int GVisiblePackedAlignments::TILE_PIXELS = 256;
+
+// source of unique data versions, for all packed items
+static QAtomicInt nextVersion(1);
+
+GVisiblePackedAlignments::GVisiblePackedAlignments(const QFont&   font,
+                                                   const int&     fontHeight,
+                                                   const int&     fontWidth,
+                                                   QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , m_rowHeight(fontHeight)
+    , m_width(0)
+    , m_viewMargin(0)
+    , m_version( nextVersion.fetchAndAddOrdered(1) )
+    , m_isChanging(false)
+    , m_hoverIndex(-1)
+    , m_font(font)
+    , m_fontHeight(fontHeight)
+    , m_fontWidth(fontWidth)
+    , m_basesVisible(false)
+    , m_dimmedFlags(GAlignment::None)
+    , m_highlightedFlags(GAlignment::None)
+{
+    // paint only exposed area, resolve tooltips under cursor
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    setAcceptsHoverEvents(true);
+    setZValue(-10);
+}
+
+GVisiblePackedAlignments::~GVisiblePackedAlignments(void) {
+    GTileCache::Instance()->WaitFor(this);
+}
+
+QRectF GVisiblePackedAlignments::boundingRect(void) const {
+    return QRectF( 0, 0, m_width, m_rows.size() * m_rowHeight );
+}
+
+void GVisiblePackedAlignments::AddAlignment(const GAlignment& alignment) {
+    DataChanged();
+    m_alignments.append(alignment);
+}
+
+const GAlignmentList& GVisiblePackedAlignments::Alignments(void) const {
+    return m_alignments;
+}
+
+void GVisiblePackedAlignments::Clear(void) {
+    DataChanged();
+    prepareGeometryChange();
+    m_alignments.clear();
+    m_rows.clear();
+    m_rowOf.clear();
+    m_coverage.clear();
+    m_mismatchCounts.clear();
+    m_width = 0;
+    m_hoverIndex = -1;
+    setToolTip(QString());
+}
+
+void GVisiblePackedAlignments::SetAlignments(const GAlignmentList& alignments) {
+    DataChanged();
+    m_alignments = alignments;
+    m_hoverIndex = -1;
+    setToolTip(QString());
+}
+
+// sort function for row spans
+bool GVisiblePackedAlignments::SpanLeftLessThan(const GAlignmentSpan& lhs, const GAlignmentSpan& rhs) {
+    return ( lhs.Left < rhs.Left );
+}
+
+void GVisiblePackedAlignments::Layout(const qint32& leftBound, const qreal& rowHeight, const qreal& viewMargin, const qreal& spacer) {
+
+    // prepare QGraphicsItem for boundingRect() change
+    DataChanged();
+    prepareGeometryChange();
+    m_rows.clear();
+    m_coverage.clear();
+    m_mismatchCounts.clear();
+    m_rowHeight  = rowHeight;
+    m_viewMargin = viewMargin;
+    m_width      = 0;
+    const qreal spacerWidth = spacer*m_fontWidth;
+
+    // alignments still in their previous rows, and alignments needing a row
+    QVector< QVector<GAlignmentSpan> > keptRows;
+    QVector<GAlignmentSpan> newSpans;
+
+    // iterate over all alignments
+    for ( int index = 0; index < m_alignments.size(); ++index ) {
+        const GAlignment& gAlignment = m_alignments.at(index);
+
+        // calculate alignment's X coordinates
+        GAlignmentSpan span;
+        span.Left  = ( (gAlignment.Position + gAlignment.PadsBefore - leftBound) * m_fontWidth) + viewMargin;
+        span.Right = span.Left + (gAlignment.PaddedBases.length() * m_fontWidth) + 2;
+        span.Index = index;
+        if ( span.Right > m_width ) { m_width = span.Right; }
+
+        // keep previous row if alignment still fits there (padding may have widened it)
+        const int previousRow = m_rowOf.value(AlignmentKey(gAlignment), -1);
+        if ( previousRow >= 0 ) {
+            if ( previousRow >= keptRows.size() ) { keptRows.resize(previousRow + 1); }
+            QVector<GAlignmentSpan>& spans = keptRows[previousRow];
+            if ( spans.isEmpty() || (span.Left >= spans.last().Right + spacerWidth) ) {
+                spans.append(span);
+            } else { newSpans.append(span); }
+        } else { newSpans.append(span); }
+
+        // add alignment to column depth (as +1/-1 deltas, summed below) & mismatch counts
+        const int firstColumn = qMax( 0, (int)(gAlignment.Position + gAlignment.PadsBefore - leftBound) );
+        const int endColumn   = firstColumn + gAlignment.PaddedBases.length();
+        if ( endColumn >= m_coverage.size() ) {
+            m_coverage.resize(endColumn + 1);
+            m_mismatchCounts.resize(endColumn + 1);
+        }
+        ++m_coverage[firstColumn];
+        --m_coverage[endColumn];
+
+        const QString& sequence = gAlignment.PaddedBases;
+        for ( int i = sequence.indexOf(QLatin1Char('-')); i >= 0; i = sequence.indexOf(QLatin1Char('-'), i + 1) ) {
+            ++m_mismatchCounts[firstColumn + i];
+        }
+        foreach ( const qint32& i, gAlignment.Mismatches ) {
+            if ( (i < 0) || (i >= sequence.length()) ) { continue; }
+            const QChar base = sequence.at(i);
+            if ( (base != QLatin1Char('-')) && (base != QLatin1Char('N')) && (base != QLatin1Char('*')) ) {
+                ++m_mismatchCounts[firstColumn + i];
+            }
+        }
+    }
+
+    // convert depth deltas to per-column depth
+    int depth = 0;
+    for ( int column = 0; column < m_coverage.size(); ++column ) {
+        depth += m_coverage.at(column);
+        m_coverage[column] = depth;
+    }
+
+    // store 'next-available' X coordinate of new alignments in each row
+    m_rows = keptRows;
+    QVector<qreal> rowEnds;
+    if ( !newSpans.isEmpty() ) { rowEnds.fill(-spacerWidth, m_rows.size()); }
+
+    // place new alignments in first row with room, around kept alignments
+    foreach ( const GAlignmentSpan& span, newSpans ) {
+
+        // calculate row to place alignment
+        int useRow = 0;
+        for ( ; useRow < rowEnds.size(); ++useRow) {
+            if ( span.Left < rowEnds.at(useRow) ) { continue; }
+            if ( useRow < keptRows.size() ) {
+                const QVector<GAlignmentSpan>& kept = keptRows.at(useRow);
+                const int i = FirstSpanEndingAfter(kept, span.Left - spacerWidth);
+                if ( (i < kept.size()) && (kept.at(i).Left < span.Right + spacerWidth) ) { continue; }
+            }
+            break;
+        }
+
+        // if row is beyond currently 'known' rows, create new row
+        if ( useRow == rowEnds.size() ) {
+            rowEnds.append(span.Left);
+            m_rows.append( QVector<GAlignmentSpan>() );
+        }
+
+        // store alignment in row, save new end position for row used
+        m_rows[useRow].append(span);
+        rowEnds[useRow] = span.Right + spacerWidth;
+    }
+
+    // drop rows emptied since last layout from bottom
+    while ( !m_rows.isEmpty() && m_rows.last().isEmpty() ) { m_rows.pop_back(); }
+
+    // keep spans in position order (for lookups), remember rows for next layout
+    m_rowOf.clear();
+    for ( int row = 0; row < m_rows.size(); ++row ) {
+        QVector<GAlignmentSpan>& spans = m_rows[row];
+        if ( (row < keptRows.size()) && (spans.size() != keptRows.at(row).size()) ) {
+            qStableSort(spans.begin(), spans.end(), SpanLeftLessThan);
+        }
+        foreach ( const GAlignmentSpan& span, spans ) {
+            m_rowOf.insert( AlignmentKey(m_alignments.at(span.Index)), row );
+        }
+    }
+
+    update();
+}
+
+void GVisiblePackedAlignments::SetBasesVisible(bool ok) {
+    DataChanged();
+    m_basesVisible = ok;
+    update();
+}
+
+void GVisiblePackedAlignments::SetColorSchemes(const GColorScheme& normal,
+                                               const GColorScheme& dimmed,
+                                               const GColorScheme& highlighted,
+                                               const GAlignment::GAlignmentOptions& dimmedFlags,
+                                               const GAlignment::GAlignmentOptions& highlightedFlags)
+{
+    DataChanged();
+    m_normalScheme      = normal;
+    m_dimmedScheme      = dimmed;
+    m_highlightedScheme = highlighted;
+    m_dimmedFlags       = dimmedFlags;
+    m_highlightedFlags  = highlightedFlags;
+    update();
+}
+
+// waits for running tile workers, and retires tiles of old data
+// note - done once per batch of changes (e.g. SetAlignments() & Layout()), tiles are only requested again on paint
+void GVisiblePackedAlignments::DataChanged(void) {
+    if ( m_isChanging ) { return; }
+    GTileCache::Instance()->WaitFor(this);
+    m_version    = nextVersion.fetchAndAddOrdered(1);
+    m_isChanging = true;
+}
+
+// returns whether bases are drawn as text at level of detail
+bool GVisiblePackedAlignments::IsTextDetail(const qreal& levelOfDetail) const {
+    return ( GVisibleAlignmentItem::DetailLevel(levelOfDetail * m_fontWidth) == GVisibleAlignmentItem::BaseText );
+}
+
+const GColorScheme& GVisiblePackedAlignments::SchemeFor(const GAlignment& alignment) const {
+    if ( (alignment.Flags & m_dimmedFlags) != 0 )      { return m_dimmedScheme; }
+    if ( (alignment.Flags & m_highlightedFlags) != 0 ) { return m_highlightedScheme; }
+    return m_normalScheme;
+}
+
+// returns index of first span in row that ends beyond x
+// note - spans in a row never overlap, so ends are in same order as starts
+int GVisiblePackedAlignments::FirstSpanEndingAfter(const QVector<GAlignmentSpan>& spans, qreal x) const {
+    int low  = 0;
+    int high = spans.size();
+    while ( low < high ) {
+        const int middle = (low + high) / 2;
+        if ( spans.at(middle).Right <= x ) { low = middle + 1; }
+        else { high = middle; }
+    }
+    return low;
+}
+
+// returns index of alignment at pos (-1 if none)
+int GVisiblePackedAlignments::AlignmentAt(const QPointF& pos) const {
+    if ( (pos.y() < 0) || (m_rowHeight <= 0) ) { return -1; }
+    const int row = (int)( pos.y() / m_rowHeight );
+    if ( (row >= m_rows.size()) || (pos.y() - (row * m_rowHeight) > m_fontHeight) ) { return -1; }
+    const QVector<GAlignmentSpan>& spans = m_rows.at(row);
+    const int i = FirstSpanEndingAfter(spans, pos.x());
+    if ( (i == spans.size()) || (spans.at(i).Left > pos.x()) ) { return -1; }
+    return spans.at(i).Index;
+}
+
+void GVisiblePackedAlignments::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+
+    Q_UNUSED(widget);
+
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if ( levelOfDetail <= 0 ) { return; }
+    PaintTiles(painter, option->exposedRect, levelOfDetail);
+}
+
+QString GVisiblePackedAlignments::TileKey(int scaleKey, int column, int row) const {
+    return QString("%1:%2:%3:%4").arg(m_version).arg(scaleKey).arg(column).arg(row);
+}
+
+// composites cached tiles, paints missing ones directly & queues them (plus neighbors) for workers
+void GVisiblePackedAlignments::PaintTiles(QPainter* painter, const QRectF& exposed, const qreal& levelOfDetail) {
+
+    // tile grid for this zoom level, clipped to item
+    m_isChanging = false;
+    const QRectF area = exposed & boundingRect();
+    if ( area.isEmpty() ) { return; }
+
+    // without threaded font rendering, text can't be drawn by workers - paint it all here
+    if ( IsTextDetail(levelOfDetail) && !GGlyphAtlas::IsThreadedTextSupported() ) {
+        PaintContent(painter, area, levelOfDetail, GGlyphAtlas::Instance(m_font, m_fontHeight, m_fontWidth, levelOfDetail));
+        return;
+    }
+    const qreal tileSize = TILE_PIXELS / levelOfDetail;
+    const int scaleKey    = qRound(levelOfDetail * 10000);
+    const int firstColumn = (int)(area.left()   / tileSize);
+    const int lastColumn  = (int)(area.right()  / tileSize);
+    const int firstRow    = (int)(area.top()    / tileSize);
+    const int lastRow     = (int)(area.bottom() / tileSize);
+
+    GTileCache* cache = GTileCache::Instance();
+    QRectF missed;
+    for ( int row = firstRow; row <= lastRow; ++row ) {
+        for ( int column = firstColumn; column <= lastColumn; ++column ) {
+            const QRectF tileRect(column * tileSize, row * tileSize, tileSize, tileSize);
+            const QString key = TileKey(scaleKey, column, row);
+            QImage tile;
+            if ( cache->Find(key, tile) ) {
+                painter->drawImage(tileRect, tile);
+            } else {
+                missed |= tileRect;
+                cache->Request(key, this, tileRect, levelOfDetail);
+            }
+        }
+    }
+
+    // draw tiles not yet rendered straight to view
+    if ( !missed.isNull() ) {
+        const QRectF missedArea = missed & area;
+        painter->save();
+        painter->setClipRect(missedArea);
+        PaintContent(painter, missedArea, levelOfDetail, GGlyphAtlas::Instance(m_font, m_fontHeight, m_fontWidth, levelOfDetail));
+        painter->restore();
+    }
+
+    // speculatively render adjacent viewports (left & right) and one tile row above & below
+    const QRectF bounds = boundingRect();
+    const int columnSpan = lastColumn - firstColumn + 1;
+    for ( int row = firstRow - 1; row <= lastRow + 1; ++row ) {
+        if ( (row < 0) || (row * tileSize > bounds.bottom()) ) { continue; }
+        for ( int column = firstColumn - columnSpan; column <= lastColumn + columnSpan; ++column ) {
+            if ( (column < 0) || (column * tileSize > bounds.right()) ) { continue; }
+            if ( (row >= firstRow) && (row <= lastRow) && (column >= firstColumn) && (column <= lastColumn) ) { continue; }
+            cache->Request( TileKey(scaleKey, column, row), this, QRectF(column * tileSize, row * tileSize, tileSize, tileSize), levelOfDetail );
+        }
+    }
+}
+
+QImage GVisiblePackedAlignments::RenderTile(const QRectF& rect, const qreal& scale) const {
+
+    // text needs threaded font rendering, otherwise leave tile to GUI thread (not cached)
+    if ( IsTextDetail(scale) && !GGlyphAtlas::IsThreadedTextSupported() ) { return QImage(); }
+
+    QImage tile( qRound(rect.width() * scale), qRound(rect.height() * scale), QImage::Format_ARGB32_Premultiplied );
+    tile.fill(0);
+
+    // worker-local glyph atlas (shared atlas is GUI thread only)
+    GGlyphAtlas atlas(m_font, m_fontHeight, m_fontWidth, GGlyphAtlas::ScaleFor(scale));
+    QPainter painter(&tile);
+    painter.scale(scale, scale);
+    painter.translate( -rect.topLeft() );
+    PaintContent(&painter, rect, scale, &atlas);
+    painter.end();
+    return tile;
+}
+
+void GVisiblePackedAlignments::PaintContent(QPainter* painter, const QRectF& exposed, const qreal& levelOfDetail, GGlyphAtlas* atlas) const {
+
+    // choose detail level from on-screen width of one base
+    const qreal pixelsPerBase = levelOfDetail * m_fontWidth;
+    const GVisibleAlignmentItem::AlignmentDetailLevel detail = GVisibleAlignmentItem::DetailLevel(pixelsPerBase);
+    if ( detail == GVisibleAlignmentItem::CoverageSummary ) {
+        PaintCoverage(painter, exposed, pixelsPerBase);
+        return;
+    }
+
+    // only draw rows in exposed area
+    const int firstRow = qMax( 0, (int)(exposed.top() / m_rowHeight) );
+    const int lastRow  = qMin( m_rows.size() - 1, (int)(exposed.bottom() / m_rowHeight) );
+
+    // base text is blitted from glyph atlas in one batch after all reads are drawn
+    painter->setFont(m_font);
+    for ( int row = firstRow; row <= lastRow; ++row ) {
+
+        // only draw alignments in exposed columns
+        const QVector<GAlignmentSpan>& spans = m_rows.at(row);
+        const qreal y = row * m_rowHeight;
+        for ( int i = FirstSpanEndingAfter(spans, exposed.left()); i < spans.size(); ++i ) {
+            const GAlignmentSpan& span = spans.at(i);
+            if ( span.Left > exposed.right() ) { break; }
+            PaintAlignment(painter, span, y, exposed, detail, atlas);
+        }
+    }
+    atlas->Flush(painter);
+}
+
+// draws binned depth (from top of item, one row-height per read) with mismatch depth on top
+void GVisiblePackedAlignments::PaintCoverage(QPainter* painter, const QRectF& exposed, const qreal& pixelsPerBase) const {
+
+    if ( m_coverage.isEmpty() || (pixelsPerBase <= 0) ) { return; }
+
+    // keep bins at least 2 pixels wide, and fixed to column grid so they don't shift while scrolling
+    const int basesPerBin = (int)(2.0 / pixelsPerBase) + 1;
+    int firstColumn = qMax( 0, (int)((exposed.left() - m_viewMargin) / m_fontWidth) );
+    firstColumn -= firstColumn % basesPerBin;
+    const int lastColumn = qMin( m_coverage.size() - 1, (int)((exposed.right() - m_viewMargin) / m_fontWidth) );
+
+    const QColor coverageColor = m_normalScheme.ForwardBackground;
+    const QColor mismatchColor = m_normalScheme.MismatchText;
+    for ( int bin = firstColumn; bin <= lastColumn; bin += basesPerBin ) {
+
+        // use max depth within bin
+        int depth = 0;
+        int mismatches = 0;
+        const int binEnd = qMin( bin + basesPerBin, m_coverage.size() );
+        for ( int column = bin; column < binEnd; ++column ) {
+            depth      = qMax( depth, m_coverage.at(column) );
+            mismatches = qMax( mismatches, m_mismatchCounts.at(column) );
+        }
+
+        const qreal x = m_viewMargin + (bin * m_fontWidth);
+        const qreal w = basesPerBin * m_fontWidth;
+        if ( depth > 0 )      { painter->fillRect( QRectF(x, 0, w, depth * m_rowHeight), coverageColor ); }
+        if ( mismatches > 0 ) { painter->fillRect( QRectF(x, 0, w, mismatches * m_rowHeight), mismatchColor ); }
+    }
+}
+
+void GVisiblePackedAlignments::PaintAlignment(QPainter* painter, const GAlignmentSpan& span, qreal y, const QRectF& exposed, int detail, GGlyphAtlas* atlas) const {
+
+    const GAlignment& alignment = m_alignments.at(span.Index);
+    const GColorScheme& colorScheme = SchemeFor(alignment);
+
+    // get color scheme, strand-dependent
+    const QColor backgroundColor = ( alignment.IsReverseComplement ? colorScheme.ReverseBackground
+                                                                   : colorScheme.ForwardBackground );
+
+    // below text level, draw flat read with (optional) mismatch ticks
+    const QString& sequence = alignment.PaddedBases;
+    const int length = sequence.length();
+    if ( detail != GVisibleAlignmentItem::BaseText ) {
+        painter->fillRect( QRectF(span.Left - 1, y - 1, (length * m_fontWidth), m_fontHeight), backgroundColor );
+        if ( detail == GVisibleAlignmentItem::MismatchTicks ) {
+            for ( int i = sequence.indexOf(QLatin1Char('-')); i >= 0; i = sequence.indexOf(QLatin1Char('-'), i + 1) ) {
+                painter->fillRect( QRectF(span.Left - 1 + (i * m_fontWidth), y - 1, m_fontWidth, m_fontHeight), colorScheme.MismatchText );
+            }
+            foreach ( const qint32& i, alignment.Mismatches ) {
+                if ( (i < 0) || (i >= length) ) { continue; }
+                const QChar base = sequence.at(i);
+                if ( (base == QLatin1Char('N')) || (base == QLatin1Char('*')) ) { continue; }
+                painter->fillRect( QRectF(span.Left - 1 + (i * m_fontWidth), y - 1, m_fontWidth, m_fontHeight), colorScheme.MismatchText );
+            }
+        }
+        return;
+    }
+
+    // set up background color (gradient)
+    QLinearGradient gradient(0, y, 0, y + m_fontHeight);
+    gradient.setSpread(QGradient::ReflectSpread);
+    gradient.setColorAt(0.0, backgroundColor.lighter() );
+    gradient.setColorAt(0.4, backgroundColor);
+    gradient.setColorAt(0.6, backgroundColor);
+    gradient.setColorAt(1.0, Qt::black);
+    painter->setBrush( QBrush(gradient) );
+
+    // set border pen (same as text color)
+    if ( backgroundColor == Qt::black ) {
+        painter->setPen(QColor("gainsboro"));
+    } else {
+        painter->setPen(Qt::transparent);
+    }
+
+    // perform the actual background drawing
+    painter->drawRect( QRectF(span.Left - 1, y - 1, (length * m_fontWidth), m_fontHeight) );
+
+    // draw alignment text (exposed columns only)
+    const int firstIndex = qMax( 0, (int)((exposed.left() - span.Left) / m_fontWidth) );
+    const int lastIndex  = qMin( length - 1, (int)((exposed.right() - span.Left) / m_fontWidth) );
+    const int yPos = (int)y + m_fontHeight - 4;
+    for ( int index = firstIndex; index <= lastIndex; ++index ) {
+
+        // get current base
+        const QChar base = sequence.at(index);
+        const int   xPos = (int)span.Left + (index * m_fontWidth);
+
+        // choose text color
+        const QColor* color = 0;
+
+        // if base is padding
+        if ( base == QLatin1Char('*') ) {
+            color = &colorScheme.PaddingText;
+        }
+
+        // if base is mismatched from reference - (deletion or mismatch, but not N)
+        else if ( (base == QLatin1Char('-')) ||
+                  (alignment.Mismatches.contains(index) && (base != QLatin1Char('N')))
+                ) {
+            color = &colorScheme.MismatchText;
+        }
+
+        // 'normal' base - but draw only if flag set
+        else if ( m_basesVisible ) {
+            color = &colorScheme.NormalText;
+        }
+
+        // drawText only for bases without a pre-rendered glyph
+        if ( (color != 0) && !atlas->Queue(base, *color, xPos, (int)y) ) {
+            painter->setPen(*color);
+            painter->drawText(xPos, yPos, QString(base));
+        }
+    }
+}
+
+void GVisiblePackedAlignments::hoverMoveEvent(QGraphicsSceneHoverEvent* event) {
+
+    // update tooltip only when cursor moves to another alignment
+    const int index = AlignmentAt( event->pos() );
+    if ( index == m_hoverIndex ) { return; }
+    m_hoverIndex = index;
+    if ( index < 0 ) { setToolTip(QString()); }
+    else { setToolTip( GVisibleAlignmentItem::ToolTipText(m_alignments.at(index)) ); }
+}
+
+void GVisiblePackedAlignments::mousePressEvent(QGraphicsSceneMouseEvent* event) {
+
+    // catch and ignore any mouse event that is not a 'left-click' on an alignment
+    const int index = AlignmentAt( event->pos() );
+    if ( (event->button() != Qt::LeftButton) || (index < 0) ) {
+        event->ignore();
+        return;
+    }
+
+    // emit signal
+    emit clicked( m_alignments.at(index) );
+
+    // send event to QGraphicsItem (base class) to do what it needs
+    QGraphicsItem::mousePressEvent(event);
+}
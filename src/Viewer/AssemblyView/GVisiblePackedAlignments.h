@@ -0,0 +1,154 @@
+// ***************************************************************************
+// GVisiblePackedAlignments.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes a group's alignments as a single 'visible' item. Alignments are
+// packed into rows, and only rows & columns in the exposed area are painted.
+// Clicks and tooltips are resolved by row lookup on demand.
+// ***************************************************************************
+
+#ifndef G_VISIBLEPACKEDALIGNMENTS_H
+#define G_VISIBLEPACKEDALIGNMENTS_H
+
+#include <QObject>
+#include <QGraphicsItem>
+#include <QFont>
+#include <QHash>
+#include <QVector>
+#include "DataStructures/GAlignment.h"
+#include "DataStructures/GColorScheme.h"
+#include "Viewer/AssemblyView/GTileCache.h"
+class QGraphicsSceneHoverEvent;
+class QGraphicsSceneMouseEvent;
+
+namespace Gambit {
+namespace Viewer {
+
+class GGlyphAtlas;
+
+class GVisiblePackedAlignments : public QObject, public QGraphicsItem, public GTileRenderer {
+
+    Q_OBJECT
+
+    // constructors & destructors
+    public:
+        GVisiblePackedAlignments(const QFont& font       = QFont(),
+                                 const int&   fontHeight = 10,
+                                 const int&   fontWidth  = 10,
+                                 QGraphicsItem* parent   = 0);
+        ~GVisiblePackedAlignments(void);
+
+    // QGraphicsItem implementation
+    public:
+        QRectF boundingRect(void) const;
+        void   paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*);
+
+    // GTileRenderer implementation (called from tile workers)
+    public:
+        QImage RenderTile(const QRectF& rect, const qreal& scale) const;
+
+    // data access
+    public:
+        // note - alignments must be added in position order
+        void AddAlignment(const GAlignment& alignment);
+        const GAlignmentList& Alignments(void) const;
+        void Clear(void);
+        // replaces alignments, keeping rows of those already laid out (see Layout)
+        // note - alignments must be in position order
+        void SetAlignments(const GAlignmentList& alignments);
+        // packs alignments into rows
+        // alignments kept from previous layout stay in their rows, new ones fill in around them
+        void Layout(const qint32& leftBound, const qreal& rowHeight, const qreal& viewMargin, const qreal& spacer);
+        void SetBasesVisible(bool ok);
+        // alignment color scheme is chosen by its flags (dimmed > highlighted > normal)
+        void SetColorSchemes(const GColorScheme& normal,
+                             const GColorScheme& dimmed,
+                             const GColorScheme& highlighted,
+                             const GAlignment::GAlignmentOptions& dimmedFlags,
+                             const GAlignment::GAlignmentOptions& highlightedFlags);
+
+    // handle user interaction
+    protected:
+        void hoverMoveEvent(QGraphicsSceneHoverEvent*);
+        void mousePressEvent(QGraphicsSceneMouseEvent*);
+
+    // signal user interaction
+    signals:
+        void clicked(GAlignment);
+
+    // packed alignment data
+    private:
+        // alignment's horizontal extent within its row
+        struct GAlignmentSpan {
+            qreal Left;
+            qreal Right;
+            int   Index;    // into m_alignments
+        };
+
+    // internal methods
+    private:
+        static bool SpanLeftLessThan(const GAlignmentSpan& lhs, const GAlignmentSpan& rhs);
+        int  AlignmentAt(const QPointF& pos) const;
+        int  FirstSpanEndingAfter(const QVector<GAlignmentSpan>& spans, qreal x) const;
+        const GColorScheme& SchemeFor(const GAlignment& alignment) const;
+        void DataChanged(void);
+        bool IsTextDetail(const qreal& levelOfDetail) const;
+        QString TileKey(int scaleKey, int column, int row) const;
+        void PaintTiles(QPainter* painter, const QRectF& exposed, const qreal& levelOfDetail);
+        // note - Paint*() methods must only read item data (also run by tile workers)
+        void PaintContent(QPainter* painter, const QRectF& exposed, const qreal& levelOfDetail, GGlyphAtlas* atlas) const;
+        void PaintAlignment(QPainter* painter, const GAlignmentSpan& span, qreal y, const QRectF& exposed, int detail, GGlyphAtlas* atlas) const;
+        void PaintCoverage(QPainter* painter, const QRectF& exposed, const qreal& pixelsPerBase) const;
+
+    // data members
+    private:
+        GAlignmentList                     m_alignments;
+        QVector< QVector<GAlignmentSpan> > m_rows;
+        QHash<QString, int>                m_rowOf;     // row used by each alignment (by AlignmentKey) in last layout
+        qreal m_rowHeight;
+        qreal m_width;
+        qreal m_viewMargin;
+        int   m_version;    // identifies current data in tile keys
+        bool  m_isChanging; // data changed since last paint (tile workers already stopped)
+        // per-column depth & mismatch counts, built by Layout() for zoomed-out summary
+        QVector<int> m_coverage;
+        QVector<int> m_mismatchCounts;
+        int   m_hoverIndex;
+
+        QFont m_font;
+        int   m_fontHeight;
+        int   m_fontWidth;
+        bool  m_basesVisible;
+
+        GColorScheme m_normalScheme;
+        GColorScheme m_dimmedScheme;
+        GColorScheme m_highlightedScheme;
+        GAlignment::GAlignmentOptions m_dimmedFlags;
+        GAlignment::GAlignmentOptions m_highlightedFlags;
+
+    // static constants
+    private:
+        static const int TILE_PIXELS;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_VISIBLEPACKEDALIGNMENTS_H
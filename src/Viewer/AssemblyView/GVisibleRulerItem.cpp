@@ -0,0 +1,154 @@
+// ***************************************************************************
+// GVisibleRulerItem.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes the coordinate ruler track in the GAssemblyView. Labels & tick marks
+// are computed for the exposed rect only, with intervals adapted to zoom.
+// ***************************************************************************
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GVisibleRulerItem.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+// track layout (matches former text/line items)
+const qreal GVisibleRulerItem::HEIGHT = 40;
+static const qreal LABEL_YPOS        = 10;
+static const qreal TICKMARK_YPOS     = 30;
+static const qreal TICKMARK_HEIGHT   = 10;
+static const qreal MIN_LABEL_PIXELS  = 80;  // on-screen spacing between labels
+static const qreal MIN_TICK_PIXELS   = 5;   // on-screen spacing between minor tick marks
+
+GVisibleRulerItem::GVisibleRulerItem(const qint32&      leftBound,
+                                     const qint32&      rightBound,
+                                     const GPaddingMap& padding,
+                                     const QFont&       font,
+                                     const int&         fontWidth,
+                                     const qreal&       viewMargin)
+    : QGraphicsItem()
+    , m_leftBound(leftBound)
+    , m_rightBound(rightBound)
+    , m_font(font)
+    , m_fontWidth(fontWidth)
+    , m_viewMargin(viewMargin)
+{
+    // store running pad totals, for position <-> column lookups
+    qint32 total = 0;
+    GPaddingMap::const_iterator padIter = padding.constBegin();
+    for ( ; padIter != padding.constEnd(); ++padIter ) {
+        if ( (padIter.key() < m_leftBound) || (padIter.key() > m_rightBound) ) { continue; }
+        total += padIter.value();
+        m_padPositions.append(padIter.key());
+        m_padTotals.append(total);
+    }
+
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+GVisibleRulerItem::~GVisibleRulerItem(void) { }
+
+QRectF GVisibleRulerItem::boundingRect(void) const {
+    const qreal width = ( (ColumnOf(m_rightBound) + 1) * m_fontWidth ) + m_viewMargin;
+    return QRectF(0, 0, width, HEIGHT);
+}
+
+// returns window column of position (pads at a position come before its base)
+qint32 GVisibleRulerItem::ColumnOf(const qint32& position) const {
+    QVector<qint32>::const_iterator found = qUpperBound(m_padPositions.constBegin(), m_padPositions.constEnd(), position);
+    const int padIndex = (found - m_padPositions.constBegin()) - 1;
+    const qint32 pads = ( (padIndex < 0) ? 0 : m_padTotals.at(padIndex) );
+    return (position - m_leftBound) + pads;
+}
+
+// returns first position whose column is >= column
+qint32 GVisibleRulerItem::PositionAtColumn(const qint32& column) const {
+    qint32 low  = m_leftBound;
+    qint32 high = m_rightBound + 1;
+    while ( low < high ) {
+        const qint32 middle = low + (high - low) / 2;
+        if ( ColumnOf(middle) < column ) { low = middle + 1; }
+        else { high = middle; }
+    }
+    return low;
+}
+
+// major interval is lowest of 10, 50, 100, 500, ... that keeps labels readable
+// minor interval is the interval preceding it (same scheme as slider view), if ticks fit
+void GVisibleRulerItem::CalculateIntervals(const qreal& pixelsPerBase, qint32& majorInterval, qint32& minorInterval) const {
+    majorInterval = 10;
+    minorInterval = 0;
+    qint32 previous = 5;
+    bool isPowerOfTen = true;
+    while ( (majorInterval * pixelsPerBase < MIN_LABEL_PIXELS) && (majorInterval < (m_rightBound - m_leftBound)) ) {
+        previous = majorInterval;
+        majorInterval *= ( isPowerOfTen ? 5 : 2 );
+        isPowerOfTen = !isPowerOfTen;
+    }
+    if ( (previous * pixelsPerBase >= MIN_TICK_PIXELS) && (previous < majorInterval) ) {
+        minorInterval = previous;
+    }
+}
+
+void GVisibleRulerItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+
+    Q_UNUSED(widget);
+
+    // determine intervals for current zoom
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if ( levelOfDetail <= 0 ) { return; }
+    qint32 majorInterval;
+    qint32 minorInterval;
+    CalculateIntervals(levelOfDetail * m_fontWidth, majorInterval, minorInterval);
+    const qint32 step = ( (minorInterval > 0) ? minorInterval : majorInterval );
+
+    // determine exposed genomic range (labels may begin left of exposed rect)
+    const QRectF exposed = option->exposedRect;
+    const qreal  labelWidth = MIN_LABEL_PIXELS / levelOfDetail;
+    qint32 firstPosition = PositionAtColumn( (qint32)((exposed.left() - labelWidth - m_viewMargin) / m_fontWidth) );
+    const qint32 lastPosition = PositionAtColumn( (qint32)((exposed.right() - m_viewMargin) / m_fontWidth) + 1 );
+    firstPosition += (step - (firstPosition % step)) % step;
+
+    // draw labels and store tick marks (will draw all in one go later)
+    const QFontMetrics metrics(m_font);
+    const qreal labelBaseline = LABEL_YPOS + 4 + metrics.ascent();
+    painter->setFont(m_font);
+    painter->setPen(QPen(QColor(Qt::white)));
+    QVector<QLineF> tickMarks;
+    for ( qint32 position = firstPosition; position <= qMin(lastPosition, m_rightBound); position += step ) {
+
+        const qreal x = ColumnOf(position) * m_fontWidth;
+        const qreal tickX = x + (m_fontWidth / 2) + m_viewMargin;
+
+        // major interval - label & full tick mark
+        if ( (position % majorInterval) == 0 ) {
+            painter->drawText( QPointF(x + (m_viewMargin / 2) + 4, labelBaseline), QString::number(position) );
+            tickMarks << QLineF(tickX, TICKMARK_YPOS, tickX, TICKMARK_YPOS + TICKMARK_HEIGHT);
+        }
+
+        // minor interval - half tick mark
+        else {
+            tickMarks << QLineF(tickX, TICKMARK_YPOS + (TICKMARK_HEIGHT / 2), tickX, TICKMARK_YPOS + TICKMARK_HEIGHT);
+        }
+    }
+
+    // draw tick marks
+    painter->drawLines(tickMarks);
+}
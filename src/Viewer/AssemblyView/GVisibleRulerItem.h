@@ -0,0 +1,83 @@
+// ***************************************************************************
+// GVisibleRulerItem.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes the coordinate ruler track in the GAssemblyView. Labels & tick marks
+// are computed for the exposed rect only, with intervals adapted to zoom.
+// ***************************************************************************
+
+#ifndef G_VISIBLERULERITEM_H
+#define G_VISIBLERULERITEM_H
+
+#include <QGraphicsItem>
+#include <QFont>
+#include <QVector>
+#include "DataStructures/GGenomicDataSet.h"
+
+namespace Gambit {
+namespace Viewer {
+
+class GVisibleRulerItem : public QGraphicsItem {
+
+    // constructors & destructors
+    public:
+        GVisibleRulerItem(const qint32&      leftBound,
+                          const qint32&      rightBound,
+                          const GPaddingMap& padding,
+                          const QFont&       font      = QFont(),
+                          const int&         fontWidth = 10,
+                          const qreal&       viewMargin = 5);
+        ~GVisibleRulerItem(void);
+
+    // QGraphicsItem implementation
+    public:
+        QRectF boundingRect(void) const;
+        void   paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*);
+
+    // coordinate mapping
+    public:
+        qint32 ColumnOf(const qint32& position) const;
+        qint32 PositionAtColumn(const qint32& column) const;
+
+    // internal methods
+    private:
+        void   CalculateIntervals(const qreal& pixelsPerBase, qint32& majorInterval, qint32& minorInterval) const;
+
+    // data members
+    private:
+        qint32 m_leftBound;
+        qint32 m_rightBound;
+        QFont  m_font;
+        int    m_fontWidth;
+        qreal  m_viewMargin;
+
+        // padded positions (sorted) & total pads up to & including each
+        QVector<qint32> m_padPositions;
+        QVector<qint32> m_padTotals;
+
+    // static constants
+    public:
+        static const qreal HEIGHT;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_VISIBLERULERITEM_H
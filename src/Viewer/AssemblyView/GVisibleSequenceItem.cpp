@@ -0,0 +1,84 @@
+// ***************************************************************************
+// GVisibleSequenceItem.cpp (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes the reference sequence track in the GAssemblyView. Bases are
+// blitted from the glyph atlas, exposed columns only.
+// ***************************************************************************
+
+#include <QtGui>
+#include <QtDebug>
+#include "Viewer/AssemblyView/GGlyphAtlas.h"
+#include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
+#include "Viewer/AssemblyView/GVisibleSequenceItem.h"
+using namespace Gambit;
+using namespace Gambit::Viewer;
+
+GVisibleSequenceItem::GVisibleSequenceItem(const QString& sequence,
+                                           const QFont&   font,
+                                           const int&     fontHeight,
+                                           const int&     fontWidth,
+                                           const QColor&  color)
+    : QGraphicsItem()
+    , m_sequence(sequence)
+    , m_font(font)
+    , m_fontHeight(fontHeight)
+    , m_fontWidth(fontWidth)
+    , m_color(color)
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+GVisibleSequenceItem::~GVisibleSequenceItem(void) { }
+
+QRectF GVisibleSequenceItem::boundingRect(void) const {
+    return QRectF( 0, 0, m_sequence.length() * m_fontWidth, m_fontHeight );
+}
+
+void GVisibleSequenceItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+
+    Q_UNUSED(widget);
+
+    // only draw exposed columns
+    const QRectF exposed = option->exposedRect;
+    const int firstIndex = qMax( 0, (int)(exposed.left() / m_fontWidth) );
+    const int lastIndex  = qMin( m_sequence.length() - 1, (int)(exposed.right() / m_fontWidth) );
+    if ( firstIndex > lastIndex ) { return; }
+
+    // bases are unreadable when zoomed out, draw plain bar instead
+    const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if ( GVisibleAlignmentItem::DetailLevel(levelOfDetail * m_fontWidth) != GVisibleAlignmentItem::BaseText ) {
+        painter->fillRect( QRectF(firstIndex * m_fontWidth, 0, (lastIndex - firstIndex + 1) * m_fontWidth, m_fontHeight), QColor("dimgray") );
+        return;
+    }
+
+    // blit bases from glyph atlas (drawText only for bases without a pre-rendered glyph)
+    GGlyphAtlas* atlas = GGlyphAtlas::Instance(m_font, m_fontHeight, m_fontWidth, levelOfDetail);
+    painter->setFont(m_font);
+    painter->setPen(m_color);
+    for ( int index = firstIndex; index <= lastIndex; ++index ) {
+        const QChar base = m_sequence.at(index);
+        const int   xPos = index * m_fontWidth;
+        if ( !atlas->Queue(base, m_color, xPos, 0) ) {
+            painter->drawText(xPos, m_fontHeight - 4, QString(base));
+        }
+    }
+    atlas->Flush(painter);
+}
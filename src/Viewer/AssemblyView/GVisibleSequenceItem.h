@@ -0,0 +1,65 @@
+// ***************************************************************************
+// GVisibleSequenceItem.h (c) 2026 Gambit developers
+// All rights reserved.
+// ---------------------------------------------------------------------------
+// Last modified: 18 Oct 2026
+// ---------------------------------------------------------------------------
+// This file is part of Gambit.
+//
+// Gambit is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Gambit is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Gambit.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------------
+// Describes the reference sequence track in the GAssemblyView. Bases are
+// blitted from the glyph atlas, exposed columns only.
+// ***************************************************************************
+
+#ifndef G_VISIBLESEQUENCEITEM_H
+#define G_VISIBLESEQUENCEITEM_H
+
+#include <QGraphicsItem>
+#include <QColor>
+#include <QFont>
+#include <QString>
+
+namespace Gambit {
+namespace Viewer {
+
+class GVisibleSequenceItem : public QGraphicsItem {
+
+    // constructors & destructors
+    public:
+        GVisibleSequenceItem(const QString& sequence,
+                             const QFont&   font       = QFont(),
+                             const int&     fontHeight = 10,
+                             const int&     fontWidth  = 10,
+                             const QColor&  color      = QColor(Qt::white));
+        ~GVisibleSequenceItem(void);
+
+    // QGraphicsItem implementation
+    public:
+        QRectF boundingRect(void) const;
+        void   paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*);
+
+    // data members
+    private:
+        QString m_sequence;
+        QFont   m_font;
+        int     m_fontHeight;
+        int     m_fontWidth;
+        QColor  m_color;
+};
+
+} // namespace Viewer
+} // namespace Gambit
+
+#endif // G_VISIBLESEQUENCEITEM_H
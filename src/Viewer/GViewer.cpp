@@ -30,6 +30,7 @@
 #include <QtDebug>
 #include "Viewer/GViewer.h"
 #include "DataStructures/GGenomicDataSet.h"
+#include "DataStructures/GReferenceDictionary.h"
 #include "Utilities/GStyleHelper.h"
 #include "Viewer/AssemblyView/GAssemblyToolbar.h"
 #include "Viewer/AssemblyView/GAssemblyView.h"
@@ -67,8 +68,10 @@ struct GViewer::GViewerPrivate {
     GReferenceView*    referenceView;
     GSliderView*       sliderView;
     GReferenceList     references;
+    GReferenceDictionary referenceDictionary;   // IDs are indexes into references
 
     void Init(GViewer* parent);
+    bool ResolveRegion(GGenomicDataRegion& region);
 };
 
 void GViewer::GViewerPrivate::Init(GViewer* parent) {
@@ -87,6 +90,15 @@ void GViewer::GViewerPrivate::Init(GViewer* parent) {
     sliderView->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Minimum);
 }
 
+// sets region's reference ID (and canonical name, region may use an alias), returns false if reference unknown
+bool GViewer::GViewerPrivate::ResolveRegion(GGenomicDataRegion& region) {
+    const qint32 id = referenceDictionary.Id(region.RefName);
+    if ( (id < 0) || (id >= references.size()) ) { return false; }
+    region.RefId   = id;
+    region.RefName = references.at(id).Name;
+    return true;
+}
+
 GViewer::GViewer(QWidget* parent)
     : QFrame(parent)
 {
@@ -100,10 +112,26 @@ GViewer::GViewer(QWidget* parent)
     connect(d->assemblyToolbar, SIGNAL(JumpRequested(GGenomicDataRegion)),
             this, SLOT(CatchToolbarJumpRequest(GGenomicDataRegion)));
 
+    // forward name searches from toolbar
+    connect(d->assemblyToolbar, SIGNAL(NameSearchRequested(QString)),
+            this,               SIGNAL(NameSearchRequested(QString)));
+
     // handle center-on request from toolbar
     connect(d->assemblyToolbar, SIGNAL(ViewCenterOnRequested(qint32)),
             d->assemblyView,    SLOT(SetCenterOn(qint32)));
 
+    // forward requests for data adjacent to current view data
+    connect(d->assemblyView, SIGNAL(DataExtensionRequested(GGenomicDataRegion,GGenomicDataRegion)),
+            this,            SIGNAL(ViewerDataExtensionRequested(GGenomicDataRegion,GGenomicDataRegion)));
+    connect(d->assemblyView, SIGNAL(StatusMessage(QString)),
+            this,            SIGNAL(StatusMessage(QString)));
+
+    // forward genotype visibility (before reloading data with it)
+    connect(d->assemblyView, SIGNAL(GenotypesVisibilityChanged(bool)),
+            this,            SIGNAL(GenotypesVisibilityChanged(bool)));
+    connect(d->assemblyView, SIGNAL(DataReloadRequested(GGenomicDataRegion)),
+            this,            SIGNAL(ViewerDataRequested(GGenomicDataRegion)));
+
     // handle reference clicks
     connect(d->referenceView, SIGNAL(ReferenceClicked(GReference)),
             this, SLOT(ReferenceDefaultDataRequested(GReference)));
@@ -154,6 +182,8 @@ GViewer::~GViewer(void) {
 void GViewer::ShowReferences(GReferenceList references) {
     d->references.clear();
     d->references = references;
+    d->referenceDictionary.Clear();
+    foreach ( const GReference& reference, references ) { d->referenceDictionary.Add(reference.Name); }
     d->assemblyToolbar->SetReferenceNames( ReferenceNames(references) );
     d->referenceView->SetReferences(references);
 }
@@ -183,6 +213,15 @@ void GViewer::ShowAssembly(GGenomicDataSet data) {
     d->sliderView->SetSelectedRegion(data.Region);
 }
 
+void GViewer::ExtendAssembly(GGenomicDataSet data) {
+    d->assemblyView->UpdateData(data);
+    d->sliderView->SetSelectedRegion(data.Region);
+}
+
+void GViewer::ShowNameMatches(QString prefix, GFeatureNameList names) {
+    d->assemblyToolbar->SetNameMatches(prefix, names);
+}
+
 void GViewer::Print(void) {
 
     QPrinter printer(QPrinter::ScreenResolution);
@@ -198,11 +237,16 @@ void GViewer::ReferenceDefaultDataRequested(const GReference& reference) {
     d->assemblyToolbar->SetRange(GAssemblyToolbar::DEFAULT_RANGE);
 
     GGenomicDataRegion region(reference.Name, GAssemblyToolbar::DEFAULT_POSITION, GAssemblyToolbar::DEFAULT_RANGE);
+    d->ResolveRegion(region);
     emit ViewerDataRequested(region);
     d->sliderView->SetSelectedRegion(region);
 }
 
-void GViewer::CatchSliderClick(const GGenomicDataRegion& region) {
+void GViewer::CatchSliderClick(const GGenomicDataRegion& sliderRegion) {
+
+    // set region's reference ID
+    GGenomicDataRegion region = sliderRegion;
+    d->ResolveRegion(region);
 
     // update toolbar to reflect slider click
     qint32 range = (region.RightBound - region.LeftBound);
@@ -214,20 +258,16 @@ void GViewer::CatchSliderClick(const GGenomicDataRegion& region) {
     emit ViewerDataRequested(region);
 }
 
-void GViewer::CatchToolbarJumpRequest(const GGenomicDataRegion& region) {
+void GViewer::CatchToolbarJumpRequest(const GGenomicDataRegion& toolbarRegion) {
 
-    // look up reference item
-    bool found = false;
-    GReference ref;
-    foreach (ref, d->references) {
-        if ( QString::compare(ref.Name, region.RefName) == 0 ) {
-            found = true;
-            break;
-        }
-    }
+    // look up reference item (region may use an alias of reference name)
+    GGenomicDataRegion region = toolbarRegion;
+    const bool found = d->ResolveRegion(region);
 
     // if found, set slider and emit request signal
     if ( found ) {
+        const GReference& ref = d->references.at(region.RefId);
+        d->assemblyToolbar->SetSelectedReference(region.RefName);
         d->sliderView->SetReference(ref);
         d->sliderView->SetSelectedRegion(region);
         emit ViewerDataRequested(region);
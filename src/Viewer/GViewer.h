@@ -31,6 +31,7 @@
 
 #include <QFrame>
 #include "DataStructures/GAlignment.h"
+#include "DataStructures/GFeatureName.h"
 #include "DataStructures/GGenomicDataSet.h"
 #include "DataStructures/GReference.h"
 #include "Viewer/AssemblyView/GVisibleAlignmentItem.h"
@@ -51,8 +52,10 @@ class GViewer : public QFrame {
     // GViewer interface
     public slots:
         void Clear(void);
+        void ExtendAssembly(GGenomicDataSet data);
         void SetCenterOn(qint32 position);
         void ShowAssembly(GGenomicDataSet data);
+        void ShowNameMatches(QString prefix, GFeatureNameList names);
         void ShowReferences(GReferenceList references);
         void Update(void);
         void Print(void);
@@ -69,6 +72,10 @@ class GViewer : public QFrame {
     // signals
     signals:
         void ViewerDataRequested(const GGenomicDataRegion& region);
+        void ViewerDataExtensionRequested(const GGenomicDataRegion& delta, const GGenomicDataRegion& keep);
+        void NameSearchRequested(const QString& prefix);
+        void StatusMessage(const QString& message);
+        void GenotypesVisibilityChanged(bool visible);
 
     // data members
     private: